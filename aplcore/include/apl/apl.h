@@ -28,6 +28,7 @@
 #include "apl/buildTimeConstants.h"
 #include "apl/common.h"
 #include "apl/component/component.h"
+#include "apl/component/textmeasurecache.h"
 #include "apl/component/textmeasurement.h"
 #include "apl/content/content.h"
 #include "apl/content/importref.h"
@@ -35,9 +36,11 @@
 #include "apl/content/jsondata.h"
 #include "apl/content/metrics.h"
 #include "apl/content/package.h"
+#include "apl/content/packagecache.h"
 #include "apl/content/rootconfig.h"
 #include "apl/datasource/datasourceconnection.h"
 #include "apl/datasource/datasourceprovider.h"
+#include "apl/engine/deltastream.h"
 #include "apl/engine/event.h"
 #include "apl/engine/rootcontext.h"
 #include "apl/graphic/graphic.h"
@@ -67,6 +67,7 @@ class RootConfig;
 class RootContext;
 class Session;
 class Settings;
+class StyleBlocks;
 class StyleDefinition;
 class StyleInstance;
 class TextMeasurement;
@@ -93,6 +94,7 @@ using RootConfigPtr = std::shared_ptr<RootConfig>;
 using RootContextPtr = std::shared_ptr<RootContext>;
 using SessionPtr = std::shared_ptr<Session>;
 using SettingsPtr = std::shared_ptr<Settings>;
+using StyleBlocksPtr = std::shared_ptr<const StyleBlocks>;
 using StyleDefinitionPtr = std::shared_ptr<StyleDefinition>;
 using StyleInstancePtr = std::shared_ptr<StyleInstance>;
 using TextMeasurementPtr = std::shared_ptr<TextMeasurement>;
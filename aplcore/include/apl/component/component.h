@@ -36,6 +36,10 @@ class MediaState;
 class GraphicContent;
 
 using CalculatedPropertyMap = PropertyMap<PropertyKey, sComponentPropertyBimap>;
+using PropertySet = PropertyKeySet<PropertyKey>;
+
+// kPropertyWrap is the last PropertyKey.  Every key must fit in a PropertySet.
+static_assert(kPropertyWrap < PropertySet::CAPACITY, "PropertyKey does not fit in a PropertySet");
 
 /**
  * Updates from the view host to the component.  Call the Component::update() method and
@@ -146,7 +150,8 @@ public:
     std::string name() const;
 
     /**
-     * @return The number of children.
+     * @return The number of children.  A lazily inflated sequence only counts the children
+     *         inflated so far; see RootConfig::lazySequenceInflation().
      */
     virtual size_t getChildCount() const = 0;
 
@@ -193,7 +198,14 @@ public:
      * @return The set of properties that have changed in this component
      *         since the last time the component was marked as clean.
      */
-    const std::set<PropertyKey>& getDirty() { return mDirty; }
+    const std::set<PropertyKey>& getDirty();
+
+    /**
+     * @return The set of properties that have changed in this component since the last time
+     *         the component was marked as clean.  Unlike getDirty(), this does not copy the
+     *         properties into a std::set.
+     */
+    const PropertySet& getDirtyProperties() const { return mDirty; }
 
     /**
      * Clear the set of properties that have been changed.
@@ -350,6 +362,15 @@ public:
      */
     virtual rapidjson::Value serializeAll(rapidjson::Document::AllocatorType& allocator) const = 0;
 
+    /**
+     * Serialize a component and its children as JSON text.  The text is the same as
+     * serialize() written without whitespace.  Each component caches the text of its own
+     * properties, so repeated snapshots only re-render the components that changed since the
+     * last one and then copy the cached text of the others into the result.
+     * @return The JSON text.
+     */
+    virtual std::string serializeSnapshot() const = 0;
+
     /**
      * Serialize all dirty component parameters into a rapidjson array. This clears the dirty
      * flags.
@@ -424,7 +445,8 @@ protected:
     std::string                mUniqueId;
     std::string                mId;
     CalculatedPropertyMap      mCalculated;  // Current calculated object properties
-    std::set<PropertyKey>      mDirty;
+    PropertySet                mDirty;
+    std::set<PropertyKey>      mDirtyKeys;   // Copy of mDirty returned by getDirty()
     bool                       mIsValid;
 
 
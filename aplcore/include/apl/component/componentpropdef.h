@@ -154,9 +154,12 @@ public:
     ComponentPropDefSet& add(const std::vector<ComponentPropDef>& list) {
         addInternal(list);
 
+        bool styledChanged = false;
         for (const ComponentPropDef& m : list) {
-            if ((m.flags & kPropStyled) != 0)
+            if ((m.flags & kPropStyled) != 0) {
                 addToMap(mStyled, m);
+                styledChanged = true;
+            }
 
             if ((m.flags & kPropDynamic) != 0)
                 addToMap(mDynamic, m);
@@ -165,6 +168,13 @@ public:
                 addToMap(mNeedsNode, m);
         }
 
+        if (styledChanged) {
+            mStyledNames.clear();
+            for (const auto& m : mStyled)
+                for (const auto& name : m.second.names)
+                    mStyledNames.emplace(name, m.first);
+        }
+
         return *this;
     }
 
@@ -173,6 +183,16 @@ public:
      */
     const PMap& styled() const { return mStyled; }
 
+    /**
+     * Find the styled property that reads a style property name.
+     * @param name The style property name.
+     * @return An iterator to the styled property definition or styled().end()
+     */
+    PMap::const_iterator findStyled(const Atom& name) const {
+        auto it = mStyledNames.find(name);
+        return it != mStyledNames.end() ? mStyled.find(it->second) : mStyled.end();
+    }
+
     /**
      * @return The dynamic properties
      */
@@ -185,6 +205,7 @@ public:
 
 private:
     PMap mStyled;
+    std::map<Atom, PropertyKey> mStyledNames;   // Style property name to styled property
     PMap mDynamic;
     PMap mNeedsNode;
 };
@@ -22,20 +22,24 @@
 #include <yoga/YGNode.h>
 
 #include "apl/component/component.h"
+#include "apl/component/textmeasurecache.h"
 #include "apl/component/textmeasurement.h"
 #include "apl/engine/properties.h"
 #include "apl/engine/context.h"
 #include "apl/engine/recalculatetarget.h"
 #include "apl/primitives/keyboard.h"
 #include "apl/utils/range.h"
+#include "apl/utils/spatialindex.h"
 
 namespace apl {
 
+class ChildInflater;
 class ComponentPropDef;
 class ComponentPropDefSet;
 class LayoutRebuilder;
 class Pointer;
 struct PointerEvent;
+class SearchVisitor;
 
 extern const std::string VISUAL_CONTEXT_TYPE_MIXED;
 extern const std::string VISUAL_CONTEXT_TYPE_GRAPHIC;
@@ -104,6 +108,14 @@ public:
      */
     virtual void raccept(Visitor<CoreComponent>& visitor) const;
 
+    /**
+     * Walk the component hierarchy in reverse order looking for the component at a position.  This visits the
+     * same components as raccept(), but components with many children only visit the children whose bounds
+     * contain the search point.
+     * @param visitor
+     */
+    void rsearch(SearchVisitor& visitor) const;
+
     /**
      * Find a component at or below this point in the hierarchy with the given id or uniqueId.
      * @param id The id or uniqueId to search for.
@@ -140,12 +152,18 @@ public:
 
     // Documentation from component.h
     bool insertChild(const ComponentPtr& child, size_t index) override {
-        return canInsertChild() && insertChild(child, index, true);
+        if (!canInsertChild())
+            return false;
+        inflateAllChildren(true);
+        return insertChild(child, index, true);
     }
 
     // Documentation from component.h
     bool appendChild(const ComponentPtr& child) override {
-        return canInsertChild() && appendChild(child, true);
+        if (!canInsertChild())
+            return false;
+        inflateAllChildren(true);
+        return appendChild(child, true);
     }
 
     // Documentation from component.h
@@ -332,6 +350,15 @@ public:
      */
     rapidjson::Value serializeAll(rapidjson::Document::AllocatorType& allocator) const override;
 
+    // Documentation from component.h
+    std::string serializeSnapshot() const override;
+
+    /**
+     * Discard the cached snapshot text of this component.  Stored calculated values are detected
+     * automatically; call this when serialized state changes without a new calculated value.
+     */
+    void invalidateSnapshot() { mSnapshotValid = false; }
+
     /**
      * Convert the dirty properties of this component into a JSON object.
      * @param allocator
@@ -544,6 +571,45 @@ public:
      */
     virtual bool shouldAttachChildYogaNode(int index) const { return true; }
 
+    /**
+     * @param index index of child.
+     * @return True if the child at this index is visited by raccept()
+     */
+    virtual bool isSearchableChild(size_t index) const { return true; }
+
+    /**
+     * @return True if this component may defer inflating the tail of its children.
+     */
+    virtual bool supportsLazyInflation() const { return false; }
+
+    /**
+     * Inflate deferred children until the child at this index exists.  Children are only deferred
+     * when lazy sequence inflation is enabled in the RootConfig.
+     * @param index The index of the child.
+     * @param useDirtyFlag True if the new children should be reported as inserted.
+     * @return True if the child at this index exists.
+     */
+    bool ensureChildInflated(size_t index, bool useDirtyFlag);
+
+    /**
+     * Inflate every deferred child.
+     * @param useDirtyFlag True if the new children should be reported as inserted.
+     */
+    void inflateAllChildren(bool useDirtyFlag);
+
+    /**
+     * @return The number of children that have not been inflated yet.
+     */
+    size_t getDeferredChildCount() const;
+
+    /**
+     * Trim a scroll position as trimScroll() does, inflating deferred children until the position
+     * is reached or every child has been inflated.
+     * @param point The requested scroll position.
+     * @return The trimmed scroll position.
+     */
+    Point inflateAndTrimScroll(const Point& point);
+
     /**
      * Checks to see if this Component inherits state from another Component. State
      * is inherited if compare Component is an ancestor, and inheritParentState = true for this Component
@@ -673,7 +739,7 @@ public:
         T *component = static_cast<T*>(node->getContext());
         assert(component);
 
-        LayoutSize layoutSize = component->getContext()->measure()->measure(component, width, toMeasureMode(widthMode), height, toMeasureMode(heightMode));
+        LayoutSize layoutSize = component->getContext()->textMeasureCache().measure(*component, width, toMeasureMode(widthMode), height, toMeasureMode(heightMode));
         return YGSize({layoutSize.width, layoutSize.height});
     }
 
@@ -691,9 +757,14 @@ public:
         T *component = static_cast<T*>(node->getContext());
         assert(component);
 
-        return component->getContext()->measure()->baseline(component, width, height);
+        return component->getContext()->textMeasureCache().baseline(*component, width, height);
     }
 
+    /**
+     * @return The properties of this component that affect text measurement.
+     */
+    const TextMeasureInputPtr& getMeasureInput() const;
+
 protected:
     // internal, do not call directly
     virtual bool insertChild(const ComponentPtr& child, size_t index, bool useDirtyFlag);
@@ -702,6 +773,21 @@ protected:
 
     void ensureChildAttached(const CoreComponentPtr& child, int targetIdx);
 
+    /**
+     * Run the Yoga layout calculation on this node.  If the text measurement of the document
+     * measures in batches, the text components are measured in batches between layout passes.
+     * @param width Target width.
+     * @param height Target height.
+     */
+    void calculateLayout(float width, float height);
+
+    /**
+     * Walk the hierarchy updating child boundaries after a layout pass that only attached children
+     * to this component.  Children whose bounds did not change are not visited.
+     * @param useDirtyFlag
+     */
+    void processAttachedLayoutChanges(bool useDirtyFlag);
+
     virtual const EventPropertyMap& eventPropertyMap() const;
 
 private:
@@ -710,8 +796,10 @@ private:
     friend class Builder;
     friend class LayoutRebuilder;
     friend class ChildWalker;
+    friend class ChildInflater;
 
     void ensureChildAttached(const CoreComponentPtr& child);
+    void relayout(bool useDirtyFlag);
 
     bool attachChild(const CoreComponentPtr& child, size_t index);
 
@@ -743,16 +831,26 @@ private:
     const ComponentPropDefSet* getLayoutPropDefSet() const;
 
     void updateStyleInternal(const StyleInstancePtr& stylePtr, const ComponentPropDefSet& propDefSet);
+    void updateStyleInternal(const StyleInstancePtr& stylePtr, const ComponentPropDefSet& propDefSet,
+                             const std::vector<Atom>& changes);
+    void updateStyledProperty(const StyleInstancePtr& stylePtr, const ComponentPropDef& pd);
 
     virtual const ComponentPropDefSet* layoutPropDefSet() const { return nullptr; };
 
     void updateNodeProperties();
 
+    void updateLayout(bool useDirtyFlag, bool changedChildrenOnly);
+
+    rapidjson::Value serializeProperties(rapidjson::Document::AllocatorType& allocator) const;
+    void appendSnapshot(std::string& out) const;
+
     void serializeVisualContextInternal(rapidjson::Value& outArray, rapidjson::Document::AllocatorType& allocator,
                                         float realOpacity, float visibility, const Rect& visibleRect, int visualLayer);
 
     void attachRebuilder(const std::shared_ptr<LayoutRebuilder>& rebuilder) { mRebuilder = rebuilder; }
 
+    void attachInflater(const std::shared_ptr<ChildInflater>& inflater) { mInflater = inflater; }
+
     std::shared_ptr<ObjectMap> createEventProperties(const std::string& handler, const Object& value) const;
 
     void notifyChildChanged(size_t index, const std::string& uid, const std::string& action);
@@ -761,21 +859,31 @@ private:
 
     void attachYogaNodeIfRequired(const CoreComponentPtr& coreChild, int index);
 
-    void scheduleTickHandler(const Object& handler, double delay);
+    const SpatialIndex& hitIndex() const;
+    void invalidateHitIndex() { mHitIndexValid = false; }
+
     void processTickHandlers();
 
 protected:
     bool                             mInheritParentState;
     State                            mState;       // Operating state (pressed, checked, etc)
     std::string                      mStyle;       // Name of the current STYLE
+    StyleInstancePtr                 mAppliedStyle; // Style the styled properties were last calculated from
     Properties                       mProperties;  // Assigned properties from JSON
-    std::set<PropertyKey>            mAssigned;    // Properties that have been assigned from JSON or SetValue
+    PropertySet                      mAssigned;    // Properties that have been assigned from JSON or SetValue
     std::vector<CoreComponentPtr>    mChildren;
     CoreComponentPtr                 mParent;
     YGNodeRef                        mYGNodeRef;
     std::string                      mPath;
     std::shared_ptr<LayoutRebuilder> mRebuilder;
+    std::shared_ptr<ChildInflater>   mInflater;    // Inflates the deferred tail of the children
+    mutable TextMeasureInputPtr      mMeasureInput; // Text measurement cache key, reset when a layout property changes
     Range                            mEnsuredChildren;
+    mutable std::string              mSnapshot;    // Cached snapshot text of the properties, without the closing brace
+    mutable uint32_t                 mSnapshotVersion = 0;  // mCalculated version the snapshot text was built from
+    mutable bool                     mSnapshotValid = false;
+    mutable std::unique_ptr<SpatialIndex> mHitIndex;   // Child bounds in content coordinates, built on demand
+    mutable bool                     mHitIndexValid = false;
 };
 
 }  // namespace apl
@@ -39,10 +39,7 @@ public:
 protected:
     const ComponentPropDefSet& propDefSet() const override;
     const ComponentPropDefSet* layoutPropDefSet() const override;
-    void layoutChildIfRequired(const Rect& parentBounds,
-                               CoreComponentPtr& child,
-                               size_t childIdx,
-                               bool useDirtyFlag) override;
+    void prepareChild(const CoreComponentPtr& child, size_t childIdx) override;
     const EventPropertyMap & eventPropertyMap() const override;
 
     bool childrenUseSpacingProperty() const override { return false; }
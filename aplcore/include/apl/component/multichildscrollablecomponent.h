@@ -29,6 +29,7 @@ public:
             ScrollableComponent(context, std::move(properties), path) {};
     Object getValue() const override;
     bool multiChild() const override { return true; }
+    bool supportsLazyInflation() const override { return true; }
     void processLayoutChanges(bool useDirtyFlag) override;
     void accept(Visitor<CoreComponent>& visitor) const override;
     void raccept(Visitor<CoreComponent>& visitor) const override;
@@ -63,9 +64,50 @@ protected:
     bool insertChild(const ComponentPtr& child, size_t index, bool useDirtyFlag) override;
     void removeChild(const CoreComponentPtr& child, size_t index, bool useDirtyFlag) override;
     bool getTags(rapidjson::Value& outMap, rapidjson::Document::AllocatorType& allocator) override;
-    virtual void layoutChildIfRequired(const Rect& parentBounds, CoreComponentPtr& child, size_t childIdx, bool useDirtyFlag);
+
+    /**
+     * Prepare a child before it is laid out.  Called for every child visited by the layout walk.
+     * @param child The child.
+     * @param childIdx The index of the child.
+     */
+    virtual void prepareChild(const CoreComponentPtr& child, size_t childIdx) {}
+
+    /**
+     * Attach a child that has not been laid out yet.  The caller runs layoutChildren() once the
+     * children it needs have been attached.
+     * @param child The child.
+     * @param childIdx The index of the child.
+     * @return True if the child needs layout.
+     */
+    bool attachChildIfRequired(const CoreComponentPtr& child, size_t childIdx);
+
+    /**
+     * Lay out the attached children in a single pass.
+     * @param parentBounds The bounds of this component.
+     * @param useDirtyFlag True if changed properties should be marked dirty.
+     */
+    void layoutChildren(const Rect& parentBounds, bool useDirtyFlag);
+
+    /**
+     * Estimate how many more children are needed to cover a distance along the scroll axis, based
+     * on the size of a child that has been laid out.
+     * @param referenceIdx The index of the laid-out child.
+     * @param distance The distance to cover.
+     * @return The estimated number of children, at least one.
+     */
+    int estimateChildrenToCover(size_t referenceIdx, float distance) const;
+
+    /**
+     * Attach and lay out a batch of children in a single pass.
+     * @param index The index of the first child.
+     * @param count The number of children.
+     * @param useDirtyFlag True if changed properties should be marked dirty.
+     */
+    void ensureChildrenLayout(size_t index, int count, bool useDirtyFlag) const;
+
     float maxScroll() const override;
     bool shouldAttachChildYogaNode(int index) const override;
+    bool isSearchableChild(size_t index) const override;
 
     bool isHorizontal() const { return getCalculated(kPropertyScrollDirection) == kScrollDirectionHorizontal; }
     bool isVertical() const { return getCalculated(kPropertyScrollDirection) == kScrollDirectionVertical; }
@@ -74,6 +116,7 @@ protected:
 
 private:
     void updateChildrenVisibility();
+    void layoutChildrenInView(bool useDirtyFlag, bool processOwnLayout);
 
     Range mIndexesSeen;
     int mFirstChildInView = -1;
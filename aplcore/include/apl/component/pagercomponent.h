@@ -51,6 +51,7 @@ protected:
     bool insertChild(const ComponentPtr& child, size_t index, bool useDirtyFlag) override;
     void removeChild(const CoreComponentPtr& child, size_t index, bool useDirtyFlag) override;
     bool shouldAttachChildYogaNode(int index) const override;
+    bool isSearchableChild(size_t index) const override;
     void finalizePopulate() override;
 
 private:
@@ -0,0 +1,181 @@
+/**
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+#ifndef _APL_TEXT_MEASURE_CACHE_H
+#define _APL_TEXT_MEASURE_CACHE_H
+
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "apl/component/textmeasurement.h"
+#include "apl/primitives/object.h"
+
+namespace apl {
+
+/**
+ * The calculated properties of a component that affect how its text is measured.  These are the
+ * properties that trigger a layout pass when they change.
+ */
+class TextMeasureInput {
+public:
+    TextMeasureInput(ComponentType type, std::vector<Object>&& values);
+
+    bool operator==(const TextMeasureInput& rhs) const;
+
+    size_t hash() const { return mHash; }
+
+private:
+    ComponentType mType;
+    std::vector<Object> mValues;
+    size_t mHash;
+};
+
+using TextMeasureInputPtr = std::shared_ptr<const TextMeasureInput>;
+
+/**
+ * A per-document, least-recently-used cache in front of the installed TextMeasurement.
+ *
+ * Results of TextMeasurement::measure() and TextMeasurement::baseline() are keyed by the
+ * text-affecting properties of the component and the measurement constraints, so Yoga passes
+ * and components that repeat the same measurement only call the TextMeasurement once.  The
+ * cache assumes that the measurement does not depend on any other property of the component.
+ *
+ * The cache is disabled unless RootConfig::textMeasurementCacheSize() is set.
+ *
+ * When the TextMeasurement is a BatchTextMeasurement, a layout pass started with beginBatch()
+ * queues the measurements it does not know yet instead of calling the TextMeasurement.  The
+ * queue is measured in one call by measureBatch() and the results are kept until endBatch(),
+ * whatever the capacity of the cache.
+ */
+class TextMeasureCache {
+public:
+    /**
+     * @param measurement The text measurement of the document.
+     * @param capacity The maximum number of stored results.  Zero disables caching.
+     */
+    TextMeasureCache(const TextMeasurementPtr& measurement, size_t capacity);
+
+    /**
+     * Measure the text of a component.
+     * @param component The Text or EditText component.
+     * @param width The available width.
+     * @param widthMode The width measurement mode.
+     * @param height The available height.
+     * @param heightMode The height measurement mode.
+     * @return The measured size.
+     */
+    LayoutSize measure(CoreComponent& component, float width, MeasureMode widthMode,
+                       float height, MeasureMode heightMode);
+
+    /**
+     * Calculate the baseline of the text of a component.
+     * @param component The Text or EditText component.
+     * @param width The laid-out width.
+     * @param height The laid-out height.
+     * @return The baseline.
+     */
+    float baseline(CoreComponent& component, float width, float height);
+
+    /**
+     * Remove all stored results.  The hit and miss counters are not reset.
+     */
+    void clear();
+
+    /**
+     * @return True if the TextMeasurement of the document measures text in batches.
+     */
+    bool batching() const { return mBatch != nullptr; }
+
+    /**
+     * Start queueing unknown measurements.  Until measureBatch() is called, they return an empty
+     * size or baseline.
+     */
+    void beginBatch();
+
+    /**
+     * Measure the queued components in a single batch.  Components that were given an empty
+     * result are marked dirty so that the next layout pass picks up the results.
+     * @return True if any component was measured.
+     */
+    bool measureBatch();
+
+    /**
+     * Stop queueing.  Unknown measurements are passed directly to the TextMeasurement.
+     */
+    void stopQueueing() { mQueueing = false; }
+
+    /**
+     * Stop batching and discard the batch results that are not held by the cache.
+     */
+    void endBatch();
+
+    size_t capacity() const { return mCapacity; }
+    size_t size() const { return mEntries.size(); }
+    unsigned long hits() const { return mHits; }
+    unsigned long misses() const { return mMisses; }
+    unsigned long batches() const { return mBatches; }
+
+private:
+    struct Key {
+        TextMeasureInputPtr input;
+        float width;
+        float height;
+        MeasureMode widthMode;
+        MeasureMode heightMode;
+        bool baseline;
+
+        bool operator==(const Key& rhs) const;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    using Entry = std::pair<Key, LayoutSize>;
+
+    struct Pending {
+        CoreComponentPtr component;
+        Key key;
+    };
+
+    const LayoutSize* find(const Key& key);
+    void store(Key&& key, const LayoutSize& size);
+    void queue(CoreComponent& component, Key&& key);
+
+private:
+    TextMeasurementPtr mMeasurement;
+    std::shared_ptr<BatchTextMeasurement> mBatch;
+    size_t mCapacity;
+    std::list<Entry> mEntries;  // Most recently used at the front
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> mIndex;
+    unsigned long mHits = 0;
+    unsigned long mMisses = 0;
+
+    bool mBatchActive = false;
+    bool mQueueing = false;
+    size_t mQueuedMeasures = 0;
+    std::vector<Pending> mQueue;
+    std::vector<CoreComponentPtr> mWaiting;   // Components given an empty result while queueing
+    std::unordered_set<Key, KeyHash> mQueued;
+    std::unordered_map<Key, LayoutSize, KeyHash> mResults;  // Batch results, kept until endBatch()
+    unsigned long mBatches = 0;
+};
+
+} // namespace apl
+
+#endif // _APL_TEXT_MEASURE_CACHE_H
@@ -17,6 +17,8 @@
 #define _APL_TEXT_MEASUREMENT_H
 
 #include <memory>
+#include <vector>
+
 #include "apl/component/component.h"
 
 namespace apl {
@@ -61,5 +63,48 @@ public:
                             float height ) = 0;
 };
 
+/**
+ * A single measurement requested from a BatchTextMeasurement.
+ */
+struct TextMeasureRequest {
+    Component *component;
+    float width;
+    MeasureMode widthMode;
+    float height;
+    MeasureMode heightMode;
+};
+
+/**
+ * The size of the measured text and its baseline when laid out at that size.
+ */
+struct TextMeasureResult {
+    LayoutSize size;
+    float baseline;
+};
+
+/**
+ * Optional extension of TextMeasurement for runtimes that can measure many text components at once.
+ *
+ * When the installed TextMeasurement derives from this class, each layout pass first collects the
+ * Text and EditText components that need to be measured and passes them to measureBatch() as a
+ * single batch.  The results are then served to the layout engine.  When a result changes the
+ * constraints of another text component, that component is requested in a further batch, so a
+ * layout usually needs one or two batches.  The single-component measure() and baseline() methods
+ * are still used if the measurements do not settle after a few batches.
+ *
+ * measureBatch() is called on the thread that owns the document, but it may distribute the work
+ * across other threads provided it only reads the components and returns once every result is set.
+ */
+class BatchTextMeasurement : public TextMeasurement {
+public:
+    /**
+     * Measure a batch of text components.
+     * @param requests The components and constraints to measure.
+     * @param results Set to one result for each request, in the same order.
+     */
+    virtual void measureBatch( const std::vector<TextMeasureRequest>& requests,
+                               std::vector<TextMeasureResult>& results ) = 0;
+};
+
 } // namespace apl
 #endif //_APL_TEXT_MEASUREMENT_H
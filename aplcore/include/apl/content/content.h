@@ -197,8 +197,9 @@ public:
             std::vector<std::string>&& parameterNames);
 
 private:  // Private internal methods
+    void loadPackage(const ImportRef& reference, const PackagePtr& package);
     void addImportList(Package& package);
-    void addImport(Package& package, const rapidjson::Value& value);
+    void addImport(Package& package, const rapidjson::Value& value, bool recordDependency);
     void addExtensions(Package& package);
     void updateStatus();
     void loadExtensionSettings();
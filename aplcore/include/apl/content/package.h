@@ -16,7 +16,9 @@
 #ifndef _APL_PACKAGE_H
 #define _APL_PACKAGE_H
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include "rapidjson/document.h"
@@ -63,6 +65,14 @@ public:
      */
     const std::string type();
 
+    /**
+     * Return the compiled blocks of each style defined in this package, keyed by the style name.
+     * The styles are compiled the first time this method is called.  This method is thread-safe,
+     * so a package shared between documents compiles its styles once.
+     * @return The compiled style blocks.
+     */
+    const std::map<std::string, StyleBlocksPtr>& styleBlocks() const;
+
     Package(const std::string& name, JsonData&& json)
             : mName(name),
               mJson(std::move(json))
@@ -85,6 +95,8 @@ private:
     std::string mName;
     const JsonData mJson;
     std::vector<ImportRef> mDependencies;
+    mutable std::once_flag mStyleBlocksFlag;
+    mutable std::map<std::string, StyleBlocksPtr> mStyleBlocks;
 };
 
 } // namespace apl
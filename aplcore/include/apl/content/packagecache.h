@@ -0,0 +1,95 @@
+/**
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_PACKAGE_CACHE_H
+#define _APL_PACKAGE_CACHE_H
+
+#include <list>
+#include <map>
+#include <mutex>
+
+#include "apl/common.h"
+#include "apl/content/importref.h"
+
+namespace apl {
+
+/**
+ * A process-wide, least-recently-used cache of loaded packages keyed by package name and version.
+ *
+ * A cached package holds the parsed JSON, the resolved import list, and the compiled style
+ * blocks of the package.  When a document imports a package that is in the cache, the Content
+ * loads it immediately instead of returning it from Content::getRequestedPackages(), so the
+ * package is neither downloaded, parsed, nor preprocessed again.  Packages are immutable once
+ * they have been loaded and may be shared between documents and threads.
+ *
+ * The cache is disabled by default.  Only enable it if a package name and version always
+ * identify the same package content:
+ *
+ *     PackageCache::instance().setCapacity(32);
+ */
+class PackageCache {
+public:
+    /**
+     * @return The shared package cache
+     */
+    static PackageCache& instance();
+
+    /**
+     * Look up a package.
+     * @param reference The name and version of the package.
+     * @return The package or nullptr if it is not cached.
+     */
+    PackagePtr get(const ImportRef& reference);
+
+    /**
+     * Store a package.  The package must have been fully loaded by a Content.
+     * @param reference The name and version of the package.
+     * @param package The package.
+     */
+    void put(const ImportRef& reference, const PackagePtr& package);
+
+    /**
+     * Set the maximum number of stored packages.  A capacity of zero disables caching.
+     * @param capacity The maximum number of packages.
+     */
+    void setCapacity(size_t capacity);
+
+    /**
+     * Remove all stored packages and reset the hit and miss counters.
+     */
+    void clear();
+
+    size_t capacity() const;
+    size_t size() const;
+    unsigned long hits() const;
+    unsigned long misses() const;
+
+private:
+    void trim();
+
+private:
+    using Entry = std::pair<ImportRef, PackagePtr>;
+
+    mutable std::mutex mMutex;
+    std::list<Entry> mEntries;  // Most recently used at the front
+    std::map<ImportRef, std::list<Entry>::iterator> mIndex;
+    size_t mCapacity = 0;
+    unsigned long mHits = 0;
+    unsigned long mMisses = 0;
+};
+
+} // namespace apl
+
+#endif // _APL_PACKAGE_CACHE_H
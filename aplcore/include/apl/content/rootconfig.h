@@ -207,6 +207,47 @@ public:
         return *this;
     }
 
+    /**
+     * Enable or disable arena allocation.  When enabled, the contexts, components and dependants
+     * of a document are allocated from a pool owned by the document and the pool is released in
+     * one step when the last of them is destroyed.  All components of the document must then be
+     * created and released on the same thread.
+     * @param arenaAllocation True if arena allocation should be used.
+     * @return This object for chaining.
+     */
+    RootConfig& arenaAllocation(bool arenaAllocation) {
+        mArenaAllocation = arenaAllocation;
+        return *this;
+    }
+
+    /**
+     * Enable or disable lazy inflation of Sequence and GridSequence children built from static
+     * "data" or "items".  When enabled, children are inflated as layout and scrolling reach them
+     * and are reported as inserted children, the same way that children are added to a sequence
+     * bound to a LiveArray.  getChildCount() and getChildAt() only cover the children inflated so
+     * far.  findComponentById() inflates deferred children until it finds a match, and children
+     * inflated after the document has mounted run their "onMount" commands when they are inserted.
+     * @param lazySequenceInflation True if sequence children should be inflated on demand.
+     * @return This object for chaining.
+     */
+    RootConfig& lazySequenceInflation(bool lazySequenceInflation) {
+        mLazySequenceInflation = lazySequenceInflation;
+        return *this;
+    }
+
+    /**
+     * Set the number of text measurement results cached by each document.  Cached results are
+     * keyed by the properties that trigger a layout pass when they change, so only enable the
+     * cache if the installed TextMeasurement does not depend on any other property of the
+     * component.  A size of zero disables the cache.
+     * @param size The maximum number of cached measurements and baselines.
+     * @return This object for chaining.
+     */
+    RootConfig& textMeasurementCacheSize(size_t size) {
+        mTextMeasurementCacheSize = size;
+        return *this;
+    }
+
     /**
      * Set the default size of a built-in component.  This applies to both horizontal and vertical components
      * @param type The component type.
@@ -546,6 +587,21 @@ public:
      */
     bool getTrackProvenance() const { return mTrackProvenance; }
 
+    /**
+     * @return True if the objects of a document are allocated from a per-document arena.
+     */
+    bool getArenaAllocation() const { return mArenaAllocation; }
+
+    /**
+     * @return True if the children of a Sequence or GridSequence are inflated on demand.
+     */
+    bool getLazySequenceInflation() const { return mLazySequenceInflation; }
+
+    /**
+     * @return The maximum number of text measurement results cached by each document.
+     */
+    size_t getTextMeasurementCacheSize() const { return mTextMeasurementCacheSize; }
+
     /**
      * Return the default width for this component type.
      * @param type The component type.
@@ -751,6 +807,9 @@ private:
     std::map<std::string, Color> mDefaultThemeFontColor;
     std::map<std::string, Color> mDefaultThemeHighlightColor;
     bool mTrackProvenance;
+    bool mArenaAllocation;
+    bool mLazySequenceInflation;
+    size_t mTextMeasurementCacheSize;
     std::map<std::pair<ComponentType, bool>, std::pair<Dimension, Dimension>> mDefaultComponentSize;
     int mPagerChildCache;
     int mSequenceChildCache;
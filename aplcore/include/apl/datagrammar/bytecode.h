@@ -0,0 +1,105 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_BYTE_CODE_H
+#define _APL_BYTE_CODE_H
+
+#include <memory>
+#include <vector>
+
+#include "apl/datagrammar/functions.h"
+#include "apl/primitives/object.h"
+
+namespace apl {
+namespace datagrammar {
+
+class ByteCode;
+using ByteCodePtr = std::shared_ptr<const ByteCode>;
+
+enum ByteCodeOpcode {
+    /** Push data[value] onto the stack */
+    kByteCodeLoadConstant,
+    /** Push data[value].eval() onto the stack.  Used for bound symbols and unrecognized nodes */
+    kByteCodeEvaluate,
+    /** Replace the top of the stack with unary(top) */
+    kByteCodeUnary,
+    /** Pop two values and push binary(a,b) */
+    kByteCodeBinary,
+    /** Pop "value" items and push their string combination */
+    kByteCodeCombine,
+    /** Pop "value" arguments and the function beneath them; push the result of the call */
+    kByteCodeCall,
+    /** Replace the top of the stack with null and jump to instruction "value" if it is not callable */
+    kByteCodeJumpIfNotCallable,
+    /** Jump to instruction "value" */
+    kByteCodeJump,
+    /** Pop the top of the stack and jump to instruction "value" if it is false */
+    kByteCodePopJumpIfFalse
+};
+
+struct ByteCodeInstruction {
+    ByteCodeOpcode opcode;
+    int value;
+    UnaryCalculation unary;
+    BinaryCalculation binary;
+};
+
+/**
+ * A flat, stack-based representation of an evaluable data-binding expression.  The Node and
+ * BoundSymbol tree produced by the parser is lowered into a sequence of instructions that
+ * run on a reusable value stack; sub-expressions with constant inputs are folded when the
+ * byte code is compiled.
+ *
+ * The byte code evaluates to exactly the same value as calling eval() on the original
+ * expression.  Operators that are not recognized by the compiler are kept as a single
+ * instruction that falls back to the Node tree walker.
+ */
+class ByteCode {
+public:
+    /**
+     * Compile an evaluable expression.
+     * @param equation The Node or BoundSymbol expression.
+     * @return The compiled byte code or nullptr if the expression is not evaluable.
+     */
+    static ByteCodePtr compile(const Object& equation);
+
+    /**
+     * @return The result of executing the byte code.
+     */
+    Object eval() const;
+
+    const std::vector<ByteCodeInstruction>& instructions() const { return mInstructions; }
+    const std::vector<Object>& data() const { return mData; }
+
+    std::string toDebugString() const;
+
+private:
+    void compileObject(const Object& object);
+    void compileNode(const Object& object);
+    void emit(ByteCodeOpcode opcode, int value = 0,
+              UnaryCalculation unary = nullptr, BinaryCalculation binary = nullptr);
+    void emitData(ByteCodeOpcode opcode, const Object& object);
+    bool isConstant(size_t start, size_t count) const;
+    Object popConstant();
+
+private:
+    std::vector<ByteCodeInstruction> mInstructions;
+    std::vector<Object> mData;
+};
+
+} // namespace datagrammar
+} // namespace apl
+
+#endif // _APL_BYTE_CODE_H
@@ -53,7 +53,7 @@ template<> struct action< intnum >
     template< typename Input >
     static void apply(const Input& in, Stacks& stacks) {
         int value = std::stoi(in.string());
-        stacks.push(Object((double) value));
+        stacks.push(ExpressionTemplate::constant(Object((double) value)));
     }
 };
 
@@ -62,7 +62,7 @@ template<> struct action< floatnum >
     template< typename Input >
     static void apply(const Input& in, Stacks& stacks) {
         double value = std::stod(in.string());
-        stacks.push(Object(value));
+        stacks.push(ExpressionTemplate::constant(Object(value)));
     }
 };
 
@@ -70,7 +70,7 @@ template<> struct action< null_ >
 {
     template< typename Input >
     static void apply( const Input& in, Stacks& stacks) {
-        stacks.push(Object::NULL_OBJECT());
+        stacks.push(ExpressionTemplate::constant(Object::NULL_OBJECT()));
     }
 };
 
@@ -78,7 +78,7 @@ template<> struct action< true_ >
 {
     template< typename Input >
     static void apply( const Input& in, Stacks& stacks) {
-        stacks.push(Object::TRUE_OBJECT());
+        stacks.push(ExpressionTemplate::constant(Object::TRUE_OBJECT()));
     }
 };
 
@@ -86,7 +86,7 @@ template<> struct action< false_ >
 {
     template< typename Input >
     static void apply( const Input& in, Stacks& stacks) {
-        stacks.push(Object::FALSE_OBJECT());
+        stacks.push(ExpressionTemplate::constant(Object::FALSE_OBJECT()));
     }
 };
 
@@ -94,7 +94,7 @@ template<> struct action< identifier >
 {
     template< typename Input >
     static void apply( const Input& in, Stacks& stacks) {
-        stacks.push(Object(in.string()));
+        stacks.push(ExpressionTemplate::constant(Object(in.string())));
     }
 };
 
@@ -285,8 +285,7 @@ template<> struct action< resource >
 {
     template< typename Input >
     static void apply( const Input& in, Stacks& stacks ) {
-        auto name = Object(in.string());
-        stacks.push(Symbol(stacks.context(), std::vector<Object>{name}, "Resource"));
+        stacks.push(ExpressionTemplate::resource(in.string()));
     }
 };
 
@@ -295,8 +294,7 @@ template<> struct action< symbol >
 {
     template< typename Input >
     static void apply( const Input& in, Stacks& stacks ) {
-        auto name = Object(in.string());
-        stacks.push(Symbol(stacks.context(), std::vector<Object>{name}, "Symbol"));
+        stacks.push(ExpressionTemplate::symbol(in.string()));
     }
 };
 
@@ -398,7 +396,7 @@ template<> struct action< ss_raw >
     static void apply( const Input& in, Stacks& stacks) {
         auto s = in.string();
         if (s.length() > 0)
-            stacks.push(Object(s));
+            stacks.push(ExpressionTemplate::constant(Object(s)));
     }
 };
 
@@ -416,7 +414,7 @@ template<> struct action< dimension >
     static void apply( const Input& in, Stacks& stacks) {
         auto s = in.string();
         if (s.length() > 0) {
-            stacks.push(Object(Dimension(stacks.context(), s)));
+            stacks.push(ExpressionTemplate::dimension(s));
         }
     }
 };
@@ -427,7 +425,7 @@ template<> struct action< ds_raw >
     static void apply( const Input& in, Stacks& stacks) {
         auto s = in.string();
         if (s.length() > 0)
-            stacks.push(Object(s));
+            stacks.push(ExpressionTemplate::constant(Object(s)));
     }
 };
 
@@ -445,7 +443,7 @@ template<> struct action< raw >
     static void apply( const Input& in, Stacks& stacks) {
         auto s = in.string();
         if (s.length() > 0)
-            stacks.push(Object(s));
+            stacks.push(ExpressionTemplate::constant(Object(s)));
     }
 };
 
@@ -21,9 +21,9 @@
 #include <cstdio>
 #include <tao/pegtl.hpp>
 #include "databindinggrammar.h"
+#include "expressiontemplate.h"
 #include "functions.h"
 #include "node.h"
-#include "apl/engine/context.h"
 #include "apl/primitives/object.h"
 #include "apl/utils/log.h"
 #include "apl/utils/streamer.h"
@@ -49,8 +49,6 @@ enum {
     OP_DB = 21
 };
 
-using CreateFunction = Object (*)(std::vector<Object>&&);
-
 struct Operator
 {
     int order;
@@ -116,7 +114,7 @@ class Stack {
 public:
     Stack(int depth) : mDepth(depth) {}
 
-    void push(const Object& object)
+    void push(const ExpressionTemplatePtr& object)
     {
         LOG_IF(DEBUG_STATE) << "Stack[" << mDepth << "].push_object " << object;
         mObjects.push_back(object);
@@ -148,7 +146,9 @@ public:
 
         while (opIter != mOps.end()) {
             LOG_IF(DEBUG_STATE) << "Reducing " << opIter->name;
-            auto node = opIter->func(std::vector<Object>(objectIter, objectIter+2));
+            auto node = ExpressionTemplate::op(opIter->func,
+                                               std::vector<ExpressionTemplatePtr>(objectIter, objectIter+2),
+                                               opIter->name);
             *objectIter = node;
             mObjects.erase( objectIter + 1, objectIter + 2);
             opIter = mOps.erase(opIter);
@@ -161,7 +161,9 @@ public:
         if (back == mOps.rend() || back->order != order)
             return false;
 
-        auto node = back->func(std::vector<Object>(mObjects.end() - 1, mObjects.end()));
+        auto node = ExpressionTemplate::op(back->func,
+                                           std::vector<ExpressionTemplatePtr>(mObjects.end() - 1, mObjects.end()),
+                                           back->name);
         mObjects.pop_back();
         mObjects.emplace_back(std::move(node));
         mOps.pop_back();
@@ -175,7 +177,9 @@ public:
             return;
 
         assert(mObjects.size() >= 2);
-        auto node = back->func(std::vector<Object>(mObjects.end() - 2, mObjects.end()));
+        auto node = ExpressionTemplate::op(back->func,
+                                           std::vector<ExpressionTemplatePtr>(mObjects.end() - 2, mObjects.end()),
+                                           back->name);
         mObjects.pop_back();
         mObjects.pop_back();
         mOps.pop_back();
@@ -190,40 +194,32 @@ public:
 
         back++;
         assert(back != mOps.rend() && back->order == order);
-        auto node = back->func(std::vector<Object>(mObjects.end() - 3, mObjects.end()));
+        auto node = ExpressionTemplate::op(back->func,
+                                           std::vector<ExpressionTemplatePtr>(mObjects.end() - 3, mObjects.end()),
+                                           back->name);
         mObjects.erase(mObjects.end() - 3, mObjects.end());
         mOps.erase(mOps.end() - 2, mOps.end());
         mObjects.emplace_back(std::move(node));
     }
 
-    Object combine(CombineType combineType)
+    ExpressionTemplatePtr combine(CombineType combineType)
     {
         LOG_IF(DEBUG_STATE) << "[" << mDepth << "] Stack.combine";
 
         switch (combineType) {
             case kCombineEmbeddedString:
-                // If there's nothing, we started with an empty string
-                if (mObjects.empty())
-                    return Object("");
-
-                if (mObjects.size() == 1)
-                    return mObjects.back();
-
-                return Combine(std::vector<Object>(mObjects.begin(), mObjects.end()));
-
             case kCombineTopString:
                 // If there's nothing, we started with an empty string
                 if (mObjects.empty())
-                    return Object("");
+                    return ExpressionTemplate::constant(Object(""));
 
                 if (mObjects.size() == 1)
                     return mObjects.back();
 
-                return Combine(std::vector<Object>(mObjects.begin(), mObjects.end()));
+                return ExpressionTemplate::op(Combine, std::move(mObjects), "combine");
 
             case kCombineVector:
-                // TODO: Do we have move assignment?
-                return Object(std::make_shared<std::vector<Object> >(mObjects));
+                return ExpressionTemplate::vector(std::move(mObjects));
 
             case kCombineSingle:
                 assert(mObjects.size() == 1);
@@ -271,7 +267,7 @@ public:
 
 private:
     int mDepth;
-    std::vector<Object> mObjects;
+    std::vector<ExpressionTemplatePtr> mObjects;
     std::vector<Operator> mOps;
 };
 
@@ -279,7 +275,7 @@ class Stacks
 {
 public:
     // Start with an initial stack that is handling the outer string context
-    Stacks(const Context& context) : mContext(context) {
+    Stacks() {
         open();
     }
 
@@ -300,7 +296,7 @@ public:
     }
 
     // TODO: Change this to emplace_back
-    void push(const Object& object) { mStack.back().push(object); }
+    void push(const ExpressionTemplatePtr& object) { mStack.back().push(object); }
     void push(const Operator& op) { mStack.back().push(op); }
     void pop(const Operator& op) { mStack.back().pop(op); }
 
@@ -333,7 +329,7 @@ public:
      */
     void reduceTernary(int order) { mStack.back().reduceTernary(order); }
 
-    Object finish()
+    ExpressionTemplatePtr finish()
     {
         LOG_IF(DEBUG_STATE) << "Stacks.finish";
         assert(mStack.size() == 1);
@@ -347,11 +343,8 @@ public:
             m.dump();
     }
 
-    const Context& context() const { return mContext; }
-
 private:
     std::vector<Stack> mStack;
-    const Context& mContext;
 };
 } // namespace datagrammar
 } // namespace apl
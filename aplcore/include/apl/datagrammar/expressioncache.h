@@ -0,0 +1,106 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_EXPRESSION_CACHE_H
+#define _APL_EXPRESSION_CACHE_H
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "apl/datagrammar/expressiontemplate.h"
+
+namespace apl {
+namespace datagrammar {
+
+/**
+ * The result of running the data-binding grammar over a string.
+ */
+struct CompiledExpression {
+    /** The parsed template.  This is null if the string failed to parse */
+    ExpressionTemplatePtr expression;
+    /** The parse error message, if any */
+    std::string error;
+};
+
+using CompiledExpressionPtr = std::shared_ptr<const CompiledExpression>;
+
+/**
+ * A process-wide, least-recently-used cache of compiled data-binding expressions keyed by
+ * source text.  Compiled expressions are context-free, so the same template is shared by
+ * every component, document, and thread that evaluates the same string.
+ *
+ * Strings that do not contain a data-binding expression are compiled on every call and are
+ * not stored; this keeps plain data payloads from evicting the expression templates.
+ */
+class ExpressionCache {
+public:
+    static const size_t DEFAULT_CAPACITY = 4096;
+
+    /**
+     * @return The shared expression cache
+     */
+    static ExpressionCache& instance();
+
+    /**
+     * Run the data-binding grammar over a string without consulting the cache.
+     * @param source The source string.
+     * @return The compiled expression.
+     */
+    static CompiledExpressionPtr compile(const std::string& source);
+
+    /**
+     * Look up a compiled expression, compiling and storing it if it has not been seen before.
+     * @param source The source string.
+     * @return The compiled expression.
+     */
+    CompiledExpressionPtr get(const std::string& source);
+
+    /**
+     * Set the maximum number of stored expressions.  A capacity of zero disables caching.
+     * @param capacity The maximum number of entries.
+     */
+    void setCapacity(size_t capacity);
+
+    /**
+     * Remove all stored expressions and reset the hit and miss counters.
+     */
+    void clear();
+
+    size_t capacity() const;
+    size_t size() const;
+    unsigned long hits() const;
+    unsigned long misses() const;
+
+private:
+    void trim();
+
+private:
+    using Entry = std::pair<std::string, CompiledExpressionPtr>;
+
+    mutable std::mutex mMutex;
+    std::list<Entry> mEntries;  // Most recently used at the front
+    std::unordered_map<std::string, std::list<Entry>::iterator> mIndex;
+    size_t mCapacity = DEFAULT_CAPACITY;
+    unsigned long mHits = 0;
+    unsigned long mMisses = 0;
+};
+
+} // namespace datagrammar
+} // namespace apl
+
+#endif // _APL_EXPRESSION_CACHE_H
@@ -0,0 +1,113 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_EXPRESSION_TEMPLATE_H
+#define _APL_EXPRESSION_TEMPLATE_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "apl/primitives/object.h"
+
+namespace apl {
+
+class Context;
+
+namespace datagrammar {
+
+class ExpressionTemplate;
+using ExpressionTemplatePtr = std::shared_ptr<const ExpressionTemplate>;
+using CreateFunction = Object (*)(std::vector<Object>&&);
+
+/**
+ * A context-free representation of a parsed data-binding string.  The data-binding grammar
+ * produces a tree of templates which records the reductions performed by the parser
+ * without looking up any symbols.  Binding a template to a context replays those reductions,
+ * resolving symbols, resources and dimensions against the context.  The result is identical
+ * to running the grammar directly against the context.
+ *
+ * Templates are immutable once constructed and may be shared between contexts, documents,
+ * and threads.
+ */
+class ExpressionTemplate
+{
+public:
+    enum Type {
+        /** A constant value with no dependency on the context */
+        kConstant,
+        /** A symbol lookup, such as ${a} */
+        kSymbol,
+        /** A resource lookup, such as ${@a} */
+        kResource,
+        /** A dimension which may depend on the viewport, such as ${10vw} */
+        kDimension,
+        /** An operator applied to the bound children */
+        kOperator,
+        /** A list of bound children; used for function arguments */
+        kVector
+    };
+
+    static ExpressionTemplatePtr constant(const Object& value);
+    static ExpressionTemplatePtr symbol(const std::string& name);
+    static ExpressionTemplatePtr resource(const std::string& name);
+    static ExpressionTemplatePtr dimension(const std::string& value);
+    static ExpressionTemplatePtr vector(std::vector<ExpressionTemplatePtr>&& children);
+
+    /**
+     * Create an operator template.  If all of the children are constants and the operator
+     * does not depend on the context, the operator is evaluated immediately and a constant
+     * template is returned.
+     * @param func The create function for the operator.
+     * @param children The operator arguments.
+     * @param name The name of the operator (for debugging).
+     * @return The template
+     */
+    static ExpressionTemplatePtr op(CreateFunction func,
+                                    std::vector<ExpressionTemplatePtr>&& children,
+                                    const std::string& name);
+
+    ExpressionTemplate(Type type, const Object& value, CreateFunction func,
+                       std::vector<ExpressionTemplatePtr>&& children, const std::string& name)
+        : mType(type), mValue(value), mFunc(func), mChildren(std::move(children)), mName(name) {}
+
+    /**
+     * Bind this template to a data-binding context.
+     * @param context The data-binding context.
+     * @return The evaluated object or a Node object.
+     */
+    Object bind(const Context& context) const;
+
+    Type type() const { return mType; }
+    const Object& value() const { return mValue; }
+    const std::vector<ExpressionTemplatePtr>& children() const { return mChildren; }
+    const std::string& name() const { return mName; }
+
+    std::string toDebugString() const;
+
+    friend streamer& operator<<(streamer&, const ExpressionTemplate&);
+
+private:
+    Type mType;
+    Object mValue;
+    CreateFunction mFunc;
+    std::vector<ExpressionTemplatePtr> mChildren;
+    std::string mName;
+};
+
+} // namespace datagrammar
+} // namespace apl
+
+#endif // _APL_EXPRESSION_TEMPLATE_H
@@ -30,6 +30,33 @@ namespace datagrammar {
 Object ApplyArrayAccess(const std::vector<Object>& args);
 Object ApplyFieldAccess(const std::vector<Object>& args);
 
+using UnaryCalculation = Object (*)(const Object&);
+using BinaryCalculation = Object (*)(const Object&, const Object&);
+
+enum OperatorKind {
+    kOperatorUnary,
+    kOperatorBinary,
+    kOperatorTernary,
+    kOperatorCombine,
+    kOperatorFunctionCall
+};
+
+/**
+ * Describes how a Node operator evaluates its arguments.  Used when lowering a Node tree into byte code.
+ */
+struct OperatorDescription {
+    OperatorKind kind;
+    UnaryCalculation unary;
+    BinaryCalculation binary;
+};
+
+/**
+ * Look up the description of a Node operator function.
+ * @param func The operator function stored in the Node.
+ * @return The description or nullptr if the operator is not known.
+ */
+const OperatorDescription* describeOperator(Object (*func)(const std::vector<Object>&));
+
 // Use these to construct an Object which may be a node or a calculated value
 extern Object UnaryPlus(std::vector<Object>&& );
 extern Object UnaryMinus(std::vector<Object>&& );
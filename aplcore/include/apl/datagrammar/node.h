@@ -67,6 +67,7 @@ public:
     }
 
     const std::vector<Object>& args() const { return mArgs; }
+    OperatorFunc op() const { return mOp; }
     std::string name() const { return mName; }
 
     std::string toDebugString() const override;
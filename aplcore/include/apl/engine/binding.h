@@ -57,6 +57,37 @@ using BindingFunction = std::function<Object(const Context&, const Object&)>;
  */
 extern const std::map<BindingType, BindingFunction> sBindingFunctions;
 
+/**
+ * How often a binding that refers to one of the time symbols (elapsedTime, localTime and
+ * utcTime) is recalculated.  By default it is recalculated every time the clock advances;
+ * a coarser granularity recalculates only when the time crosses a second or minute boundary.
+ */
+enum TimeGranularity {
+    kTimeGranularityFrame,
+    kTimeGranularitySecond,
+    kTimeGranularityMinute,
+};
+
+/**
+ * Bimap connecting user-specified strings with the TimeGranularity.
+ */
+extern const Bimap<TimeGranularity, std::string> sTimeGranularityMap;
+
+/**
+ * @param granularity The granularity.
+ * @return The period of the granularity in milliseconds or 0 for kTimeGranularityFrame.
+ */
+extern double timeGranularityPeriod(TimeGranularity granularity);
+
+/**
+ * Dependants of a time symbol with a coarse granularity are registered under a separate key
+ * so that they can be recalculated independently of the per-frame dependants.
+ * @param symbol The time symbol.
+ * @param granularity The granularity.
+ * @return The key for the dependants of the symbol at this granularity.
+ */
+extern std::string timeGranularityKey(const std::string& symbol, TimeGranularity granularity);
+
 } // namespace apl
 
 #endif //_APL_BINDING_H
@@ -17,9 +17,11 @@
 #define _APL_BUILDER_H
 
 #include "apl/component/corecomponent.h"
+#include "apl/engine/componenttemplate.h"
 
 namespace apl {
 
+class ChildInflater;
 class Path;
 
 /**
@@ -27,6 +29,7 @@ class Path;
  * RootContext or when calling Component::inflate().  Do not call them directly.
  */
 class Builder {
+    friend ChildInflater;
     friend LayoutRebuilder;
 
 public:
@@ -54,29 +57,29 @@ public:
 
 private:
     static void populateSingleChildLayout(const ContextPtr& context,
-                                          const Object& item,
+                                          const ComponentTemplate& item,
                                           const CoreComponentPtr& layout,
                                           const Path& path);
 
     static void populateLayoutComponent(const ContextPtr& context,
-                                        const Object& item,
+                                        const ComponentTemplate& item,
                                         const CoreComponentPtr& layout,
                                         const Path& path);
 
     static CoreComponentPtr expandLayout(const ContextPtr& context,
                                          Properties& properties,
-                                         const rapidjson::Value& layout,
+                                         const LayoutTemplate& layout,
                                          const CoreComponentPtr& parent,
                                          const Path& path);
 
     static CoreComponentPtr expandSingleComponentFromArray(const ContextPtr& context,
-                                                           const std::vector<Object>& items,
+                                                           const ComponentTemplateList& items,
                                                            Properties& properties,
                                                            const CoreComponentPtr& parent,
                                                            const Path& path);
 
     static CoreComponentPtr expandSingleComponent(const ContextPtr& context,
-                                                  const Object& item,
+                                                  const ComponentTemplate& item,
                                                   Properties& properties,
                                                   const CoreComponentPtr& parent,
                                                   const Path& path);
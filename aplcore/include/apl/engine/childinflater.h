@@ -0,0 +1,105 @@
+/**
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_CHILD_INFLATER_H
+#define _APL_CHILD_INFLATER_H
+
+#include "apl/common.h"
+#include "apl/engine/componenttemplate.h"
+#include "apl/primitives/object.h"
+#include "apl/utils/path.h"
+
+namespace apl {
+
+/**
+ * Inflates the children of a multi-child component from its "items" and static "data" properties.
+ * Children are inflated in order, so the "index" and "ordinal" of each child only depend on the
+ * children before it.
+ *
+ * The Builder normally inflates every child at once.  When lazy sequence inflation is enabled in
+ * the RootConfig, a Sequence or GridSequence keeps its ChildInflater and only inflates further
+ * children as layout approaches the end of the children that already exist.  New children are
+ * inserted before the "lastItem" of the layout, if there is one.  Children inflated after the
+ * document has mounted run their "onMount" commands as they are inserted.
+ */
+class ChildInflater {
+public:
+    /**
+     * @param context The data-binding context of the layout.
+     * @param layout The layout component.
+     * @param items The "items" of the layout.
+     * @param data The evaluated "data" array.  If empty, one child is inflated for each item.
+     * @param childPath The provenance path of the items.
+     * @param numbered True if the children are numbered.
+     */
+    ChildInflater(const ContextPtr& context,
+                  const CoreComponentPtr& layout,
+                  const ComponentTemplateListPtr& items,
+                  const Object& data,
+                  const Path& childPath,
+                  bool numbered);
+
+    /**
+     * Inflate the next child and add it to the layout.  Entries that do not produce a valid
+     * component are skipped.
+     * @param useDirtyFlag True if the layout should be notified of the new child.  This is only
+     *                     false during the first layout pass, before the document has mounted.
+     * @return True if a child was added.
+     */
+    bool inflateNext(bool useDirtyFlag);
+
+    /**
+     * Inflate every remaining child.
+     * @param useDirtyFlag True if the layout should be notified of the new children.
+     */
+    void inflateAll(bool useDirtyFlag);
+
+    /**
+     * @return True if every child has been inflated.
+     */
+    bool done() const { return mNext >= mLength; }
+
+    /**
+     * @return The number of entries that have not been inflated yet.
+     */
+    size_t remaining() const { return mLength - mNext; }
+
+    /**
+     * @param hasLastItem True if the layout ends with a "lastItem" that new children are inserted before.
+     */
+    void setHasLastItem(bool hasLastItem) { mHasLastItem = hasLastItem; }
+
+    /**
+     * @return True if the layout ends with a "lastItem".
+     */
+    bool hasLastItem() const { return mHasLastItem; }
+
+private:
+    ContextPtr mContext;
+    std::weak_ptr<CoreComponent> mLayout;
+    const ComponentTemplateListPtr mItems;
+    const Object mData;
+    const Path mChildPath;
+    const bool mNumbered;
+    const size_t mLength;
+    bool mHasLastItem = false;
+    size_t mNext = 0;   // Next data or items entry to inflate
+    int mIndex = 0;     // Index of the next child
+    int mOrdinal = 1;   // Ordinal of the next child
+};
+
+} // namespace apl
+
+#endif // _APL_CHILD_INFLATER_H
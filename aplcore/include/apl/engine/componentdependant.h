@@ -44,12 +44,14 @@ public:
      * @param equation The expression which will be evaluated to recalculate downstream.
      * @param bindingContext The context where the equation will be bound
      * @param bindingFunction The binding function that will be applied after evaluating the equation
+     * @param granularity How often to recalculate when the equation refers to a time symbol
      */
     static void create(const CoreComponentPtr& downstreamComponent,
                        PropertyKey downstreamKey,
                        const Object& equation,
                        const ContextPtr& bindingContext,
-                       BindingFunction bindingFunction);
+                       BindingFunction bindingFunction,
+                       TimeGranularity granularity = kTimeGranularityFrame);
 
     /**
      * Internal constructor: do not call.  Use ComponentDependant::create instead.
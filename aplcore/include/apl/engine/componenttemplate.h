@@ -0,0 +1,247 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ *
+ * Component templates
+ *
+ * A component template is the pre-processed form of a single component definition in
+ * the document, such as an entry in an "items" array or the body of a named layout.
+ * The parts of the definition that do not depend on data-binding (the component type,
+ * the property map, binding names and types, and inline child definitions) are extracted
+ * once.  The Builder then evaluates only the data-bound parts for each inflated instance.
+ */
+
+#ifndef _APL_COMPONENT_TEMPLATE_H
+#define _APL_COMPONENT_TEMPLATE_H
+
+#include <memory>
+#include <vector>
+
+#include "apl/common.h"
+#include "apl/engine/binding.h"
+#include "apl/engine/parameterarray.h"
+#include "apl/engine/properties.h"
+#include "apl/primitives/object.h"
+#include "apl/utils/path.h"
+
+namespace apl {
+
+class ComponentTemplate;
+class LayoutTemplate;
+using ComponentTemplatePtr = std::shared_ptr<const ComponentTemplate>;
+using LayoutTemplatePtr = std::shared_ptr<const LayoutTemplate>;
+using ComponentTemplateList = std::vector<ComponentTemplatePtr>;
+using ComponentTemplateListPtr = std::shared_ptr<const ComponentTemplateList>;
+
+using MakeComponentFunc = CoreComponentPtr (*)(const ContextPtr&, Properties&&, const std::string&);
+
+/**
+ * A list of component definitions taken from a property such as "items" or "firstItem".
+ * An inline list of definitions is compiled once.  A list that contains data-bound strings
+ * is array-ified and compiled each time it is requested.
+ */
+class TemplateList {
+public:
+    TemplateList() = default;
+
+    /**
+     * @param value The raw value of the property.
+     */
+    explicit TemplateList(const Object& value);
+
+    /**
+     * @param context The data-binding context.
+     * @return The component templates.
+     */
+    ComponentTemplateListPtr get(const Context& context) const;
+
+    /**
+     * @return True if this list does not depend on data-binding.
+     */
+    bool isStatic() const { return mTemplates != nullptr || mValue.isNull(); }
+
+private:
+    Object mValue;
+    ComponentTemplateListPtr mTemplates;
+};
+
+/**
+ * A pre-processed entry from the "bind" property of a component.
+ */
+class BindingTemplate {
+public:
+    explicit BindingTemplate(const Object& binding);
+
+    /**
+     * @return The name of the binding, or an empty string if it is not valid.
+     */
+    std::string name(const Context& context) const;
+
+    /**
+     * @return The binding type.
+     */
+    BindingType type(const Context& context) const;
+
+    /**
+     * @return How often the binding is recalculated when it refers to a time symbol.
+     */
+    TimeGranularity granularity(const Context& context) const;
+
+    /**
+     * @return The raw binding value, if it has one.
+     */
+    const Object& value() const { return mValue; }
+    bool hasValue() const { return mHasValue; }
+
+private:
+    Object mBinding;
+    Object mValue;
+    std::string mName;
+    BindingType mType;
+    TimeGranularity mGranularity;
+    bool mHasValue;
+    bool mStaticName;
+    bool mStaticType;
+    bool mStaticGranularity;
+};
+
+using BindingTemplateList = std::vector<BindingTemplate>;
+using BindingTemplateListPtr = std::shared_ptr<const BindingTemplateList>;
+
+/**
+ * A pre-processed component definition.
+ */
+class ComponentTemplate {
+public:
+    /**
+     * Compile a single component definition.
+     * @param item The JSON definition of the component.
+     * @return The template.  It is not valid if the item is not a component definition.
+     */
+    static ComponentTemplatePtr create(const Object& item);
+
+    /**
+     * Compile a list of component definitions.
+     */
+    static ComponentTemplateListPtr create(const std::vector<Object>& items);
+
+    /**
+     * Internal constructor.  Use the static create() method instead.
+     */
+    explicit ComponentTemplate(const Object& item);
+
+    /**
+     * @return The original JSON definition.
+     */
+    const Object& item() const { return mItem; }
+
+    /**
+     * @return True if the original definition is a map.  Other values are skipped by the Builder.
+     */
+    bool isValid() const { return mValid; }
+
+    /**
+     * @return True if the "when" clause of the definition is satisfied (or missing).
+     */
+    bool when(const Context& context) const;
+
+    /**
+     * @return The component or layout type.
+     */
+    std::string type(const Context& context) const;
+
+    /**
+     * @param type The type returned by type().
+     * @return The function that constructs a primitive component of this type or nullptr
+     *         if the type is not a primitive component.
+     */
+    MakeComponentFunc factory(const std::string& type) const;
+
+    /**
+     * @return The properties of the definition, not including "type" and "when".
+     */
+    const PropertyValueMap& properties() const { return mProperties; }
+
+    /**
+     * @return The entries of the "bind" property.
+     */
+    BindingTemplateListPtr bindings(const Context& context) const;
+
+    const TemplateList& items() const { return mItems; }
+    const TemplateList& firstItem() const { return mFirstItem; }
+    const TemplateList& lastItem() const { return mLastItem; }
+
+    /**
+     * @param type A component type.
+     * @return The function that constructs a primitive component of this type or nullptr.
+     */
+    static MakeComponentFunc findFactory(const std::string& type);
+
+private:
+    Object mItem;
+    Object mWhen;
+    Object mType;
+    Object mBind;
+    PropertyValueMap mProperties;
+    std::string mStaticTypeName;
+    MakeComponentFunc mFactory = nullptr;
+    BindingTemplateListPtr mBindings;
+    TemplateList mItems;
+    TemplateList mFirstItem;
+    TemplateList mLastItem;
+    bool mValid;
+    bool mStaticWhen = true;
+    bool mStaticType = false;
+};
+
+/**
+ * A pre-processed layout: the "mainTemplate" or a named layout from the "layouts" section.
+ */
+class LayoutTemplate {
+public:
+    /**
+     * @param layout The JSON definition of the layout.
+     * @param path The provenance path of the layout.
+     */
+    explicit LayoutTemplate(const rapidjson::Value& layout, const Path& path = Path());
+
+    /**
+     * @return The original JSON definition of the layout
+     */
+    const Object& layout() const { return mLayout; }
+
+    /**
+     * @return The provenance path of the layout
+     */
+    const Path& path() const { return mPath; }
+
+    /**
+     * @return The parameters of the layout
+     */
+    const ParameterArray& parameters() const { return mParameters; }
+
+    /**
+     * @return The component definitions in the "item" or "items" property.
+     */
+    const TemplateList& items() const { return mItems; }
+
+private:
+    Object mLayout;
+    Path mPath;
+    ParameterArray mParameters;
+    TemplateList mItems;
+};
+
+} // namespace apl
+
+#endif // _APL_COMPONENT_TEMPLATE_H
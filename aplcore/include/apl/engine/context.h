@@ -30,10 +30,12 @@
 #include "apl/engine/recalculatetarget.h"
 #include "apl/engine/styleinstance.h"
 #include "apl/utils/path.h"
+#include "apl/engine/contextmap.h"
 #include "apl/engine/contextobject.h"
 
 namespace apl {
 
+class Arena;
 class Metrics;
 class Styles;
 class RootContextData;
@@ -43,17 +45,20 @@ class Sequencer;
 class RootConfig;
 class FocusManager;
 class HoverManager;
+class LayoutTemplate;
 
 class KeyboardManager;
 class LiveDataManager;
 class ExtensionManager;
+class TextMeasureCache;
+class TickScheduler;
 
 /*
  * The data-binding context holds information about the local environment, metrics, and resources.
  * Context objects should be heap-allocated with a shared pointer to their parent context.
  */
-class Context : public RecalculateTarget<std::string>,
-                public RecalculateSource<std::string>,
+class Context : public RecalculateTarget<Atom>,
+                public RecalculateSource<Atom>,
                 public std::enable_shared_from_this<Context> {
 public:
     /**
@@ -61,9 +66,7 @@ public:
      * @param parent The parent context.
      * @return The child context.
      */
-    static ContextPtr create(const ContextPtr& parent) {
-        return std::make_shared<Context>(parent);
-    }
+    static ContextPtr create(const ContextPtr& parent);
 
     /**
      * Create a top-level context for testing. Do not use this for non-testing code
@@ -138,21 +141,23 @@ public:
      * Return a reference to an object in some context.  This is typically
      * used to find and retrieve objects when searching upwards through the context hierarchy.
      *
-     * Note that we store raw pointers in this object.  This object should only be used as a
-     * temporary when there is no chance of a ContextPtr going out of scope.
+     * Note that we store a raw context pointer in this object.  This object should only be used
+     * as a temporary when there is no chance of a ContextPtr going out of scope.  The object is
+     * addressed by its position in the context, so the reference stays valid when symbols are
+     * added to the context.
      */
     class ContextRef {
     public:
         ContextRef() = default;
-        ContextRef(const Context& context, const ContextObject& object) : mContext(&context), mObject(&object) {}
+        ContextRef(const Context& context, size_t index) : mContext(&context), mIndex(index) {}
 
         bool empty() const {
-            return mContext == nullptr || mObject == nullptr;
+            return mContext == nullptr;
         }
 
         const ContextObject& object() const {
-            assert(mObject);
-            return *mObject;
+            assert(mContext);
+            return mContext->mMap.at(mIndex).second;
         }
 
         ContextPtr context() const {
@@ -161,7 +166,7 @@ public:
 
     private:
         const Context *mContext = nullptr;
-        const ContextObject *mObject = nullptr;
+        size_t mIndex = 0;
     };
 
     /**
@@ -170,12 +175,13 @@ public:
      * @return The context reference object
      */
     ContextRef find(const std::string& key) const {
-        auto it = mMap.find(key);
-        if (it != mMap.end())
-            return { *this, it->second };
-
-        if (mParent)
-            return mParent->find(key);
+        // The key is hashed once and the hash is reused at each level of the context chain
+        auto hash = ContextMap::hash(key);
+        for (auto context = this ; context ; context = context->mParent.get()) {
+            auto index = context->mMap.indexOf(key, hash);
+            if (index < context->mMap.size())
+                return { *context, index };
+        }
 
         return {};
     }
@@ -235,11 +241,11 @@ public:
      * @return True if the key name exists in this context; false if there is no binding value with this name.
      */
     bool propagate(const std::string& key, const Object& value, bool useDirtyFlag) {
-        auto it = mMap.find(key);
-        if (it == mMap.end())
+        auto object = mMap.find(key);
+        if (!object)
             return false;
 
-        if (it->second.set(value))
+        if (object->set(value))
             recalculateDownstream(key, useDirtyFlag);
 
         return true;
@@ -272,7 +278,7 @@ public:
      * @param key The string key name.
      * @param value The value to store.
      */
-    void putConstant(const std::string& key, const Object& value)
+    void putConstant(const Atom& key, const Object& value)
     {
         mMap.emplace(key, ContextObject(value));
     }
@@ -286,7 +292,7 @@ public:
      * @param key The string key name
      * @param value The value to store.
      */
-    void putUserWriteable(const std::string& key, const Object& value)
+    void putUserWriteable(const Atom& key, const Object& value)
     {
         mMap.emplace(key, ContextObject(value).userWriteable());
     }
@@ -299,7 +305,7 @@ public:
      * @param key The string key name
      * @param value The value to store
      */
-    void putSystemWriteable(const std::string& key, const Object& value)
+    void putSystemWriteable(const Atom& key, const Object& value)
     {
         mMap.emplace(key, ContextObject(value).systemWriteable());
     }
@@ -313,13 +319,9 @@ public:
      * @param path The path data to associate with this key
      * @return True if the key already exists in this context.
      */
-    void putResource(const std::string& key, const Object& value, const Path& path) {
+    void putResource(const Atom& key, const Object& value, const Path& path) {
         // Toss away a resource if it already exists (we overwrite it)
-        auto it = mMap.find(key);
-        if (it != mMap.end())
-            mMap.erase(it);
-
-        mMap.emplace(key, ContextObject(value).provenance(path));
+        mMap.replace(key, ContextObject(value).provenance(path));
     }
 
     /**
@@ -329,12 +331,9 @@ public:
      */
     std::string provenance(const std::string& key) const {
         // The provenance for a key can only be used if the current map has that key entry
-        auto it = mMap.find(key);
-        if (it != mMap.end())
-            return it->second.provenance().toString();
-
-        if (mParent)
-            return mParent->provenance(key);
+        auto cr = find(key);
+        if (!cr.empty())
+            return cr.object().provenance().toString();
 
         return "";
     }
@@ -345,12 +344,9 @@ public:
      * @return True if the value is mutable.
      */
     bool isMutable(const std::string& key) const {
-        auto it = mMap.find(key);
-        if (it != mMap.end())
-            return it->second.isMutable();
-
-        if (mParent)
-            return mParent->isMutable(key);
+        auto cr = find(key);
+        if (!cr.empty())
+            return cr.object().isMutable();
 
         return false;
     }
@@ -358,12 +354,12 @@ public:
     /**
      * @return An iterator to the beginning of defined bindings
      */
-    std::map<std::string, ContextObject>::const_iterator begin() const { return mMap.begin(); }
+    ContextMap::const_iterator begin() const { return mMap.begin(); }
 
     /**
      * @return An iterator to the end of the defined bindings
      */
-    std::map<std::string, ContextObject>::const_iterator end() const { return mMap.end(); }
+    ContextMap::const_iterator end() const { return mMap.end(); }
 
     /**
      * @return The parent of this context or nullptr if there is no parent
@@ -422,6 +418,14 @@ public:
      */
     const JsonResource getLayout(const std::string& name) const;
 
+    /**
+     * Lookup and return the compiled template of a named layout.  Templates are compiled the
+     * first time they are requested and shared by all later inflations of the layout.
+     * @param name The name of the layout
+     * @return The layout template.  May be null if the layout cannot be found
+     */
+    std::shared_ptr<const LayoutTemplate> getLayoutTemplate(const std::string& name) const;
+
     /**
      * Lookup and return a style by name
      * @param name The name of the style
@@ -477,6 +481,7 @@ public:
     KeyboardManager& keyboardManager() const;
     LiveDataManager& dataManager() const;
     ExtensionManager& extensionManager() const;
+    TickScheduler& tickScheduler() const;
     std::shared_ptr<Styles> styles() const;
 
     const SessionPtr& session() const;
@@ -485,6 +490,14 @@ public:
 
     const TextMeasurementPtr& measure() const;
 
+    TextMeasureCache& textMeasureCache() const;
+
+    /**
+     * @return The arena that hosts the objects of this document.  Null if arena allocation
+     *         is not enabled.
+     */
+    const std::shared_ptr<Arena>& arena() const;
+
     void takeScreenLock() const;
     void releaseScreenLock() const;
 
@@ -500,7 +513,7 @@ protected:
     ContextPtr mParent;
     ContextPtr mTop;
     std::shared_ptr<RootContextData> mCore;
-    std::map<std::string, ContextObject> mMap;
+    ContextMap mMap;
 };
 
 }  // namespace apl
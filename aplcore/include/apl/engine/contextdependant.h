@@ -45,12 +45,14 @@ public:
      * @param equation The expression which will be evaluated to recalculate downstream.
      * @param bindingContext The context where the equation will be bound
      * @param bindingFunction The binding function that will be applied after evaluating the equation
+     * @param granularity How often to recalculate when the equation refers to a time symbol
      */
     static void create(const ContextPtr& downstreamContext,
                        const std::string& downstreamName,
                        const Object& equation,
                        const ContextPtr& bindingContext,
-                       BindingFunction bindingFunction);
+                       BindingFunction bindingFunction,
+                       TimeGranularity granularity = kTimeGranularityFrame);
 
 
     /**
@@ -74,6 +76,9 @@ public:
 
     void recalculate(bool useDirtyFlag) const override;
 
+protected:
+    void raiseDownstreamRank() override;
+
 private:
     std::weak_ptr<Context> mDownstreamContext;
     std::string mDownstreamName;
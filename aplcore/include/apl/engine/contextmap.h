@@ -0,0 +1,176 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_CONTEXT_MAP_H
+#define _APL_CONTEXT_MAP_H
+
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "apl/engine/contextobject.h"
+#include "apl/utils/atom.h"
+
+namespace apl {
+
+/**
+ * Symbol storage for a single data-binding Context.
+ *
+ * Most contexts hold a handful of symbols ("data", "index", "length", component bindings or
+ * layout parameters), so the first few entries are stored inline in the map itself and only
+ * larger maps allocate.  Entries are kept in insertion order and are addressed by position;
+ * a position stays valid when symbols are added, but an entry past the inline capacity may
+ * move, so hold positions rather than pointers.  Keys are interned Atoms and carry their hash.
+ * A lookup hashes the key once and the hash is reused for every context in the parent chain;
+ * string comparisons are only made on a hash match.
+ *
+ * Contexts with many symbols (typically the top-level context holding resources) add an
+ * open-addressed index over the entries so that a lookup stays O(1).
+ */
+class ContextMap {
+public:
+    using value_type = std::pair<Atom, ContextObject>;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = ContextMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        const_iterator(const ContextMap *map, size_t index) : mMap(map), mIndex(index) {}
+
+        reference operator*() const { return mMap->at(mIndex); }
+        pointer operator->() const { return &mMap->at(mIndex); }
+        const_iterator& operator++() { mIndex++; return *this; }
+        const_iterator operator++(int) { auto result = *this; ++(*this); return result; }
+        bool operator==(const const_iterator& rhs) const { return mIndex == rhs.mIndex; }
+        bool operator!=(const const_iterator& rhs) const { return mIndex != rhs.mIndex; }
+
+    private:
+        const ContextMap *mMap;
+        size_t mIndex;
+    };
+
+    /**
+     * The number of entries stored without a heap allocation.
+     */
+    static const size_t INLINE_CAPACITY = 4;
+
+    ContextMap() = default;
+    ~ContextMap();
+
+    ContextMap(const ContextMap& other);
+    ContextMap& operator=(const ContextMap& other);
+
+    /**
+     * @param key A symbol name
+     * @return The hash used to look up that symbol.
+     */
+    static size_t hash(const std::string& key) { return std::hash<std::string>()(key); }
+
+    /**
+     * Find the position of a symbol.
+     * @param key The symbol name.
+     * @param hash The hash of the symbol name, as returned by hash().
+     * @return The position of the symbol or size() if it does not exist.
+     */
+    size_t indexOf(const std::string& key, size_t hash) const;
+
+    /**
+     * @param index The position of an entry.  Must be less than size().
+     * @return The entry.
+     */
+    const value_type& at(size_t index) const {
+        return index < INLINE_CAPACITY ? inlineEntry(index) : mOverflow[index - INLINE_CAPACITY];
+    }
+
+    value_type& at(size_t index) {
+        return index < INLINE_CAPACITY ? inlineEntry(index) : mOverflow[index - INLINE_CAPACITY];
+    }
+
+    /**
+     * Find a symbol.
+     * @param key The symbol name.
+     * @param hash The hash of the symbol name, as returned by hash().
+     * @return The stored object or nullptr if it does not exist.  The pointer is only valid
+     *         until the next symbol is added.
+     */
+    const ContextObject* find(const std::string& key, size_t hash) const {
+        auto index = indexOf(key, hash);
+        return index < mSize ? &at(index).second : nullptr;
+    }
+
+    ContextObject* find(const std::string& key, size_t hash) {
+        auto index = indexOf(key, hash);
+        return index < mSize ? &at(index).second : nullptr;
+    }
+
+    const ContextObject* find(const std::string& key) const { return find(key, hash(key)); }
+    ContextObject* find(const std::string& key) { return find(key, hash(key)); }
+
+    /**
+     * Store a symbol if it has not already been stored.
+     * @param key The symbol name.
+     * @param object The value to store.
+     * @return True if the symbol was stored.
+     */
+    bool emplace(const Atom& key, const ContextObject& object);
+
+    /**
+     * Store a symbol, replacing any existing symbol with the same name.
+     * @param key The symbol name.
+     * @param object The value to store.
+     */
+    void replace(const Atom& key, const ContextObject& object);
+
+    size_t size() const { return mSize; }
+    bool empty() const { return mSize == 0; }
+
+    /**
+     * @return The number of bytes allocated outside of the map object for entries and the index.
+     */
+    size_t heapBytes() const {
+        return mOverflow.capacity() * sizeof(value_type) + mIndex.capacity() * sizeof(uint32_t);
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, mSize); }
+
+private:
+    using Storage = std::aligned_storage<sizeof(value_type), alignof(value_type)>::type;
+
+    const value_type& inlineEntry(size_t index) const { return *reinterpret_cast<const value_type*>(&mInline[index]); }
+    value_type& inlineEntry(size_t index) { return *reinterpret_cast<value_type*>(&mInline[index]); }
+
+    void append(const Atom& key, const ContextObject& object);
+    void clear();
+    void insertIndex(size_t hash, uint32_t position);
+    void rebuildIndex();
+
+    Storage mInline[INLINE_CAPACITY];     // The first entries, constructed in place
+    std::vector<value_type> mOverflow;    // Entries past the inline capacity
+    std::vector<uint32_t> mIndex;         // Position + 1 of each entry; zero marks an empty slot
+    uint32_t mSize = 0;
+};
+
+} // namespace apl
+
+#endif // _APL_CONTEXT_MAP_H
@@ -0,0 +1,201 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ *
+ * Binary delta stream
+ *
+ * A compact alternative to CoreComponent::serializeDirty() for view hosts that forward
+ * dirty properties across a process boundary.  The encoder writes the dirty properties of
+ * each component directly into a caller-provided buffer; no JSON DOM is built and property
+ * names are sent as their numeric keys.
+ *
+ * All integers are little-endian.  The stream layout (version 1) is:
+ *
+ *     Header     "APLD" (4 bytes), uint16 version, uint16 reserved (0)
+ *     Component  uint8 0x01, uint16 uid length, uid bytes, uint16 property count, properties...
+ *     Property   uint16 PropertyKey, value
+ *     Value      uint8 DeltaValueType followed by:
+ *                  kDeltaNull, kDeltaAutoDimension   nothing
+ *                  kDeltaBoolean                     uint8
+ *                  kDeltaNumber                      float64
+ *                  kDeltaAbsoluteDimension           float64
+ *                  kDeltaRelativeDimension           float64
+ *                  kDeltaColor                       uint32 RGBA
+ *                  kDeltaString                      uint32 length, UTF-8 bytes
+ *                  kDeltaRect                        4 x float32 (left, top, width, height)
+ *                  kDeltaRadii                       4 x float32
+ *                  kDeltaTransform2D                 6 x float32
+ *                  kDeltaJson                        uint32 length, JSON text
+ *
+ * Values without a binary form (gradients, filters, styled text, graphics, and so on) are
+ * written as the same JSON that serializeDirty() produces.  A decoder must reject a stream
+ * with a version it does not know; new value types are only added with a new version.
+ */
+
+#ifndef _APL_DELTA_STREAM_H
+#define _APL_DELTA_STREAM_H
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "apl/component/component.h"
+#include "apl/primitives/object.h"
+
+namespace apl {
+
+enum DeltaValueType {
+    kDeltaNull = 0,
+    kDeltaBoolean = 1,
+    kDeltaNumber = 2,
+    kDeltaString = 3,
+    kDeltaColor = 4,
+    kDeltaAbsoluteDimension = 5,
+    kDeltaRelativeDimension = 6,
+    kDeltaAutoDimension = 7,
+    kDeltaRect = 8,
+    kDeltaRadii = 9,
+    kDeltaTransform2D = 10,
+    kDeltaJson = 11,
+};
+
+/**
+ * Write the dirty properties of components into a buffer.
+ *
+ * The encoder never writes past the end of the buffer.  If the buffer is too small the
+ * encoder keeps counting, so that size() reports the number of bytes required and the
+ * caller can retry with a larger buffer.  Encoding does not clear the dirty properties;
+ * call RootContext::clearDirty() once the stream has been delivered.
+ *
+ *     std::vector<uint8_t> buffer(4096);
+ *     DeltaEncoder encoder(buffer.data(), buffer.size());
+ *     if (!encoder.add(root->getDirty())) {
+ *         buffer.resize(encoder.size());
+ *         ...
+ *     }
+ *     send(buffer.data(), encoder.size());
+ *     root->clearDirty();
+ */
+class DeltaEncoder {
+public:
+    static const uint16_t VERSION = 1;
+
+    /**
+     * Start a new stream.  The header is written immediately.
+     * @param buffer The destination buffer.
+     * @param capacity The size of the destination buffer in bytes.
+     */
+    DeltaEncoder(void *buffer, size_t capacity);
+
+    /**
+     * Write a record for the dirty properties of a component.  Nothing is written if the
+     * component has no dirty properties.
+     * @param component The component.
+     * @return True if the stream still fits in the buffer.
+     */
+    bool add(const ComponentPtr& component);
+
+    /**
+     * Write records for a set of components, typically RootContext::getDirty().
+     * @return True if the stream still fits in the buffer.
+     */
+    bool add(const std::set<ComponentPtr>& components);
+
+    /**
+     * @return The number of bytes in the stream.  This may exceed the capacity.
+     */
+    size_t size() const { return mSize; }
+
+    /**
+     * @return True if the stream did not fit in the buffer.
+     */
+    bool overflow() const { return mSize > mCapacity; }
+
+private:
+    void writeValue(const Object& value);
+    void write(const void *data, size_t length);
+    void writeU8(uint8_t value);
+    void writeU16(uint16_t value);
+    void writeU32(uint32_t value);
+    void writeF32(float value);
+    void writeF64(double value);
+
+    uint8_t *mBuffer;
+    size_t mCapacity;
+    size_t mSize = 0;
+};
+
+/**
+ * The dirty properties of one component as read from a delta stream.
+ */
+struct DeltaRecord {
+    std::string uid;
+    std::vector<std::pair<PropertyKey, Object>> properties;
+};
+
+/**
+ * Read a stream written by DeltaEncoder.
+ *
+ *     DeltaDecoder decoder(data, size);
+ *     DeltaRecord record;
+ *     while (decoder.next(record))
+ *         apply(record);
+ *     if (decoder.error()) ...
+ */
+class DeltaDecoder {
+public:
+    /**
+     * @param buffer The stream.
+     * @param size The number of bytes in the stream.
+     */
+    DeltaDecoder(const void *buffer, size_t size);
+
+    /**
+     * @return The version of the stream or 0 if the header is not valid.
+     */
+    uint16_t version() const { return mVersion; }
+
+    /**
+     * Read the next component record.
+     * @param record Filled with the component uid and its properties.
+     * @return True if a record was read; false at the end of the stream or on an error.
+     */
+    bool next(DeltaRecord& record);
+
+    /**
+     * @return True if the header was invalid, the version is not supported, or the stream
+     *         was truncated or malformed.
+     */
+    bool error() const { return mError; }
+
+private:
+    bool readValue(Object& value);
+    bool read(void *data, size_t length);
+    bool readU8(uint8_t& value);
+    bool readU16(uint16_t& value);
+    bool readU32(uint32_t& value);
+    bool readF32(float& value);
+    bool readF64(double& value);
+
+    const uint8_t *mBuffer;
+    size_t mSize;
+    size_t mOffset = 0;
+    uint16_t mVersion = 0;
+    bool mError = false;
+};
+
+} // namespace apl
+
+#endif // _APL_DELTA_STREAM_H
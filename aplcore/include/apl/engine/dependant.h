@@ -16,7 +16,9 @@
 #ifndef _APL_DEPENDANT_H
 #define _APL_DEPENDANT_H
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "apl/common.h"
 #include "apl/utils/counter.h"
@@ -25,6 +27,13 @@
 
 namespace apl {
 
+namespace datagrammar {
+class ByteCode;
+}
+
+class DownstreamRegistry;
+class SymbolReferenceMap;
+
 /**
  * A Dependant connects something that changes (like a data-binding) to something that needs to be informed
  * when a change occurs. The upstream object normally holds an array of dependants to be recalculated.  Each
@@ -40,12 +49,8 @@ public:
 #endif
 
 public:
-    Dependant(const Object& equation, const ContextPtr& bindingContext, BindingFunction bindingFunction)
-        : mEquation(equation),
-          mBindingContext(bindingContext),
-          mBindingFunction(bindingFunction)
-        {}
-    virtual ~Dependant() = default;
+    Dependant(const Object& equation, const ContextPtr& bindingContext, BindingFunction bindingFunction);
+    virtual ~Dependant();
 
     /**
      * Remove this dependant from the source or upstream. If you override this, call the base method.
@@ -58,10 +63,77 @@ public:
      */
     virtual void recalculate(bool useDirtyFlag) const = 0;
 
+    /**
+     * @return The recalculation order of this dependant.  A dependant has a higher rank than every
+     *         dependant that calculates one of its inputs.
+     */
+    unsigned int rank() const { return mRank; }
+
+    /**
+     * @return True if this dependant has not been removed from its source.
+     */
+    bool isAttached() const { return !mEquation.isNull(); }
+
+protected:
+    /**
+     * Assign the rank of this dependant from the symbols it refers to.  Call this before
+     * connecting the dependant downstream of its target.
+     * @param symbols The symbols referenced by the equation.
+     */
+    void assignRank(const SymbolReferenceMap& symbols);
+
+    /**
+     * Assign the rank of this dependant and register it downstream of every symbol it refers to.
+     * A reference to one of the time symbols in the top-level context is registered under the
+     * key for the granularity, so the RootContext only recalculates this dependant when the
+     * time crosses a period of that granularity.
+     * @param symbols The symbols referenced by the equation.
+     * @param granularity How often to recalculate when the equation refers to a time symbol.
+     */
+    void connectSources(const SymbolReferenceMap& symbols, TimeGranularity granularity);
+
+    /**
+     * Raise the rank of this dependant after a new dependant starts calculating one of its inputs.
+     * Dependants that read the value calculated by this dependant are raised as well.
+     * @param rank The lowest rank this dependant may have.
+     */
+    void raiseRank(unsigned int rank);
+
+    /**
+     * Raise the rank of the dependants that read the value calculated by this dependant.  Override
+     * this if the downstream object is also a source of other dependants.
+     */
+    virtual void raiseDownstreamRank() {}
+
+    /**
+     * Evaluate the equation.  Evaluable equations run from compiled byte code.
+     * @param bindingContext The context the equation is bound in.
+     * @return The new value of the equation.
+     */
+    Object calculate(const Context& bindingContext) const;
+
 protected:
     Object mEquation;                        // The equation or expression to be evaluated
+    std::shared_ptr<const datagrammar::ByteCode> mByteCode;  // The compiled equation; null if not evaluable
     std::weak_ptr<Context> mBindingContext;  // The context the BindingFunction will be applied in
     BindingFunction mBindingFunction;        // The function to be applied after evaluation
+    unsigned int mRank = 0;                  // Recalculation order within a RecalculateBatch
+
+private:
+    friend class DownstreamRegistry;
+
+    /**
+     * The location of this dependant in the downstream registry of one source.
+     */
+    struct SourceHandle {
+        DownstreamRegistry *registry;   // Cleared if the registry is destroyed first
+        uint32_t bucket;
+        uint32_t position;
+    };
+
+    void detach();
+
+    std::vector<SourceHandle> mSources;
 };
 
 }  // namespace apl
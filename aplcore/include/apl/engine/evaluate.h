@@ -22,6 +22,10 @@
 
 namespace apl {
 
+namespace datagrammar {
+class ByteCode;
+}
+
 /**
  * Parse a data-binding string and return the parsed expression.  If the string contains
  * data-binding expressions referring to symbols not defined in the current context
@@ -61,6 +65,15 @@ Object evaluate(const Context& context, const char *expression);
  */
 Object reevaluate(const Context& context, const Object& equation);
 
+/**
+ * Re-evaluate an equation that has been compiled into byte code.  This returns the same
+ * value as re-evaluating the original equation.
+ * @param context The binding context of the equation
+ * @param byteCode The compiled equation
+ * @return The resultant value
+ */
+Object reevaluate(const Context& context, const datagrammar::ByteCode& byteCode);
+
 /**
  * Evaluate an object recursively.  Arrays and maps within the object will also
  * be evaluated for data-binding.
@@ -27,6 +27,7 @@
 
 #include "apl/engine/binding.h"
 #include "apl/primitives/object.h"
+#include "apl/utils/atom.h"
 
 namespace apl {
 
@@ -36,7 +37,7 @@ struct Parameter {
           type(type),
           defvalue(defvalue) {}
 
-    std::string name;
+    Atom name;
     BindingType type;
     Object defvalue;
 };
@@ -50,6 +51,8 @@ public:
 
     std::vector<Parameter>::iterator begin() { return mArray.begin(); }
     std::vector<Parameter>::iterator end() { return mArray.end(); }
+    std::vector<Parameter>::const_iterator begin() const { return mArray.begin(); }
+    std::vector<Parameter>::const_iterator end() const { return mArray.end(); }
 
 private:
     std::vector<Parameter> mArray;
@@ -266,7 +266,7 @@ public:
      */
     PropDef(K key, const Object& defvalue, BindingFunction func, int flags=0)
         : key(key),
-          names(bimap.all(key)),
+          names(toAtoms(bimap.all(key))),
           defvalue(defvalue),
           func(func),
           flags(flags),
@@ -283,7 +283,7 @@ public:
      */
     PropDef(K key, int defvalue, Bimap<int, std::string>& map, int flags=0)
         : key(key),
-          names(bimap.all(key)),
+          names(toAtoms(bimap.all(key))),
           defvalue(defvalue),
           func(nullptr),
           flags(flags),
@@ -320,7 +320,7 @@ public:
     }
 
     K key;
-    std::vector<std::string> names;
+    std::vector<Atom> names;
     Object defvalue;
     BindingFunction func;
     int flags;
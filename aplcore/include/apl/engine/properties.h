@@ -31,10 +31,16 @@
 #define _APL_PROPERTIES_H
 
 #include "apl/primitives/object.h"
+#include "apl/utils/atom.h"
 #include "parameterarray.h"
 
 namespace apl {
 
+/**
+ * Property names are interned; the same names are repeated in every component of a document.
+ */
+using PropertyValueMap = std::map<Atom, Object>;
+
 class Properties {
 public:
     Properties() {};
@@ -48,13 +54,20 @@ public:
     Dimension asAbsoluteDimension(const Context& context, const char *name, double defvalue);
 
     void emplace(const Object& item);
-    void emplace(const std::string& name, const Object& value) { mProperties.emplace(name, value); }
+    void emplace(const PropertyValueMap& properties);
+    void emplace(const Atom& name, const Object& value) { mProperties.emplace(name, value); }
 
     void addToContext(const ContextPtr &context, const Parameter &parameter, bool userWriteable);
 
-    ObjectMap::const_iterator find(const char *name) const { return mProperties.find(name); }
-    ObjectMap::const_iterator find(const std::string& name) const { return mProperties.find(name); }
-    ObjectMap::const_iterator find(const std::vector<std::string>& names) const {
+    PropertyValueMap::const_iterator find(const Atom& name) const { return mProperties.find(name); }
+
+    // Look up a name without interning it
+    PropertyValueMap::const_iterator find(const std::string& name) const {
+        auto key = Atom::find(name);
+        return key.empty() ? mProperties.end() : mProperties.find(key);
+    }
+    PropertyValueMap::const_iterator find(const char *name) const { return find(std::string(name)); }
+    PropertyValueMap::const_iterator find(const std::vector<Atom>& names) const {
         for (const auto& name : names) {
             auto it = mProperties.find(name);
             if (it != mProperties.end())
@@ -63,11 +76,11 @@ public:
         return mProperties.end();
     }
 
-    ObjectMap::const_iterator begin() const { return mProperties.begin(); }
-    ObjectMap::const_iterator end() const { return mProperties.end(); }
+    PropertyValueMap::const_iterator begin() const { return mProperties.begin(); }
+    PropertyValueMap::const_iterator end() const { return mProperties.end(); }
 
 private:
-    ObjectMap mProperties;
+    PropertyValueMap mProperties;
 };
 
 } // namespace apl
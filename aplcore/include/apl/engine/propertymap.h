@@ -16,37 +16,242 @@
 #ifndef _APL_PROPERTY_MAP_H
 #define _APL_PROPERTY_MAP_H
 
+#include <bitset>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
 #include "apl/utils/bimap.h"
 #include "apl/primitives/object.h"
 
 namespace apl {
 
+/**
+ * A set of property keys stored as a bitset.  Keys are enumerated values starting at zero;
+ * membership tests and updates are a single bit operation and the keys are iterated in
+ * ascending order.
+ * @tparam T The enumerated type stored.
+ */
+template<class T>
+class PropertyKeySet {
+public:
+    static const size_t CAPACITY = 256;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = T;
+
+        const_iterator(const PropertyKeySet *set, size_t index) : mSet(set), mIndex(index) { advance(); }
+
+        T operator*() const { return static_cast<T>(mIndex); }
+        const_iterator& operator++() { mIndex++; advance(); return *this; }
+        const_iterator operator++(int) { auto result = *this; ++(*this); return result; }
+        bool operator==(const const_iterator& rhs) const { return mIndex == rhs.mIndex; }
+        bool operator!=(const const_iterator& rhs) const { return mIndex != rhs.mIndex; }
+
+    private:
+        // Skip forward to the next key in the set
+        void advance() {
+            while (mIndex < CAPACITY) {
+                auto word = mSet->mWords[mIndex / 64] >> (mIndex % 64);
+                if (word & 1)
+                    return;
+                if (word == 0)
+                    mIndex = (mIndex / 64 + 1) * 64;
+                else
+                    mIndex++;
+            }
+            mIndex = CAPACITY;
+        }
+
+        const PropertyKeySet *mSet;
+        size_t mIndex;
+    };
+
+    /**
+     * @return 1 if the key is in the set, 0 otherwise.
+     */
+    size_t count(T key) const {
+        return (word(key) >> bit(key)) & 1;
+    }
+
+    /**
+     * Add a key to the set.
+     * @return True if the key was not already in the set.
+     */
+    bool emplace(T key) {
+        auto mask = static_cast<uint64_t>(1) << bit(key);
+        auto& w = word(key);
+        if (w & mask)
+            return false;
+        w |= mask;
+        return true;
+    }
+
+    /**
+     * Remove a key from the set.
+     * @return The number of keys removed (0 or 1).
+     */
+    size_t erase(T key) {
+        auto mask = static_cast<uint64_t>(1) << bit(key);
+        auto& w = word(key);
+        if (!(w & mask))
+            return 0;
+        w &= ~mask;
+        return 1;
+    }
+
+    void clear() {
+        for (auto& w : mWords)
+            w = 0;
+    }
+
+    bool empty() const {
+        for (auto w : mWords)
+            if (w)
+                return false;
+        return true;
+    }
+
+    size_t size() const {
+        size_t result = 0;
+        for (auto w : mWords)
+            result += std::bitset<64>(w).count();
+        return result;
+    }
+
+    /**
+     * @return The number of keys in the set that are less than this key.
+     */
+    size_t rank(T key) const {
+        auto index = static_cast<size_t>(key) / 64;
+        size_t result = 0;
+        for (size_t i = 0 ; i < index ; i++)
+            result += std::bitset<64>(mWords[i]).count();
+        auto mask = (static_cast<uint64_t>(1) << bit(key)) - 1;
+        return result + std::bitset<64>(mWords[index] & mask).count();
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, CAPACITY); }
+
+    bool operator==(const PropertyKeySet& rhs) const {
+        for (size_t i = 0 ; i < WORDS ; i++)
+            if (mWords[i] != rhs.mWords[i])
+                return false;
+        return true;
+    }
+
+    bool operator!=(const PropertyKeySet& rhs) const { return !operator==(rhs); }
+
+private:
+    static const size_t WORDS = CAPACITY / 64;
+
+    static size_t bit(T key) { return static_cast<size_t>(key) % 64; }
+
+    uint64_t& word(T key) {
+        assert(static_cast<size_t>(key) < CAPACITY);
+        return mWords[static_cast<size_t>(key) / 64];
+    }
+
+    const uint64_t& word(T key) const {
+        assert(static_cast<size_t>(key) < CAPACITY);
+        return mWords[static_cast<size_t>(key) / 64];
+    }
+
+    uint64_t mWords[WORDS] = {};
+};
+
+template<class T> const size_t PropertyKeySet<T>::CAPACITY;
+template<class T> const size_t PropertyKeySet<T>::WORDS;
+
 /**
  * Store calculated values that can be accessed by either string or integer index.
+ *
+ * The entries are appended to fixed-size chunks that never reallocate, so a reference returned
+ * by get() or by the iterator stays valid when other keys are added later.  A bitset records
+ * which keys are present and a byte per key gives the slot of each entry in key order; the
+ * position of a key in that order is the number of present keys that are smaller than it.
+ * Lookups are a bit test and a population count, and iteration visits the keys in ascending
+ * order.
+ *
  * @tparam T The enumerated type stored.
  * @tparam bimap The bi-directional map.
  */
 template<class T, Bimap<int, std::string>& bimap>
 class PropertyMap {
 public:
+    using value_type = std::pair<T, Object>;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<T, Object>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        const_iterator(const PropertyMap *map, size_t index) : mMap(map), mIndex(index) {}
+
+        reference operator*() const { return mMap->entry(mIndex); }
+        pointer operator->() const { return &mMap->entry(mIndex); }
+        const_iterator& operator++() { mIndex++; return *this; }
+        const_iterator operator++(int) { auto result = *this; ++(*this); return result; }
+        bool operator==(const const_iterator& rhs) const { return mIndex == rhs.mIndex; }
+        bool operator!=(const const_iterator& rhs) const { return mIndex != rhs.mIndex; }
+
+    private:
+        const PropertyMap *mMap;
+        size_t mIndex;
+    };
+
     PropertyMap() {}
 
+    /**
+     * Copying rebuilds the chunks so that each one keeps its full reserved capacity.
+     */
+    PropertyMap(const PropertyMap& other) {
+        for (const auto& m : other)
+            set(m.first, m.second);
+    }
+
+    PropertyMap& operator=(const PropertyMap& other) {
+        if (this != &other) {
+            mVersion++;
+            mKeys.clear();
+            mOrder.clear();
+            mChunks.clear();
+            for (const auto& m : other)
+                set(m.first, m.second);
+        }
+        return *this;
+    }
+
+    PropertyMap(PropertyMap&&) = default;
+    PropertyMap& operator=(PropertyMap&&) = default;
+
     /**
      * @return The number of elements in the property map
      */
-    std::size_t size() const { return mValues.size(); }
+    std::size_t size() const { return mOrder.size(); }
 
     /**
-     * Return object by key lookup.
+     * Return object by key lookup.  The reference remains valid until the map is destroyed or
+     * assigned.
      * @param key The key.
      * @return The value or Object::NULL_OBJECT if it does not exist
      */
     const Object& get(T key) const {
-        auto it = mValues.find(key);
-        if (it != mValues.end())
-            return it->second;
+        if (!mKeys.count(key))
+            return Object::NULL_OBJECT();
 
-        return Object::NULL_OBJECT();
+        return entry(mKeys.rank(key)).second;
     }
 
     /**
@@ -55,11 +260,7 @@ public:
      * @return The value or Object::NULL_OBJECT if it does not exist
      */
     Object get(T key) {
-        auto it = mValues.find(key);
-        if (it != mValues.end())
-            return it->second;
-
-        return Object::NULL_OBJECT();
+        return static_cast<const PropertyMap*>(this)->get(key);
     }
 
     /**
@@ -104,14 +305,34 @@ public:
     }
 
     /**
-     * Store a value in the property map
+     * Store a value in the property map.  Existing entries are updated in place and new entries
+     * never move the existing ones.
      * @param key The key
      * @param value The value
      */
     void set(T key, const Object& value) {
-        mValues[key] = value;
+        mVersion++;
+        auto position = mKeys.rank(key);
+        if (!mKeys.emplace(key)) {
+            mutableEntry(position).second = value;
+            return;
+        }
+
+        auto slot = mOrder.size();
+        if (slot % CHUNK == 0) {
+            mChunks.emplace_back();
+            mChunks.back().reserve(CHUNK);
+        }
+        mChunks.back().emplace_back(key, value);   // Within the reserved capacity: never reallocates
+        mOrder.insert(mOrder.begin() + position, static_cast<uint8_t>(slot));
     }
 
+    /**
+     * @return A counter that changes every time a value is stored.  Used to detect changes
+     *         made since a value derived from the map was cached.
+     */
+    uint32_t version() const { return mVersion; }
+
     const Object& operator[](T key) const {
         return get(key);
     }
@@ -120,13 +341,31 @@ public:
         return get(key);
     }
 
-    typename std::map<T,Object>::const_iterator begin() const { return mValues.begin(); }
-    typename std::map<T,Object>::const_iterator end() const { return mValues.end(); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, mOrder.size()); }
 
 private:
-    std::map<T, Object> mValues;
+    static const size_t CHUNK = 16;
+    static_assert(PropertyKeySet<T>::CAPACITY <= 256, "Slots are stored in a byte");
+
+    const value_type& entry(size_t position) const {
+        auto slot = mOrder[position];
+        return mChunks[slot / CHUNK][slot % CHUNK];
+    }
+
+    value_type& mutableEntry(size_t position) {
+        auto slot = mOrder[position];
+        return mChunks[slot / CHUNK][slot % CHUNK];
+    }
+
+    PropertyKeySet<T> mKeys;
+    std::vector<uint8_t> mOrder;                    // Slot of each entry, in key order
+    std::vector<std::vector<value_type>> mChunks;   // Moving a chunk keeps its elements in place
+    uint32_t mVersion = 0;
 };
 
+template<class T, Bimap<int, std::string>& bimap> const size_t PropertyMap<T, bimap>::CHUNK;
+
 } // namespace apl
 
 #endif //_APL_PROPERTY_MAP_H
@@ -0,0 +1,66 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_RECALCULATE_BATCH_H
+#define _APL_RECALCULATE_BATCH_H
+
+#include <memory>
+
+namespace apl {
+
+class Dependant;
+
+/**
+ * Collects the dependants that must be recalculated after one or more upstream values change and
+ * recalculates each of them once, in rank order, when the outermost batch goes out of scope.
+ *
+ * Batches nest.  A dependant recalculated while committing may change further values; the
+ * dependants downstream of those values join the batch being committed instead of being
+ * recalculated immediately.  This means that a dependant that is reached along several paths
+ * of the dependency graph is usually recalculated only once.
+ *
+ * Typical use is to group several context writes:
+ *
+ *     {
+ *         RecalculateBatch batch;
+ *         context->systemUpdateAndRecalculate("index", index, true);
+ *         context->systemUpdateAndRecalculate("length", length, true);
+ *     }   // Downstream dependants are recalculated here
+ *
+ * Batches are tracked per thread.
+ */
+class RecalculateBatch {
+public:
+    RecalculateBatch();
+    ~RecalculateBatch();
+
+    RecalculateBatch(const RecalculateBatch&) = delete;
+    RecalculateBatch& operator=(const RecalculateBatch&) = delete;
+
+    /**
+     * Schedule a dependant for recalculation.  Scheduling a dependant that has not yet been
+     * recalculated has no effect other than merging the dirty flag.
+     * @param dependant The dependant.
+     * @param useDirtyFlag If true, mark downstream changes as dirty.
+     */
+    void add(const std::shared_ptr<Dependant>& dependant, bool useDirtyFlag);
+
+private:
+    void commit();
+};
+
+} // namespace apl
+
+#endif // _APL_RECALCULATE_BATCH_H
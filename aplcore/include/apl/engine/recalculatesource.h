@@ -16,22 +16,101 @@
 #ifndef _APL_RECALCULATE_SOURCE_H
 #define _APL_RECALCULATE_SOURCE_H
 
-#include <map>
+#include <cstdint>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include "apl/engine/dependant.h"
+#include "apl/engine/recalculatebatch.h"
+#include "apl/utils/atom.h"
 #include "apl/utils/log.h"
 
 namespace apl {
 
+/**
+ * Strip the "/" suffix added to symbol names by the symbol visitor
+ */
+inline Atom
+downstreamName(const Atom& key)
+{
+    auto index = key.str().find('/');
+    return index == std::string::npos ? key : Atom(key.str().substr(0, index));
+}
+
+/**
+ * Storage for the dependants downstream of one source object.  Dependants are grouped into
+ * buckets, one bucket per source key.  Each dependant records its position in every bucket it
+ * belongs to, so removing a dependant is O(1) per source and does not search the registry.
+ *
+ * The registry holds plain pointers to its dependants, which costs less than a weak_ptr for
+ * keys with many subscribers.  The pointers never dangle: a dependant removes itself from all
+ * of its registries through its handles when it is removed from its source or destroyed, and
+ * a registry that is destroyed first disconnects itself from all of its dependants.
+ */
+class DownstreamRegistry {
+public:
+    DownstreamRegistry() = default;
+    ~DownstreamRegistry();
+
+    DownstreamRegistry(const DownstreamRegistry&) = delete;
+    DownstreamRegistry& operator=(const DownstreamRegistry&) = delete;
+
+protected:
+    /**
+     * Add a dependant to a bucket.
+     * @return False if the dependant is already in the bucket.
+     */
+    bool add(uint32_t bucket, const std::shared_ptr<Dependant>& dependant);
+
+    /**
+     * Add every dependant in a bucket to a recalculation batch.
+     */
+    void schedule(uint32_t bucket, RecalculateBatch& batch, bool useDirtyFlag) const;
+
+    /**
+     * Raise the rank of every dependant in a bucket to at least the given rank.
+     */
+    void raiseRank(uint32_t bucket, unsigned int rank) const;
+
+    /**
+     * @return A new, empty bucket.
+     */
+    uint32_t createBucket();
+
+    size_t bucketSize(uint32_t bucket) const { return mBuckets[bucket].size(); }
+    size_t size() const { return mSize; }
+
+private:
+    friend class Dependant;
+
+    struct Entry {
+        Dependant *dependant;
+        uint32_t handle;    // The index of the matching handle in the dependant
+    };
+
+    void remove(uint32_t bucket, uint32_t position);
+
+    std::vector<std::vector<Entry>> mBuckets;
+    size_t mSize = 0;
+};
+
 /**
  * A mixin class for objects where changing an element of this object will trigger recalculation of properties
  * on downstream objects.
- * @tparam T The key type used to distinguish the various elements of this object.
+ * @tparam T The key type used to distinguish the various elements of this object.  It must be hashable.
  */
 template<class T>
-class RecalculateSource {
+class RecalculateSource : private DownstreamRegistry {
 public:
+    RecalculateSource() = default;
+
+    /**
+     * A copy starts without downstream dependants; they remain connected to the original.
+     */
+    RecalculateSource(const RecalculateSource&) : DownstreamRegistry() {}
+    RecalculateSource& operator=(const RecalculateSource&) = delete;
+
     /**
      * Add a dependant object that is downstream of this object.
      * @param key The key of the local element.  When this element is changed, the downstream dependant should recalculate.
@@ -39,64 +118,40 @@ public:
      */
     void addDownstream(T key, const std::shared_ptr<Dependant>& dependant) {
         // For now, we strip off the "/" section of the keys
-        auto name = key.substr(0, key.find("/", 0));
-
-        // Don't add this pair if it already exists
-        // While we're searching, we check for weak pointers
-        auto dependants = mDownstream.equal_range(key);
-        auto it = dependants.first;
-        while (it != dependants.second) {
-            auto ptr = it->second.lock();
-            if (ptr) {
-                if (ptr == dependant) {
-                    LOG(LogLevel::WARN) << "Attempted to add duplicate pair " << key;
-                    return;    // This pair already exists
-                }
-                it++;
-            } else {
-                LOG(LogLevel::WARN) << "Unexpected released weak pointer";
-                it = mDownstream.erase(it);  // Throw it away
-            }
-        }
-
-        mDownstream.emplace(name, dependant);
-    }
+        auto name = downstreamName(key);
 
-    /**
-     * Remove this downstream dependant object.  Note that we also clear out
-     * any released weak_ptrs at the same time.
-     * @param dependant The object to remove
-     */
-    void removeDownstream(const std::shared_ptr<Dependant>& dependant) {
-        auto it = mDownstream.begin();
-        while (it != mDownstream.end()) {
-            // TODO: Possible optimization by using owner_before comparison
-            if (it->second.expired() || it->second.lock() == dependant)
-                it = mDownstream.erase(it);
-            else
-                it++;
-        }
+        auto it = mKeys.find(name);
+        auto bucket = it != mKeys.end() ? it->second : mKeys.emplace(name, createBucket()).first->second;
+        if (!add(bucket, dependant))
+            LOG(LogLevel::WARN) << "Attempted to add duplicate pair " << key;
     }
 
     /**
      * The "key" local element has changed.  Recalculate all downstream objects that depend on key.
+     * If a RecalculateBatch is active the downstream objects are added to it and recalculated
+     * when the batch commits.
      * @param key The key that has changed.
      * @param useDirtyFlag If true, mark downstream changes with the dirty flag
      */
     void recalculateDownstream(T key, bool useDirtyFlag) {
-        auto dependants = mDownstream.equal_range(key);
-        auto it = dependants.first;
-        while (it != dependants.second) {
-            auto ptr = it->second.lock();
-            if (ptr) {
-                ptr->recalculate(useDirtyFlag);
-                it++;
-            }
-            else {
-                LOG(LogLevel::WARN) << "Unexpected released weak pointer";
-                it = mDownstream.erase(it);
-            }
-        }
+        auto it = mKeys.find(key);
+        if (it == mKeys.end())
+            return;
+
+        RecalculateBatch batch;
+        schedule(it->second, batch, useDirtyFlag);
+    }
+
+    /**
+     * A new upstream dependant calculates the "key" local element.  Raise the rank of the downstream
+     * objects that depend on key so they still recalculate after it.
+     * @param key The key that has a new upstream dependant.
+     * @param rank The lowest rank a downstream object of key may have.
+     */
+    void raiseDownstreamRank(T key, unsigned int rank) const {
+        auto it = mKeys.find(downstreamName(key));
+        if (it != mKeys.end())
+            raiseRank(it->second, rank);
     }
 
     /**
@@ -104,19 +159,20 @@ public:
      * @param key The key
      * @return The number of downstream dependants.
      */
-    size_t countDownstream(T key) {
-        return mDownstream.count(key);
+    size_t countDownstream(T key) const {
+        auto it = mKeys.find(key);
+        return it != mKeys.end() ? bucketSize(it->second) : 0;
     }
 
     /**
      * @return The total number of downstream dependants connected to this source
      */
-    size_t countDownstream() {
-        return mDownstream.size();
+    size_t countDownstream() const {
+        return size();
     }
 
 private:
-    std::multimap<T, std::weak_ptr<Dependant>> mDownstream;
+    std::unordered_map<T, uint32_t> mKeys;
 };
 
 } // namespace apl
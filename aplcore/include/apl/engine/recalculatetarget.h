@@ -16,6 +16,7 @@
 #ifndef _APL_RECALCULATE_TARGET_H
 #define _APL_RECALCULATE_TARGET_H
 
+#include <algorithm>
 #include <map>
 #include <memory>
 
@@ -72,6 +73,20 @@ public:
         return mUpstream.count(key);
     }
 
+    /**
+     * Return the lowest rank a dependant reading this key may have.  That is one more than the
+     * rank of any upstream dependant that calculates the key.
+     * @param key The key
+     * @return The rank.
+     */
+    unsigned int downstreamRank(T key) const {
+        unsigned int result = 0;
+        auto range = mUpstream.equal_range(key);
+        for (auto it = range.first ; it != range.second ; it++)
+            result = std::max(result, it->second->rank() + 1);
+        return result;
+    }
+
     /**
      * @return The total number of upstream dependants connected to this target.
      */
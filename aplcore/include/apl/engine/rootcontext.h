@@ -32,6 +32,7 @@ namespace apl {
 class Metrics;
 class RootConfig;
 class RootContextData;
+class TextMeasureCache;
 class TimeManager;
 struct PointerEvent;
 
@@ -335,6 +336,11 @@ public:
      */
     const TextMeasurementPtr& measure() const;
 
+    /**
+     * @return The text measurement cache of this document, including its hit and miss counters.
+     */
+    const TextMeasureCache& textMeasureCache() const;
+
     /**
      * Find a component somewhere in the DOM with the given id or uniqueId.
      * @param id The id or uniqueID to search for.
@@ -350,8 +356,9 @@ private:
                                        const APLVersion& compatibilityVersion);
     bool verifyTypeField(const std::vector<std::shared_ptr<Package>>& ordered, bool enforce);
     ObjectMapPtr createDocumentEventProperties(const std::string& handler) const;
-    void scheduleTickHandler(const Object& handler, double delay);
     void processTickHandlers();
+    void updateTimeSymbols();
+    void updateTimeSymbol(const char *name, apl_time_t value);
 
 private:
     ContentPtr mContent;
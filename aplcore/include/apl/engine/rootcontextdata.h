@@ -20,9 +20,11 @@
 #include <string>
 #include <queue>
 
+#include "apl/component/textmeasurecache.h"
 #include "apl/content/rootconfig.h"
 #include "apl/content/settings.h"
 #include "apl/content/content.h"
+#include "apl/engine/componenttemplate.h"
 #include "apl/engine/event.h"
 #include "apl/extension/extensionmanager.h"
 #include "apl/engine/focusmanager.h"
@@ -30,12 +32,15 @@
 #include "apl/engine/jsonresource.h"
 #include "apl/engine/keyboardmanager.h"
 #include "apl/engine/styles.h"
+#include "apl/engine/tickscheduler.h"
 #include "apl/livedata/livedatamanager.h"
 #include "apl/time/sequencer.h"
 #include "apl/touch/pointermanager.h"
 
 namespace apl {
 
+class Arena;
+
 class RootContextData {
     friend class RootContext;
 
@@ -74,6 +79,7 @@ public:
     KeyboardManager& keyboardManager() const { return *mKeyboardManager; }
     LiveDataManager& dataManager() const { return *mDataManager; }
     ExtensionManager& extensionManager() const { return *mExtensionManager; }
+    TickScheduler& tickScheduler() const { return *mTickScheduler; }
 
     const YGConfigRef& ygconfig() const { return mYGConfigRef; }
     ComponentPtr top() const { return mTop; }
@@ -82,13 +88,30 @@ public:
     const std::map<std::string, JsonResource>& graphics() const { return mGraphics; }
     const SessionPtr& session() const { return mSession; }
 
+    /**
+     * @param name The name of a layout
+     * @return The compiled template for the layout or nullptr if the layout does not exist.
+     */
+    LayoutTemplatePtr layoutTemplate(const std::string& name);
+
     /**
      * @return The installed text measurement for this context.
      */
     const TextMeasurementPtr& measure() const { return mTextMeasurement; }
 
+    /**
+     * @return The text measurement cache of this document.
+     */
+    TextMeasureCache& textMeasureCache() const { return *mTextMeasureCache; }
+
     const RootConfig& rootConfig() const { return mConfig; }
 
+    /**
+     * @return The arena that hosts the contexts, components and dependants of this document.
+     *         Null if arena allocation is not enabled.
+     */
+    const std::shared_ptr<Arena>& arena() const { return mArena; }
+
     /**
      * @return True if the screen lock is currently being held by a command.
      */
@@ -120,6 +143,7 @@ private:
     std::map<std::string, JsonResource> mLayouts;
     std::map<std::string, JsonResource> mCommands;
     std::map<std::string, JsonResource> mGraphics;
+    std::map<std::string, LayoutTemplatePtr> mLayoutTemplates;
     std::shared_ptr<Styles> mStyles;
     std::unique_ptr<Sequencer> mSequencer;
     std::unique_ptr<FocusManager> mFocusManager;
@@ -128,13 +152,16 @@ private:
     std::unique_ptr<KeyboardManager> mKeyboardManager;
     std::unique_ptr<LiveDataManager> mDataManager;
     std::unique_ptr<ExtensionManager> mExtensionManager;
+    std::unique_ptr<TickScheduler> mTickScheduler;
     YGConfigRef mYGConfigRef;
     TextMeasurementPtr mTextMeasurement;
+    std::unique_ptr<TextMeasureCache> mTextMeasureCache;
     CoreComponentPtr mTop;         // The top component
     const RootConfig mConfig;
     int mScreenLockCount;
     SettingsPtr mSettings;
     SessionPtr mSession;
+    std::shared_ptr<Arena> mArena;
 };
 
 
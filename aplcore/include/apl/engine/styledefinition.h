@@ -24,11 +24,57 @@
 
 namespace apl {
 
+/**
+ * The compiled "value" blocks of a single style.  "when" clauses and property values are parsed
+ * once, property names are interned, and values that do not depend on the data-binding context
+ * are stored directly.  Compiled blocks do not depend on the document, so they may be shared by
+ * every document that loads the same package.
+ */
+class StyleBlocks {
+public:
+    /**
+     * A "when" clause or property value.  Constant values are stored directly; anything else
+     * is evaluated when a StyleInstance is constructed.
+     */
+    struct CompiledValue {
+        explicit CompiledValue(const rapidjson::Value& value);
+        Object eval(const Context& context) const;
+
+        Object value;
+        bool constant = true;
+    };
+
+    struct CompiledProperty {
+        Atom name;
+        CompiledValue value;
+    };
+
+    struct CompiledBlock {
+        size_t index;                          // Position of the block in the JSON array
+        std::unique_ptr<CompiledValue> when;   // Null if the block always applies
+        std::vector<CompiledProperty> properties;
+    };
+
+    /**
+     * Compile the blocks of a style.
+     * @param value The JSON object that defines the style.
+     */
+    explicit StyleBlocks(const rapidjson::Value& value);
+
+    /**
+     * @return The ordered list of blocks that may contribute properties.
+     */
+    const std::vector<CompiledBlock>& blocks() const { return mBlocks; }
+
+private:
+    std::vector<CompiledBlock> mBlocks;
+};
+
 /**
  * The JSON data and definitions of a single style.  A single style is constructed from a number
- * of parents and a number of conditionally-selected JSON blocks.  We stash that information in
- * the StyleDefinition and do a lazy-evaluation construction of the properties for this style
- * based on the particular state settings.
+ * of parents and a number of conditionally-selected blocks.  The blocks are compiled when the
+ * style is loaded; the properties for a particular set of state settings are then constructed
+ * lazily from the compiled blocks.
  *
  * This class is internal to Styles.
  */
@@ -38,8 +84,10 @@ public:
      * Create a StyleDefinition.
      * @param value The JSON object that defines the style.
      * @param styleProvenance The JSON path to the style definition
+     * @param blocks The compiled blocks of the style.  If null, the blocks are compiled from value.
      */
-    StyleDefinition(const rapidjson::Value& value, const Path& styleProvenance);
+    StyleDefinition(const rapidjson::Value& value, const Path& styleProvenance,
+                    const StyleBlocksPtr& blocks = nullptr);
 
     /**
      * This style extends another style.  Add that style to the end of the list of styles this
@@ -65,7 +113,7 @@ private:
     const Path mStyleProvenance;
     const Path mBlockBaseProvenance;
     std::vector<StyleDefinitionPtr > mExtends;   // Named styles we extend
-    std::vector<const rapidjson::Value *> mBlocks;   // Ordered list of blocks to evaluate
+    StyleBlocksPtr mBlocks;                       // Ordered list of blocks to evaluate
     std::map<State, StyleInstancePtr> mCache;          // State cache of results
 };
 
@@ -17,8 +17,12 @@
 #define _APL_STYLED_H
 
 #include <map>
+#include <memory>
+#include <vector>
 
+#include "apl/common.h"
 #include "apl/primitives/object.h"
+#include "apl/utils/atom.h"
 
 namespace apl {
 
@@ -46,9 +50,16 @@ public:
      * @param key The name of the style property
      * @return A constant iterator to the named style property or end()
      */
-    std::map<std::string, Object>::const_iterator find(const std::string& key) const { return mValue.find(key); }
-    
-    std::map<std::string, Object>::const_iterator find(const std::vector<std::string>& keys) const {
+    std::map<Atom, Object>::const_iterator find(const Atom& key) const { return mValue.find(key); }
+
+    // Look up a name without interning it
+    std::map<Atom, Object>::const_iterator find(const std::string& key) const {
+        auto atom = Atom::find(key);
+        return atom.empty() ? mValue.end() : mValue.find(atom);
+    }
+    std::map<Atom, Object>::const_iterator find(const char *key) const { return find(std::string(key)); }
+
+    std::map<Atom, Object>::const_iterator find(const std::vector<Atom>& keys) const {
         for (const auto& key : keys) {
             auto it = mValue.find(key);
             if (it != mValue.end())
@@ -60,26 +71,26 @@ public:
     /**
      * @return An iterator to the begining of the style.
      */
-    std::map<std::string, Object>::const_iterator begin() const { return mValue.begin(); }
+    std::map<Atom, Object>::const_iterator begin() const { return mValue.begin(); }
 
     /**
      * @return An iterator to the end of the style
      */
-    std::map<std::string, Object>::const_iterator end() const { return mValue.end(); }
+    std::map<Atom, Object>::const_iterator end() const { return mValue.end(); }
 
     /**
      * Lookup up a style property by name.
      * @param key The name of the style property
      * @return The value of the style property or the null object if it is not found
      */
-    Object at(const std::string& key) const;
+    Object at(const Atom& key) const;
 
     /**
      * Lookup the provenance path of a style property by name.
      * @param key The name of the style property
      * @return The path to the JSON content where this style property was defined.
      */
-    std::string provenance(const std::string& key) const;
+    std::string provenance(const Atom& key) const;
 
     /**
      * @return The path to the JSON content where this style was defined.
@@ -91,14 +102,27 @@ public:
      */
     size_t size() const { return mValue.size(); }
 
+    /**
+     * List the style properties that differ between another StyleInstance and this one.  A
+     * property differs if it is defined in only one of the two styles or if the values are not
+     * equal.  The result is computed once for each pair of instances, so switching a component
+     * back and forth between two states only touches the properties that actually change.  Results
+     * for instances that have since been released are dropped when a new pair is computed.
+     * @param previous The StyleInstance previously applied to the component.
+     * @return The names of the properties that have changed, in sorted order.
+     */
+    const std::vector<Atom>& changedFrom(const StyleInstancePtr& previous) const;
+
     friend class StyleDefinition;
 
 protected:
-    void put(const std::string& key, const Object& value, const std::string& provenance);
+    void put(const Atom& key, const Object& value, const std::string& provenance);
 
 private:
-    std::map<std::string, Object> mValue;
-    std::map<std::string, std::string> mProvenance;
+    std::map<Atom, Object> mValue;
+    std::map<Atom, std::string> mProvenance;
+    mutable std::map<std::weak_ptr<StyleInstance>, std::vector<Atom>,
+                     std::owner_less<std::weak_ptr<StyleInstance>>> mChanges;
     const std::string mStyleProvenance;
 };
 
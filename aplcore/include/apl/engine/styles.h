@@ -74,8 +74,10 @@ public:
      * @param session The logging session
      * @param json The JSON object containing one or more styles.
      * @param provenance The JSON path to the JSON object.
+     * @param blocks Optional precompiled blocks of the styles, keyed by style name.
      */
-    void addStyleDefinitions(const SessionPtr& session, const rapidjson::Value *json, const Path& provenance);
+    void addStyleDefinitions(const SessionPtr& session, const rapidjson::Value *json, const Path& provenance,
+                             const std::map<std::string, StyleBlocksPtr> *blocks = nullptr);
 
     /**
      * @return The number of styles
@@ -0,0 +1,109 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_TICK_SCHEDULER_H
+#define _APL_TICK_SCHEDULER_H
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "apl/common.h"
+#include "apl/primitives/object.h"
+
+namespace apl {
+
+class TimeManager;
+
+/**
+ * Runs the "handleTick" handlers of the document and its components.
+ *
+ * Handlers with the same period share a single bucket and a single timeout.  Every child of a
+ * Sequence with the same "minimumDelay" fires from one timer, so a document with hundreds of
+ * ticking components only arms one timeout per distinct period.  A handler added to an existing
+ * bucket first fires on the bucket's next due time that is at least one period away.  Handlers
+ * in a bucket fire in the order they were added.
+ *
+ * The "when" and "commands" properties of each handler are prepared once when it is added.
+ * Handlers that belong to a component outside of the ensured range of a Sequence or Pager are
+ * suspended: they stay scheduled but do not run their commands until the component is laid out.
+ */
+class TickScheduler {
+public:
+    explicit TickScheduler(const std::shared_ptr<TimeManager>& timeManager);
+    ~TickScheduler();
+
+    /**
+     * Schedule a component tick handler.
+     * @param component The component that owns the handler.
+     * @param handler The handler definition.
+     */
+    void add(const CoreComponentPtr& component, const Object& handler);
+
+    /**
+     * Schedule a document-level tick handler.
+     * @param root The root context.
+     * @param handler The handler definition.
+     */
+    void add(const RootContextPtr& root, const Object& handler);
+
+    /**
+     * Cancel every scheduled handler.
+     */
+    void terminate();
+
+    /**
+     * @return The number of scheduled handlers.
+     */
+    size_t size() const;
+
+    /**
+     * @return The number of timeouts armed for the scheduled handlers.
+     */
+    size_t buckets() const { return mBuckets.size(); }
+
+private:
+    struct Handler {
+        std::weak_ptr<CoreComponent> component;
+        std::weak_ptr<RootContext> root;
+        apl_duration_t period;
+        apl_time_t earliest;                        // The handler does not fire before this time
+        Object when;                                // Constant value or data-bound expression
+        bool whenBound;                             // True if "when" must be evaluated on each tick
+        Object commands;                            // Array of commands or a data-bound expression
+        bool commandsBound;                         // True if the commands must be evaluated on each tick
+    };
+
+    using HandlerPtr = std::shared_ptr<Handler>;
+
+    struct Bucket {
+        timeout_id timeout;                         // Zero while the bucket is firing
+        apl_time_t due;
+        std::vector<HandlerPtr> handlers;
+    };
+
+    HandlerPtr prepare(const Context& context, const Object& handler);
+    void schedule(const HandlerPtr& handler);
+    void fire(apl_duration_t period);
+    bool run(const Handler& handler);
+
+private:
+    std::shared_ptr<TimeManager> mTimeManager;
+    std::map<apl_duration_t, Bucket> mBuckets;   // Keyed by the period of the handlers
+};
+
+} // namespace apl
+
+#endif // _APL_TICK_SCHEDULER_H
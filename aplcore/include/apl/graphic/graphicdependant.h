@@ -39,7 +39,8 @@ public:
                        GraphicPropertyKey downstreamKey,
                        const Object& equation,
                        const ContextPtr& bindingContext,
-                       BindingFunction bindingFunction);
+                       BindingFunction bindingFunction,
+                       TimeGranularity granularity = kTimeGranularityFrame);
 
     GraphicDependant(const GraphicElementPtr& downstreamGraphicElement,
                      GraphicPropertyKey downstreamKey,
@@ -39,6 +39,10 @@ using GraphicDirtyChildren = std::set<GraphicElementPtr>;
 
 using GraphicPropertyMap = PropertyMap<GraphicPropertyKey, sGraphicPropertyBimap>;
 
+// kGraphicPropertyWidthOriginal is the last GraphicPropertyKey.  Every key must fit in the map.
+static_assert(kGraphicPropertyWidthOriginal < PropertyKeySet<GraphicPropertyKey>::CAPACITY,
+              "GraphicPropertyKey does not fit in a GraphicPropertyMap");
+
 /**
  * A single element of a graphic.  This may be a group of other elements, a path element,
  * or the overall container. This class is instantiated internally by the Graphic class.
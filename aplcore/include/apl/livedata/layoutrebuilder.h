@@ -17,6 +17,7 @@
 #define _APL_LAYOUT_REBUILDER_H
 
 #include "apl/common.h"
+#include "apl/engine/componenttemplate.h"
 #include "apl/utils/path.h"
 
 namespace apl {
@@ -44,7 +45,7 @@ public:
     static std::shared_ptr<LayoutRebuilder> create(const ContextPtr& context,
                                                    const CoreComponentPtr& layout,
                                                    const std::shared_ptr<LiveArrayObject>& array,
-                                                   const std::vector<Object>& items,
+                                                   const ComponentTemplateListPtr& items,
                                                    const Path& childPath,
                                                    bool numbered);
 
@@ -54,7 +55,7 @@ public:
     LayoutRebuilder(const ContextPtr& context,
                     const CoreComponentPtr& layout,
                     const std::shared_ptr<LiveArrayObject>& array,
-                    const std::vector<Object>& items,
+                    const ComponentTemplateListPtr& items,
                     const Path& childPath,
                     bool numbered);
 
@@ -104,10 +105,10 @@ public:
     }
 
 private:
-    ContextPtr mContext;
+    ContextPtr mContext;  // Parent context of the children; holds the shared "length"
     std::weak_ptr<CoreComponent> mLayout;
     std::weak_ptr<LiveArrayObject> mArray;
-    const std::vector<Object> mItems;
+    const ComponentTemplateListPtr mItems;
     Path mChildPath;
     bool mNumbered;
 
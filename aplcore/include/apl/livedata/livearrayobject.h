@@ -32,8 +32,10 @@ namespace apl {
  *
  * To observe when a LiveArrayObject is flushed, register a "flush" callback.
  *
- * TODO: All internal changes are stored in a single array.  It may be more efficient to collapse
- *       these into three vectors: "removed", "updated", and "inserted".
+ * The accumulated changes are not stored as a list.  Each change is folded into a sorted list of
+ * segments that covers the current array and maps each range of current indices back to the
+ * indices before the first change (or marks the range as newly inserted).  Adjacent segments are
+ * merged, so the list stays short and translating an index is a binary search.
  */
 class LiveArrayObject : public LiveDataObject {
 public:
@@ -74,7 +76,7 @@ public:
      */
     void flush() override {
         LiveDataObject::flush();
-        mChanges.clear();
+        resetChanges();
     }
 
     /**
@@ -85,12 +87,33 @@ public:
      */
     std::pair<int, bool> newToOld(ObjectArray::size_type index);
 
+    /**
+     * @return The lowest index touched by the stored changes.  Items before this index have not moved
+     *         or changed since the last flush.
+     */
+    ObjectArray::size_type firstChanged() const;
+
 private:
+    /**
+     * A range of current indices [start, start+count) that maps to old indices starting at "old".
+     * Inserted ranges have an old index of -1.
+     */
+    struct Segment {
+        size_type start;
+        size_type count;
+        int old;
+        bool changed;
+    };
+
     void handleArrayMessage(const LiveArrayChange& change);
+    void resetChanges();
+    size_t split(size_type position);
+    void coalesce(size_t first, size_t last);
+    void shift(size_t first, size_type count, bool increase);
 
 private:
     LiveArrayPtr mLiveArray;
-    std::vector<LiveArrayChange> mChanges;
+    std::vector<Segment> mSegments;
 };
 
 } // namespace apl
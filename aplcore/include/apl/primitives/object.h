@@ -96,8 +96,10 @@ using SharedVectorPtr = ObjectArrayPtr;
  * maps (for context and for JSONObject) and arrays (vectors or JSONArray).
  *
  * To avoid dynamic casting, the base object has methods for manipulating all of these
- * types.  The types that require additional storage put a shared_ptr in a single data
- * property.
+ * types.  Numbers, booleans, dimensions, colors, strings, rectangles, radii, and 2D
+ * transformations are stored inline.  The types that require additional storage put a
+ * shared_ptr in a single data property.  The inline values and the data property share
+ * storage, so an Object is no larger than a std::string and a type field.
  *
  * Note that certain types stored in Objects are treated as immutable and certain types
  * are mutable.  The immutable types are:
@@ -359,16 +361,27 @@ public:
     template<typename T> const T& as() const;
 
 private:
-    // In the future we should use a union, but that precludes common std library use
-    // If we can bump to C++17, we can get std::variant
-    // For now, we'll run fast and dirty
+    void initialize();
+    void construct(const Object& other);
+    void construct(Object&& other);
+    void destroy();
 
+    // The active member of the union is selected by the type
     ObjectType mType;
-    double mValue = 0;
-    std::string mString;
-    std::shared_ptr<ObjectData> mData;
+    union {
+        double mValue;
+        std::string mString;
+        std::shared_ptr<ObjectData> mData;
+        Rect mRect;
+        Radii mRadii;
+        Transform2D mTransform2D;
+    };
 };
 
+// Direct access to the stored value.  The object must hold the requested type.
+template<> const Rect& Object::as<Rect>() const;
+template<> const Radii& Object::as<Radii>() const;
+template<> const Transform2D& Object::as<Transform2D>() const;
 
 }  // namespace apl
 
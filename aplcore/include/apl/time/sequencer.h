@@ -70,6 +70,14 @@ public:
      */
     ActionPtr executeOnSequencer(const CommandPtr& commandPtr, const std::string& sequencerName);
 
+    /**
+     * Execute a command in normal mode outside of any sequencer.  The command runs alongside
+     * other commands; it does not terminate them and they do not terminate it.
+     *
+     * @param commandPtr The command to execute
+     */
+    void executeParallel(const CommandPtr& commandPtr);
+
     /**
      * Terminate and clear out the sequencer.  After calling this, no more commands will be accepted.
      */
@@ -96,6 +104,7 @@ public:
 
 private:
     void executeFast(const CommandPtr& commandPtr);
+    void holdOneShot(const ActionPtr& ptr);
 
     bool mTerminated;
     const std::shared_ptr<TimeManager> mTimeManager;
@@ -0,0 +1,139 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_WHEEL_TIME_MANAGER_H
+#define _APL_WHEEL_TIME_MANAGER_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "apl/time/timemanager.h"
+
+namespace apl {
+
+/**
+ * A TimeManager built on a hierarchical timing wheel.  Setting and clearing a timeout are O(1);
+ * the CoreTimeManager heap needs a linear search and a heap rebuild to clear a timeout.
+ *
+ * Timeouts are bucketed by whole milliseconds into six levels of 64 slots.  Level 0 holds the
+ * timeouts due in the current 64 ms block; each higher level covers a range 64 times larger.
+ * Advancing the clock finds the next occupied slot with a bit scan and moves the timeouts in
+ * that slot down a level until they reach level 0, where they are transferred to a small heap
+ * ordered by exact end time.  Timeouts further out than the top level (about 795 days) wait in
+ * an overflow list.
+ *
+ * Timeouts fire in order of end time; timeouts with the same end time fire in the order they
+ * were set.  Running animators are kept in a separate list so that updating them does not
+ * visit the pending timeouts.
+ *
+ * To use this instead of the default CoreTimeManager:
+ *
+ *     config.timeManager(std::make_shared<WheelTimeManager>(0));
+ */
+class WheelTimeManager : public TimeManager {
+public:
+    explicit WheelTimeManager(apl_time_t time);
+    ~WheelTimeManager() override = default;
+
+    /****** Methods from Timers *******/
+
+    timeout_id setTimeout(Runnable func, apl_duration_t delay) override;
+    timeout_id setAnimator(Animator animator, apl_duration_t duration) override;
+    bool clearTimeout(timeout_id id) override;
+
+    /****** Methods from TimeManager *******/
+
+    int size() const override { return mIndex.size(); }
+    void updateTime(apl_time_t updatedTime) override;
+    apl_time_t nextTimeout() override;
+    apl_time_t currentTime() const override { return mTime; }
+    void runPending() override;
+    void terminate() override;
+
+private:
+    static const int LEVEL_BITS = 6;
+    static const int SLOTS = 1 << LEVEL_BITS;
+    static const int LEVELS = 6;
+    static const uint32_t NONE = UINT32_MAX;
+
+    // Where an entry is stored
+    static const int8_t kReady = -1;
+    static const int8_t kOverflow = LEVELS;
+    static const int8_t kNever = LEVELS + 1;   // Infinite animators
+    static const int8_t kFree = -2;
+
+    struct Entry {
+        Runnable runnable;
+        Animator animator;
+        apl_time_t startTime;
+        apl_time_t endTime;
+        timeout_id id;
+        int64_t tick;           // The millisecond in which the entry fires
+        int8_t level;           // Wheel level, kReady, kOverflow, kNever or kFree
+        uint8_t slot;
+        bool cancelled;         // Set when cleared while waiting in the ready heap
+        uint32_t prev, next;    // Doubly-linked list of a wheel slot or the overflow list
+        uint32_t prevAnimator, nextAnimator;
+    };
+
+    struct List {
+        uint32_t head = NONE;
+        uint32_t tail = NONE;
+    };
+
+    struct Level {
+        uint64_t occupied = 0;
+        List slots[SLOTS];
+    };
+
+    timeout_id add(Runnable runnable, Animator animator, apl_duration_t duration);
+    uint32_t allocate();
+    void release(uint32_t index);
+
+    void schedule(uint32_t index);
+    void link(List& list, uint32_t index);
+    void unlink(List& list, uint32_t index);
+    void unschedule(uint32_t index);
+
+    bool nextSlot(int& level, int& slot, int64_t& deadline) const;
+    void advance(apl_time_t target);
+    void expireSlot(int level, int slot, int64_t deadline);
+    void fire(uint32_t index);
+
+    bool readyBefore(uint32_t a, uint32_t b) const;
+    void pushReady(uint32_t index);
+    uint32_t popReady();
+    void pruneReady();
+
+private:
+    apl_time_t mTime;
+    timeout_id mNextId;
+    int64_t mElapsed;   // Every wheel slot before this millisecond has been expired
+
+    std::vector<Entry> mEntries;
+    std::vector<uint32_t> mFreeEntries;
+    std::unordered_map<timeout_id, uint32_t> mIndex;
+
+    Level mLevels[LEVELS];
+    List mOverflow;
+    List mAnimators;
+    int mAnimatorCount;
+    std::vector<uint32_t> mReady;   // Min-heap ordered by end time and then id
+};
+
+} // namespace apl
+
+#endif // _APL_WHEEL_TIME_MANAGER_H
@@ -0,0 +1,143 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_ARENA_H
+#define _APL_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace apl {
+
+/**
+ * A pool of small blocks carved out of large chunks.  Blocks are rounded up to a size class
+ * and released blocks are kept on a free list for that class, so allocating and releasing
+ * the many small objects of a document does not go through the global heap.  The chunks are
+ * returned to the heap together when the arena is destroyed.
+ *
+ * Requests larger than the largest size class are passed through to the global heap.
+ *
+ * An arena is not thread-safe.  Each document owns its own arena and all of the objects
+ * allocated from it must be created and released on the thread that runs the document.
+ */
+class Arena {
+public:
+    static const size_t ALIGNMENT = 16;
+    static const size_t MAX_BLOCK_SIZE = 2048;
+    static const size_t CHUNK_SIZE = 64 * 1024;
+
+    Arena();
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * Allocate a block of memory.
+     * @param size The number of bytes required.
+     * @return The block.  It is aligned to ALIGNMENT bytes.
+     */
+    void *allocate(size_t size);
+
+    /**
+     * Return a block of memory to the arena.
+     * @param ptr The block.
+     * @param size The size that was passed to allocate().
+     */
+    void deallocate(void *ptr, size_t size);
+
+    /**
+     * @return The number of blocks that have been allocated and not yet released.
+     */
+    size_t liveBlocks() const { return mLiveBlocks; }
+
+    /**
+     * @return The number of bytes reserved from the global heap for chunks.
+     */
+    size_t reservedBytes() const { return mChunks.size() * CHUNK_SIZE; }
+
+private:
+    struct FreeBlock { FreeBlock *next; };
+
+    static size_t sizeClass(size_t size) { return (size + ALIGNMENT - 1) / ALIGNMENT; }
+
+    void *carve(size_t blockSize);
+
+    std::vector<FreeBlock*> mFreeLists;
+    std::vector<void*> mChunks;
+    char *mCursor = nullptr;
+    char *mEnd = nullptr;
+    size_t mLiveBlocks = 0;
+};
+
+/**
+ * A standard allocator that draws from an Arena.  The allocator holds a reference to the arena,
+ * so an object created with std::allocate_shared keeps the arena alive until the object and
+ * its control block have been released.
+ */
+template<class T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(const std::shared_ptr<Arena>& arena) : mArena(arena) {}
+
+    template<class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : mArena(other.arena()) {}
+
+    T *allocate(size_t n) {
+        return static_cast<T*>(mArena->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T *ptr, size_t n) {
+        mArena->deallocate(ptr, n * sizeof(T));
+    }
+
+    const std::shared_ptr<Arena>& arena() const { return mArena; }
+
+    template<class U>
+    struct rebind { using other = ArenaAllocator<U>; };
+
+    template<class U>
+    bool operator==(const ArenaAllocator<U>& rhs) const { return mArena == rhs.arena(); }
+
+    template<class U>
+    bool operator!=(const ArenaAllocator<U>& rhs) const { return mArena != rhs.arena(); }
+
+private:
+    std::shared_ptr<Arena> mArena;
+};
+
+/**
+ * Create a shared object in an arena.  When no arena is supplied this is std::make_shared.
+ * @param arena The arena.  May be null.
+ * @param args The constructor arguments.
+ * @return The object.
+ */
+template<class T, class... Args>
+std::shared_ptr<T>
+allocateShared(const std::shared_ptr<Arena>& arena, Args&&... args)
+{
+    if (arena)
+        return std::allocate_shared<T>(ArenaAllocator<T>(arena), std::forward<Args>(args)...);
+
+    return std::make_shared<T>(std::forward<Args>(args)...);
+}
+
+} // namespace apl
+
+#endif // _APL_ARENA_H
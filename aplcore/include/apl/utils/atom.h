@@ -0,0 +1,133 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_ATOM_H
+#define _APL_ATOM_H
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "apl/utils/streamer.h"
+
+namespace apl {
+
+/**
+ * An interned string.  Each distinct string value is stored once in a process-wide table and
+ * an Atom is a pointer to that entry, so copying an Atom never allocates and two Atoms are
+ * equal only if they point to the same entry.
+ *
+ * Atoms are used for names that are repeated many times across a document: context symbols,
+ * property names and style keys.  Atoms sort in the same order as their strings, so they may
+ * replace std::string keys in ordered containers without changing iteration order.
+ *
+ * The table owns the interned strings and releases them at process exit.  Strings are not
+ * released while the process runs, so only intern names, not arbitrary data values.  Code that
+ * only looks a name up should use Atom::find(), which never adds to the table.  Reading the
+ * table does not take a lock.
+ */
+class Atom {
+public:
+    using Entry = std::pair<const std::string, size_t>;   // The string and its hash
+
+    /**
+     * Construct the empty atom
+     */
+    Atom();
+
+    Atom(const std::string& value) : mEntry(intern(value)) {}
+    Atom(const char *value) : mEntry(intern(std::string(value))) {}
+
+    /**
+     * Look up a string without interning it.  A string that has never been interned cannot be
+     * the key of any container of atoms, so a miss can skip the container lookup entirely.
+     * @param value The string.
+     * @return The atom, or the empty atom if the string has not been interned.
+     */
+    static Atom find(const std::string& value);
+
+    /**
+     * @return The interned string.
+     */
+    const std::string& str() const { return mEntry->first; }
+    operator const std::string&() const { return mEntry->first; }
+    const char *c_str() const { return mEntry->first.c_str(); }
+
+    /**
+     * @return The std::hash of the interned string.
+     */
+    size_t hash() const { return mEntry->second; }
+
+    bool empty() const { return mEntry->first.empty(); }
+    size_t size() const { return mEntry->first.size(); }
+
+    bool operator==(const Atom& rhs) const { return mEntry == rhs.mEntry; }
+    bool operator!=(const Atom& rhs) const { return mEntry != rhs.mEntry; }
+    bool operator<(const Atom& rhs) const { return mEntry != rhs.mEntry && mEntry->first < rhs.mEntry->first; }
+
+    bool operator==(const std::string& rhs) const { return mEntry->first == rhs; }
+    bool operator!=(const std::string& rhs) const { return mEntry->first != rhs; }
+    bool operator==(const char *rhs) const { return mEntry->first == rhs; }
+    bool operator!=(const char *rhs) const { return mEntry->first != rhs; }
+
+    friend streamer& operator<<(streamer& os, const Atom& atom) {
+        return os << atom.str();
+    }
+
+    /**
+     * @return The number of distinct strings that have been interned.
+     */
+    static size_t tableSize();
+
+    /**
+     * @return The approximate number of bytes used by the intern table.
+     */
+    static size_t tableBytes();
+
+private:
+    explicit Atom(const Entry *entry) : mEntry(entry) {}
+
+    static const Entry *intern(const std::string& value);
+
+    const Entry *mEntry;
+};
+
+inline bool operator==(const std::string& lhs, const Atom& rhs) { return rhs == lhs; }
+inline bool operator!=(const std::string& lhs, const Atom& rhs) { return rhs != lhs; }
+
+inline std::ostream& operator<<(std::ostream& os, const Atom& atom) { return os << atom.str(); }
+
+/**
+ * Intern a list of strings
+ */
+inline std::vector<Atom>
+toAtoms(const std::vector<std::string>& values)
+{
+    return std::vector<Atom>(values.begin(), values.end());
+}
+
+} // namespace apl
+
+namespace std {
+
+template<> struct hash<apl::Atom> {
+    size_t operator()(const apl::Atom& atom) const { return atom.hash(); }
+};
+
+} // namespace std
+
+#endif // _APL_ATOM_H
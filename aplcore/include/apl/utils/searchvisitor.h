@@ -16,8 +16,12 @@
 #ifndef APL_SEARCHVISITOR_H
 #define APL_SEARCHVISITOR_H
 
+#include <vector>
+
 #include "apl/common.h"
 #include "apl/primitives/point.h"
+#include "apl/primitives/transform2d.h"
+#include "apl/utils/visitor.h"
 
 namespace apl {
 
@@ -82,6 +86,11 @@ public:
      */
     CoreComponentPtr getResult() const;
 
+    /**
+     * @return The search point in the coordinate space of the most recently visited component.
+     */
+    Point currentPoint() const { return mCurrentTransform * mGlobalPoint; }
+
     /**
      * A condition that the resulting component and all its ancestors must satisfy.  SearchVisitor will take care of
      * ensuring all ancestors meet the condition.  Implementations should only test the component passed in as argument.
@@ -108,6 +117,8 @@ private:
     CoreComponentPtr mPotentialResult = nullptr;
     Point            mGlobalPoint;
     Transform2D      mCurrentTransform;
+    Transform2D      mParentTransform;
+    std::vector<Transform2D> mTransformStack;   // Restores the parent transform between siblings
 };
 
 /**
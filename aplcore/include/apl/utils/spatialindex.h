@@ -0,0 +1,83 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_SPATIAL_INDEX_H
+#define _APL_SPATIAL_INDEX_H
+
+#include <cstdint>
+#include <vector>
+
+#include "apl/primitives/point.h"
+#include "apl/primitives/rect.h"
+
+namespace apl {
+
+/**
+ * A uniform grid over a set of rectangles used to find the rectangles that contain a point.
+ *
+ * The rectangles are identified by their position in the vector passed to build().  Each grid
+ * cell lists the rectangles that overlap it in descending order, so a query visits the
+ * rectangles from last to first.  This matches the reverse painting order used when searching
+ * for the topmost component at a position.  Empty rectangles are never returned.
+ */
+class SpatialIndex {
+public:
+    /**
+     * Rebuild the index.
+     * @param rects The rectangles to index.
+     */
+    void build(std::vector<Rect>&& rects);
+
+    /**
+     * Remove all rectangles from the index.
+     */
+    void clear();
+
+    /**
+     * Return the rectangles that may contain a point, in descending order.  The caller should
+     * check each candidate with contains().
+     * @param point The point.
+     * @return The indices of the candidate rectangles.
+     */
+    const std::vector<uint32_t>& candidates(const Point& point) const;
+
+    /**
+     * @param index The index of a rectangle.
+     * @param point The point.
+     * @return True if the rectangle contains the point.
+     */
+    bool contains(uint32_t index, const Point& point) const { return mRects.at(index).contains(point); }
+
+    /**
+     * @return The number of indexed rectangles, including empty ones.
+     */
+    size_t size() const { return mRects.size(); }
+
+private:
+    std::vector<Rect> mRects;
+    std::vector<std::vector<uint32_t>> mCells;
+    float mLeft = 0;
+    float mTop = 0;
+    float mWidth = 0;
+    float mHeight = 0;
+    float mCellWidth = 1;
+    float mCellHeight = 1;
+    int mColumns = 0;
+    int mRows = 0;
+};
+
+} // namespace apl
+
+#endif // _APL_SPATIAL_INDEX_H
@@ -62,8 +62,10 @@ ScrollAction::start() {
     else if (prop.isAbsoluteDimension())
         distance = prop.getAbsoluteDimension();
 
-    // Calculate the new position by trimming the old position plus the distance
-    auto position = mTarget->trimScroll(mTarget->scrollPosition() + Point(distance, distance));
+    // Calculate the new position by trimming the old position plus the distance.  Children that
+    // have not been inflated yet are inflated to reach the new position.
+    auto target = std::static_pointer_cast<CoreComponent>(mTarget);
+    auto position = target->inflateAndTrimScroll(mTarget->scrollPosition() + Point(distance, distance));
     bag.emplace(kEventPropertyPosition, Dimension(vertical ? position.getY() : position.getX()));
 
     LOG_IF(DEBUG_SCROLL) << "Pushing scroll event position=" << position;
@@ -185,8 +185,9 @@ ScrollToAction::scrollTo(const std::shared_ptr<apl::Component>& scrollable)
             break;
     }
 
-    // Calculate the new position by trimming the old position plus the distance
-    auto p = scrollable->trimScroll(Point(scrollTo, scrollTo));
+    // Calculate the new position by trimming the old position plus the distance.  Children that
+    // have not been inflated yet are inflated to reach the new position.
+    auto p = std::static_pointer_cast<CoreComponent>(scrollable)->inflateAndTrimScroll(Point(scrollTo, scrollTo));
 
     LOG_IF(DEBUG_SCROLL_TO) << "...distance=" << scrollTo << " position=" << p;
 
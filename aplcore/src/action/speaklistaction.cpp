@@ -27,6 +27,10 @@ SpeakListAction::make(const TimersPtr& timers,
     auto container = command->target();
     auto start = command->getValue(kCommandPropertyStart).asInt();
     auto count = command->getValue(kCommandPropertyCount).asInt();
+    if (start < 0)
+        container->inflateAllChildren(true);
+    else if (count > 0)
+        container->ensureChildInflated(static_cast<size_t>(start) + count - 1, true);
     int len = container->getChildCount();
 
     // Sanity checks
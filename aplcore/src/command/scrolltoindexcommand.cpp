@@ -42,6 +42,10 @@ ScrollToIndexCommand::execute(const TimersPtr& timers, bool fastMode) {
 
     // Switch the mTarget component to point to the thing being scrolled
     auto childIndex = mValues.at(kCommandPropertyIndex).getInteger();
+    if (childIndex < 0)
+        mTarget->inflateAllChildren(true);
+    else
+        mTarget->ensureChildInflated(childIndex, true);
     auto childCount = mTarget->getChildCount();
     childIndex = childIndex < 0 ? childIndex + childCount : childIndex;
     if (childIndex >= childCount || childIndex < 0) {
@@ -49,6 +49,13 @@ Component::updateGraphic(const GraphicContentPtr& json) {
     return false;
 }
 
+const std::set<PropertyKey>&
+Component::getDirty() {
+    mDirtyKeys.clear();
+    mDirtyKeys.insert(mDirty.begin(), mDirty.end());
+    return mDirtyKeys;
+}
+
 void
 Component::clearDirty() {
     mDirty.clear();
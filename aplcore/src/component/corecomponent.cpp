@@ -15,6 +15,9 @@
 
 #include <yoga/YGNode.h>
 
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
 #include "apl/common.h"
 #include "apl/component/corecomponent.h"
 #include "apl/component/componentpropdef.h"
@@ -26,7 +29,9 @@
 #include "apl/engine/focusmanager.h"
 #include "apl/engine/hovermanager.h"
 #include "apl/engine/keyboardmanager.h"
+#include "apl/engine/tickscheduler.h"
 #include "apl/engine/builder.h"
+#include "apl/engine/childinflater.h"
 #include "apl/engine/componentdependant.h"
 #include "apl/livedata/layoutrebuilder.h"
 #include "apl/primitives/keyboard.h"
@@ -49,6 +54,12 @@ const std::string VISUAL_CONTEXT_TYPE_EMPTY = "empty";
 const static bool DEBUG_BOUNDS = false;
 const static bool DEBUG_ENSURE = false;
 
+// Components with fewer children search them linearly instead of building a hit index
+const static size_t HIT_INDEX_MINIMUM_CHILDREN = 16;
+
+// Layout passes that may queue text for batched measurement before falling back to single measurements
+const static int MAX_TEXT_MEASURE_BATCHES = 4;
+
 CoreComponent::CoreComponent(const ContextPtr& context,
                              Properties&& properties,
                              const std::string& path)
@@ -62,26 +73,6 @@ CoreComponent::CoreComponent(const ContextPtr& context,
 {
 }
 
-void
-CoreComponent::scheduleTickHandler(const Object& handler, double delay) {
-    auto weak_ptr = std::weak_ptr<CoreComponent>(std::static_pointer_cast<CoreComponent>(shared_from_this()));
-    // Lambda capture takes care of handler here as it's a copy.
-    mContext->getRootConfig().getTimeManager()->setTimeout([weak_ptr, handler, delay]() {
-        auto self = weak_ptr.lock();
-        if (!self)
-            return;
-
-        auto ctx = self->createEventContext("Tick");
-        if (propertyAsBoolean(*ctx, handler, "when", true)) {
-            auto commands = Object(arrayifyProperty(*ctx, handler, "commands"));
-            if (!commands.empty())
-                ctx->sequencer().executeCommands(commands, ctx, self, true);
-        }
-
-        self->scheduleTickHandler(handler, delay);
-    }, delay);
-}
-
 void
 CoreComponent::processTickHandlers() {
     auto& tickHandlers = getCalculated(kPropertyHandleTick);
@@ -89,9 +80,7 @@ CoreComponent::processTickHandlers() {
         return;
 
     for (const auto& handler : tickHandlers.getArray()) {
-        auto delay = std::max(propertyAsDouble(*mContext, handler, "minimumDelay", 1000),
-                mContext->getRootConfig().getTickHandlerUpdateLimit());
-        scheduleTickHandler(handler, delay);
+        mContext->tickScheduler().add(std::static_pointer_cast<CoreComponent>(shared_from_this()), handler);
     }
 }
 
@@ -118,7 +107,7 @@ CoreComponent::initialize()
     auto user = std::make_shared<ObjectMap>();
     for (const auto& p : mProperties) {
         if (!std::strncmp("-user-", p.first.c_str(), 6))
-            user->emplace(p.first.substr(6), p.second);
+            user->emplace(p.first.str().substr(6), p.second);
     }
     mCalculated.set(kPropertyUser, user);
 
@@ -135,6 +124,7 @@ CoreComponent::release()
 {
     // TODO: Must remove this component from any dirty lists
     mParent = nullptr;
+    mInflater = nullptr;
     for (auto& child : mChildren)
         child->release();
     mChildren.clear();
@@ -171,6 +161,72 @@ CoreComponent::raccept(Visitor<CoreComponent>& visitor) const
     visitor.pop();
 }
 
+void
+CoreComponent::rsearch(SearchVisitor& visitor) const
+{
+    visitor.visit(*this);
+    auto point = visitor.currentPoint() + scrollPosition();
+    visitor.push();
+    if (mChildren.size() < HIT_INDEX_MINIMUM_CHILDREN) {
+        for (auto index = static_cast<int>(mChildren.size()) - 1; !visitor.isAborted() && index >= 0; index--)
+            if (isSearchableChild(index))
+                mChildren.at(index)->rsearch(visitor);
+    }
+    else if (!visitor.isAborted()) {
+        const auto& index = hitIndex();
+        for (auto it = index.candidates(point).begin(); !visitor.isAborted() && it != index.candidates(point).end(); it++)
+            if (index.contains(*it, point) && isSearchableChild(*it))
+                mChildren.at(*it)->rsearch(visitor);
+    }
+    visitor.pop();
+}
+
+/**
+ * The hit index holds the area covered by each child in the content coordinates of this component (before
+ * scrolling).  This is the axis-aligned bounding box of the transformed bounds of the child, padded slightly
+ * so that rounding never excludes a child that the search visitor would accept.
+ */
+const SpatialIndex&
+CoreComponent::hitIndex() const
+{
+    static const float PADDING = 0.5f;
+
+    if (!mHitIndex)
+        mHitIndex.reset(new SpatialIndex());
+
+    if (!mHitIndexValid) {
+        std::vector<Rect> rects;
+        rects.reserve(mChildren.size());
+        for (const auto& child : mChildren) {
+            auto bounds = child->getCalculated(kPropertyBounds).getRect();
+            auto transform = child->getCalculated(kPropertyTransform).getTransform2D();
+            if (bounds.isEmpty() || transform.singular()) {
+                rects.emplace_back();
+                continue;
+            }
+
+            Point corners[4] = {transform * Point(0, 0),
+                                transform * Point(bounds.getWidth(), 0),
+                                transform * Point(0, bounds.getHeight()),
+                                transform * Point(bounds.getWidth(), bounds.getHeight())};
+            auto left = corners[0].getX(), right = left, top = corners[0].getY(), bottom = top;
+            for (const auto& corner : corners) {
+                left = std::min(left, corner.getX());
+                right = std::max(right, corner.getX());
+                top = std::min(top, corner.getY());
+                bottom = std::max(bottom, corner.getY());
+            }
+
+            rects.emplace_back(bounds.getLeft() + left - PADDING, bounds.getTop() + top - PADDING,
+                               right - left + 2 * PADDING, bottom - top + 2 * PADDING);
+        }
+        mHitIndex->build(std::move(rects));
+        mHitIndexValid = true;
+    }
+
+    return *mHitIndex;
+}
+
 ComponentPtr
 CoreComponent::findComponentById(const std::string& id) const
 {
@@ -186,6 +242,21 @@ CoreComponent::findComponentById(const std::string& id) const
             return result;
     }
 
+    // Inflate deferred children in order until one matches.  A unique id is assigned when a
+    // component is created, so it never refers to a deferred child.
+    auto self = const_cast<CoreComponent*>(this);
+    while (mInflater && id[0] != ':') {
+        auto index = mChildren.size() - (mInflater->hasLastItem() ? 1 : 0);
+        auto count = mChildren.size();
+        self->ensureChildInflated(index, true);
+        if (mChildren.size() == count)
+            break;
+
+        auto result = mChildren[index]->findComponentById(id);
+        if (result)
+            return result;
+    }
+
     return nullptr;
 }
 
@@ -193,7 +264,7 @@ ComponentPtr
 CoreComponent::findComponentAtPosition(const Point& position) const
 {
     auto visitor = TopAtPosition(position);
-    raccept(visitor);
+    rsearch(visitor);
     return visitor.getResult();
 }
 
@@ -297,6 +368,7 @@ CoreComponent::insertChild(const ComponentPtr& child, size_t index, bool useDirt
     attachYogaNodeIfRequired(coreChild, index);
 
     mChildren.insert(mChildren.begin() + index, coreChild);
+    invalidateHitIndex();
 
     if (useDirtyFlag) {
         notifyChildChanged(index, child->getUniqueId(), "insert");
@@ -314,6 +386,12 @@ CoreComponent::remove()
     if (!mParent || !mParent->canRemoveChild())
         return false;
 
+    // Deferred children are inserted before the "lastItem", so removing the "lastItem" inflates them
+    // first.  Any other child is ahead of the deferred children and leaves them alone.
+    auto inflater = mParent->mInflater;
+    if (inflater && inflater->hasLastItem() && mParent->mChildren.back().get() == this)
+        mParent->inflateAllChildren(true);
+
     // When we've been removed, we need to clear Yoga properties that were set based on our parent type.
     // If we don't clear these, certain properties like "alignSelf" that apply only in Containers will mess
     // up the layout when we switch to a Sequence.
@@ -340,6 +418,7 @@ CoreComponent::removeChild(const CoreComponentPtr& child, size_t index, bool use
 
     YGNodeRemoveChild(mYGNodeRef, child->getNode());
     mChildren.erase(mChildren.begin() + index);
+    invalidateHitIndex();
 
     // The parent component has changed the number of children
     if (useDirtyFlag)
@@ -419,12 +498,17 @@ CoreComponent::ensureLayout(bool useDirtyFlag)
     }
 
     // Run layout calculation if required on the top most component.
-    if(needsLayoutCalculation) {
-        auto width = YGNodeLayoutGetWidth(component->getNode());
-        auto height = YGNodeLayoutGetHeight(component->getNode());
-        LOG_IF(DEBUG_ENSURE) << "Re-running parent layout with width=" << width << " height=" << height;
-        component->layout(width, height, useDirtyFlag);
-    }
+    if(needsLayoutCalculation)
+        component->relayout(useDirtyFlag);
+}
+
+void
+CoreComponent::relayout(bool useDirtyFlag)
+{
+    auto width = YGNodeLayoutGetWidth(mYGNodeRef);
+    auto height = YGNodeLayoutGetHeight(mYGNodeRef);
+    LOG_IF(DEBUG_ENSURE) << "Re-running parent layout with width=" << width << " height=" << height;
+    layout(width, height, useDirtyFlag);
 }
 
 void
@@ -494,6 +578,74 @@ CoreComponent::isAttached() const
     return mYGNodeRef->getOwner() != nullptr;
 }
 
+bool
+CoreComponent::ensureChildInflated(size_t index, bool useDirtyFlag)
+{
+    while (mInflater) {
+        // Deferred children are inserted before the "lastItem"
+        auto inflated = mChildren.size() - (mInflater->hasLastItem() ? 1 : 0);
+        if (index < inflated)
+            break;
+
+        if (!mInflater->inflateNext(useDirtyFlag) || mInflater->done())
+            mInflater = nullptr;
+    }
+
+    return index < mChildren.size();
+}
+
+void
+CoreComponent::inflateAllChildren(bool useDirtyFlag)
+{
+    if (!mInflater)
+        return;
+
+    auto inflater = mInflater;
+    mInflater = nullptr;
+    inflater->inflateAll(useDirtyFlag);
+}
+
+const TextMeasureInputPtr&
+CoreComponent::getMeasureInput() const
+{
+    if (!mMeasureInput) {
+        std::vector<Object> values;
+        for (const auto& pds : propDefSet())
+            if ((pds.second.flags & kPropLayout) != 0)
+                values.emplace_back(mCalculated.get(pds.first));
+        mMeasureInput = std::make_shared<TextMeasureInput>(getType(), std::move(values));
+    }
+
+    return mMeasureInput;
+}
+
+size_t
+CoreComponent::getDeferredChildCount() const
+{
+    return mInflater ? mInflater->remaining() : 0;
+}
+
+Point
+CoreComponent::inflateAndTrimScroll(const Point& point)
+{
+    // trimScroll() stops at the last inflated child, so inflate more until the result stops changing
+    auto result = trimScroll(point);
+    while (getDeferredChildCount() > 0 && ensureChildInflated(mChildren.size(), true)) {
+        // Children inflated inside the laid out range are attached but still need a layout pass
+        auto top = shared_from_corecomponent();
+        while (top->getParent())
+            top = std::static_pointer_cast<CoreComponent>(top->getParent());
+        top->relayout(true);
+
+        auto trimmed = trimScroll(point);
+        if (trimmed == result)
+            break;
+        result = trimmed;
+    }
+
+    return result;
+}
+
 /**
  * Certain properties can only be set when we are attached to the node layout hierarchy.
  * These properties should already have been calculated; we call the layout method to
@@ -573,6 +725,12 @@ CoreComponent::assignProperties(const ComponentPropDefSet& propDefSet)
             pd.layoutFunc(mYGNodeRef, value, *mContext);
     }
 
+    // Later style updates are applied relative to this style.  If the layout properties were
+    // assigned from a different style, the next update must check every styled property.
+    if (&propDefSet == &this->propDefSet())
+        mAppliedStyle = stylePtr;
+    else if (mAppliedStyle != stylePtr)
+        mAppliedStyle = nullptr;
 }
 
 void
@@ -597,8 +755,10 @@ CoreComponent::handlePropertyChange(const ComponentPropDef& def, const Object& v
             def.trigger(*this);
 
         // If this property affects the layout, we'll need a new layout pass
-        if ((def.flags & kPropLayout) != 0)
+        if ((def.flags & kPropLayout) != 0) {
             YGNodeMarkDirty(mYGNodeRef);
+            mMeasureInput = nullptr;
+        }
 
         // If this property affects the state, we'll do a SetState change
         if ((def.flags & kPropMixedState) != 0) {
@@ -654,8 +814,7 @@ CoreComponent::setPropertyInternal( const ComponentPropDefSet& pds, PropertyKey
         return false;
 
     // If this property was previously assigned we need to clear any dependants
-    auto assigned = mAssigned.find(key);
-    if (assigned != mAssigned.end()) // Erase all upstream dependants that drive this key
+    if (mAssigned.count(key)) // Erase all upstream dependants that drive this key
         removeUpstream(key);
 
     // Mark this property in the "assigned" set of properties.
@@ -727,8 +886,10 @@ CoreComponent::markPropertyInternal(const ComponentPropDefSet& pds, PropertyKey
         def.trigger(*this);
 
     // If this property affects the layout, we'll need a new layout pass
-    if ((def.flags & kPropLayout) != 0)
+    if ((def.flags & kPropLayout) != 0) {
         YGNodeMarkDirty(mYGNodeRef);
+        mMeasureInput = nullptr;
+    }
 
     return true;
 }
@@ -746,8 +907,7 @@ CoreComponent::markProperty(PropertyKey key)
 void
 CoreComponent::updateProperty(PropertyKey key, const Object& value)
 {
-    auto it = mAssigned.find(key);
-    if (it == mAssigned.end())
+    if (!mAssigned.count(key))
         return;
 
     // Check the standard properties first
@@ -783,23 +943,35 @@ CoreComponent::updateProperty(PropertyKey key, const Object& value)
  * Calling this method sets dirty flags.
  */
 void
-CoreComponent::updateStyleInternal(const StyleInstancePtr& stylePtr, const ComponentPropDefSet& pds) {
+CoreComponent::updateStyledProperty(const StyleInstancePtr& stylePtr, const ComponentPropDef& pd) {
+    // If the property was explicitly assigned by the user, the style won't change it.
+    if (mAssigned.count(pd.key))
+        return;
 
-    // Check every property that has the "styled" flag.
-    for (const auto& it : pds.styled()) {
-        const ComponentPropDef& pd = it.second;
+    // Check to see if the value has changed.
+    auto value = (pd.defaultFunc ? pd.defaultFunc(*this, mContext->getRootConfig()) : pd.defvalue);
+    auto s = stylePtr->find(pd.names);
+    if (s != stylePtr->end())
+        value = pd.calculate(*mContext, s->second);
 
-        // If the property was explicitly assigned by the user, the style won't change it.
-        if (mAssigned.count(pd.key))
-            continue;
+    handlePropertyChange(pd, value);
+}
 
-        // Check to see if the value has changed.
-        auto value = (pd.defaultFunc ? pd.defaultFunc(*this, mContext->getRootConfig()) : pd.defvalue);
-        auto s = stylePtr->find(pd.names);
-        if (s != stylePtr->end())
-            value = pd.calculate(*mContext, s->second);
+void
+CoreComponent::updateStyleInternal(const StyleInstancePtr& stylePtr, const ComponentPropDefSet& pds) {
+    // Check every property that has the "styled" flag.
+    for (const auto& it : pds.styled())
+        updateStyledProperty(stylePtr, it.second);
+}
 
-        handlePropertyChange(pd, value);
+void
+CoreComponent::updateStyleInternal(const StyleInstancePtr& stylePtr, const ComponentPropDefSet& pds,
+                                   const std::vector<Atom>& changes) {
+    // Only check the styled properties that read a changed style property
+    for (const auto& name : changes) {
+        auto it = pds.findStyled(name);
+        if (it != pds.styled().end())
+            updateStyledProperty(stylePtr, it->second);
     }
 }
 
@@ -808,6 +980,9 @@ CoreComponent::updateStyleInternal(const StyleInstancePtr& stylePtr, const Compo
  * update each styled property in turn.  Then update any children that share their
  * parent state.
  *
+ * Only the style properties that differ from the last applied style are checked.  The
+ * full set of styled properties is checked if the applied style is not known.
+ *
  * Calling this method sets dirty flags.
  *
  * Note that changing the style may force a new layout pass.
@@ -816,11 +991,20 @@ void
 CoreComponent::updateStyle()
 {
     auto stylePtr = getStyle();
-    if (stylePtr) {
-        updateStyleInternal(stylePtr, propDefSet());
+    if (stylePtr && stylePtr != mAppliedStyle) {
         const ComponentPropDefSet *layoutPDS = getLayoutPropDefSet();
-        if (layoutPDS)
-            updateStyleInternal(stylePtr, *layoutPDS);
+        if (mAppliedStyle) {
+            const auto& changes = stylePtr->changedFrom(mAppliedStyle);
+            updateStyleInternal(stylePtr, propDefSet(), changes);
+            if (layoutPDS)
+                updateStyleInternal(stylePtr, *layoutPDS, changes);
+        }
+        else {
+            updateStyleInternal(stylePtr, propDefSet());
+            if (layoutPDS)
+                updateStyleInternal(stylePtr, *layoutPDS);
+        }
+        mAppliedStyle = stylePtr;
     }
     for (auto child : mChildren) {
         if (child->mInheritParentState)
@@ -867,8 +1051,11 @@ CoreComponent::setState( StateProperty stateProperty, bool value )
 void
 CoreComponent::setDirty( PropertyKey key )
 {
-    if (mDirty.emplace(key).second)
+    if (mDirty.emplace(key))
         mContext->setDirty(shared_from_this());
+
+    // The value may have changed in place, as a graphic does, so the snapshot is always discarded
+    invalidateSnapshot();
 }
 
 void
@@ -932,10 +1119,33 @@ CoreComponent::layout(int width, int height, bool useDirtyFlag)
 {
     LOG_IF(DEBUG_ENSURE) << " width=" << width << " height=" << height
         << " useDirty=" << useDirtyFlag << " this=" << *this;
-    YGNodeCalculateLayout(mYGNodeRef, width, height, YGDirection::YGDirectionLTR);
+    calculateLayout(width, height);
     processLayoutChanges(useDirtyFlag);
 }
 
+void
+CoreComponent::calculateLayout(float width, float height)
+{
+    auto& cache = mContext->textMeasureCache();
+    if (!cache.batching()) {
+        YGNodeCalculateLayout(mYGNodeRef, width, height, YGDirection::YGDirectionLTR);
+        return;
+    }
+
+    // Each pass queues the text it could not measure.  A result may change the constraints of
+    // other text, so repeat until nothing is queued.  Text still unmeasured after the last batch
+    // is measured one component at a time.
+    cache.beginBatch();
+    for (int batch = 1 ; ; batch++) {
+        YGNodeCalculateLayout(mYGNodeRef, width, height, YGDirection::YGDirectionLTR);
+        if (!cache.measureBatch())
+            break;
+        if (batch == MAX_TEXT_MEASURE_BATCHES)
+            cache.stopQueueing();
+    }
+    cache.endBatch();
+}
+
 bool
 CoreComponent::needsLayout() const
 {
@@ -944,6 +1154,18 @@ CoreComponent::needsLayout() const
 
 void
 CoreComponent::processLayoutChanges(bool useDirtyFlag)
+{
+    updateLayout(useDirtyFlag, false);
+}
+
+void
+CoreComponent::processAttachedLayoutChanges(bool useDirtyFlag)
+{
+    updateLayout(useDirtyFlag, true);
+}
+
+void
+CoreComponent::updateLayout(bool useDirtyFlag, bool changedChildrenOnly)
 {
     if (DEBUG_BOUNDS) YGNodePrint(mYGNodeRef, YGPrintOptions::YGPrintOptionsLayout);
 
@@ -962,6 +1184,8 @@ CoreComponent::processLayoutChanges(bool useDirtyFlag)
         mCalculated.set(kPropertyBounds, std::move(rect));
         if (useDirtyFlag)
             setDirty(kPropertyBounds);
+        if (mParent)
+            mParent->invalidateHitIndex();
     }
 
     // Update the inner drawing area (this takes into account both padding and borders
@@ -988,9 +1212,21 @@ CoreComponent::processLayoutChanges(bool useDirtyFlag)
     }
 
     // Inform all children that they should re-check their bounds. No need to do that for not attached ones.
-    for (auto& child : mChildren)
-        if (child->isAttached())
-            child->processLayoutChanges(useDirtyFlag);
+    for (auto& child : mChildren) {
+        if (!child->isAttached())
+            continue;
+
+        // Attaching children does not change the layout inside the ones that kept their bounds
+        if (changedChildrenOnly && child->mCalculated.get(kPropertyLaidOut).asBoolean()) {
+            auto node = child->mYGNodeRef;
+            Rect childRect(YGNodeLayoutGetLeft(node), YGNodeLayoutGetTop(node),
+                           YGNodeLayoutGetWidth(node), YGNodeLayoutGetHeight(node));
+            if (childRect == child->mCalculated.get(kPropertyBounds).getRect())
+                continue;
+        }
+
+        child->processLayoutChanges(useDirtyFlag);
+    }
 
     if (!mCalculated.get(kPropertyLaidOut).asBoolean() && !mCalculated.get(kPropertyBounds).getRect().isEmpty()) {
         mCalculated.set(kPropertyLaidOut, true);
@@ -1121,6 +1357,8 @@ CoreComponent::fixTransform(bool useDirtyFlag)
         mCalculated.set(kPropertyTransform, Object(std::move(updated)));
         if (useDirtyFlag)
             setDirty(kPropertyTransform);
+        if (mParent)
+            mParent->invalidateHitIndex();
 
         LOG_IF(DEBUG_TRANSFORM) << "updated to " << mCalculated.get(kPropertyTransform).getTransform2D();
     }
@@ -1154,8 +1392,11 @@ CoreComponent::calculateChildrenVisualLayer(const std::map<int, float>& visibleI
     return result;
 }
 
+/**
+ * Serialize the id, type and output properties of this component without its children.
+ */
 rapidjson::Value
-CoreComponent::serialize(rapidjson::Document::AllocatorType& allocator) const
+CoreComponent::serializeProperties(rapidjson::Document::AllocatorType& allocator) const
 {
     rapidjson::Value component(rapidjson::kObjectType);
 
@@ -1170,6 +1411,14 @@ CoreComponent::serialize(rapidjson::Document::AllocatorType& allocator) const
                 allocator);
     }
 
+    return component;
+}
+
+rapidjson::Value
+CoreComponent::serialize(rapidjson::Document::AllocatorType& allocator) const
+{
+    auto component = serializeProperties(allocator);
+
     if (mChildren.size() > 0) {
         rapidjson::Value children(rapidjson::kArrayType);
         for (const auto& child : mChildren)
@@ -1180,6 +1429,44 @@ CoreComponent::serialize(rapidjson::Document::AllocatorType& allocator) const
     return component;
 }
 
+std::string
+CoreComponent::serializeSnapshot() const
+{
+    std::string result;
+    appendSnapshot(result);
+    return result;
+}
+
+void
+CoreComponent::appendSnapshot(std::string& out) const
+{
+    if (!mSnapshotValid || mSnapshotVersion != mCalculated.version()) {
+        // The children are not serialized here; their text is appended after this fragment
+        rapidjson::Document doc;
+        auto component = serializeProperties(doc.GetAllocator());
+
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        component.Accept(writer);
+
+        mSnapshot.assign(buffer.GetString(), buffer.GetSize() - 1);
+        mSnapshotVersion = mCalculated.version();
+        mSnapshotValid = true;
+    }
+
+    out += mSnapshot;
+    if (!mChildren.empty()) {
+        out += ",\"children\":[";
+        for (size_t i = 0 ; i < mChildren.size() ; i++) {
+            if (i)
+                out += ',';
+            mChildren[i]->appendSnapshot(out);
+        }
+        out += ']';
+    }
+    out += '}';
+}
+
 rapidjson::Value
 CoreComponent::serializeAll(rapidjson::Document::AllocatorType& allocator) const
 {
@@ -1222,7 +1509,7 @@ CoreComponent::serializeDirty(rapidjson::Document::AllocatorType& allocator) {
     rapidjson::Value component(rapidjson::kObjectType);
 
     component.AddMember("id", rapidjson::Value(mUniqueId.c_str(), allocator).Move(), allocator);
-    for (auto& key : mDirty) {
+    for (auto key : mDirty) {
         component.AddMember(
             rapidjson::Value(sComponentPropertyBimap.at(key).c_str(), allocator),
             mCalculated.get(key).serializeDirty(allocator),
@@ -1643,11 +1930,11 @@ CoreComponent::getCoordinateTransformFromParent(const ComponentPtr& ancestor, Tr
             * Transform2D::translate(-offsetInParent.getX(), -offsetInParent.getY());
 
         // Account for the parent's scroll position. The scroll position only affects the coordinate space
-        // of children, so we account for it in the child component transformation.
+        // of children, so it is applied in the parent coordinate space before the child offset and transformation.
         auto parent = component->getParent();
         if (parent) {
             auto scrollPosition = parent->scrollPosition();
-            result = Transform2D::translate(scrollPosition.getX(), scrollPosition.getY()) * result;
+            result = result * Transform2D::translate(scrollPosition.getX(), scrollPosition.getY());
         }
 
         component = parent;
@@ -20,6 +20,7 @@
 #include "apl/content/rootconfig.h"
 #include "apl/primitives/characterrange.h"
 #include "apl/time/sequencer.h"
+#include "apl/utils/arena.h"
 
 namespace apl {
 
@@ -27,7 +28,7 @@ CoreComponentPtr
 EditTextComponent::create(const ContextPtr& context,
                           Properties&& properties,
                           const std::string& path) {
-    auto ptr = std::make_shared<EditTextComponent>(context, std::move(properties), path);
+    auto ptr = allocateShared<EditTextComponent>(context->arena(), context, std::move(properties), path);
     ptr->initialize();
     return ptr;
 }
@@ -143,6 +144,7 @@ EditTextComponent::update(UpdateType type, const std::string& value) {
         auto currentValue = mCalculated.get(kPropertyText);
         if (requestedValue != currentValue) {
             mCalculated.set(kPropertyText, value);
+            mMeasureInput = nullptr;
             ContextPtr eventContext = createEventContext("TextChange");
             auto commands = getCalculated(kPropertyOnTextChange);
             mContext->sequencer().executeCommands(commands, eventContext, shared_from_corecomponent(), false);
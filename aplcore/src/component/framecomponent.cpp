@@ -16,6 +16,7 @@
 #include "apl/component/componentpropdef.h"
 #include "apl/component/framecomponent.h"
 #include "apl/component/yogaproperties.h"
+#include "apl/utils/arena.h"
 
 namespace apl {
 
@@ -31,7 +32,7 @@ FrameComponent::create(const ContextPtr& context,
                        Properties&& properties,
                        const std::string& path)
 {
-    auto ptr = std::make_shared<FrameComponent>(context, std::move(properties), path);
+    auto ptr = allocateShared<FrameComponent>(context->arena(), context, std::move(properties), path);
     ptr->initialize();
     return ptr;
 }
@@ -18,6 +18,7 @@
 #include "apl/component/gridsequencecomponent.h"
 #include "apl/component/yogaproperties.h"
 #include "apl/content/rootconfig.h"
+#include "apl/utils/arena.h"
 
 namespace apl {
 
@@ -26,7 +27,7 @@ GridSequenceComponent::create(const ContextPtr& context,
                           Properties&& properties,
                           const std::string& path)
 {
-    auto ptr = std::make_shared<GridSequenceComponent>(context, std::move(properties), path);
+    auto ptr = allocateShared<GridSequenceComponent>(context->arena(), context, std::move(properties), path);
     ptr->initialize();
     return ptr;
 }
@@ -122,14 +123,9 @@ GridSequenceComponent::eventPropertyMap() const
     return sGridEventProperties;
 }
 
-void GridSequenceComponent::layoutChildIfRequired(
-        const Rect& parentBounds,
-        CoreComponentPtr& child,
-        size_t childIdx,
-        bool useDirtyFlag) {
+void GridSequenceComponent::prepareChild(const CoreComponentPtr& child, size_t childIdx) {
     // We need to apply forced size before layout.
     applyChildSize(child, childIdx);
-    MultiChildScrollableComponent::layoutChildIfRequired(parentBounds, child, childIdx, useDirtyFlag);
 }
 
 void GridSequenceComponent::calculateAbsoluteChildSizes(float gridWidth, float gridHeight) {
@@ -16,6 +16,7 @@
 #include "apl/component/componentpropdef.h"
 #include "apl/component/imagecomponent.h"
 #include "apl/component/yogaproperties.h"
+#include "apl/utils/arena.h"
 
 namespace apl {
 
@@ -24,7 +25,7 @@ ImageComponent::create(const ContextPtr& context,
                        Properties&& properties,
                        const std::string& path)
 {
-    auto ptr = std::make_shared<ImageComponent>(context, std::move(properties), path);
+    auto ptr = allocateShared<ImageComponent>(context->arena(), context, std::move(properties), path);
     ptr->initialize();
     return ptr;
 }
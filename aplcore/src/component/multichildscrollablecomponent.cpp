@@ -13,6 +13,8 @@
  * permissions and limitations under the License.
  */
 
+#include <cmath>
+
 #include "apl/component/componentpropdef.h"
 #include "apl/component/multichildscrollablecomponent.h"
 #include "apl/component/yogaproperties.h"
@@ -51,6 +53,9 @@ bool
 MultiChildScrollableComponent::allowForward() const {
     if(getChildCount() == 0 || mEnsuredChildren.empty())
         return false;
+    // Children that have not been inflated yet follow the existing ones
+    if(getDeferredChildCount() > 0)
+        return true;
     // If the last element has not had ensureLayout called on it,
     // then the viewhost still has room to scroll.
     if(mEnsuredChildren.upperBound() + 1 < getChildCount())
@@ -82,8 +87,9 @@ void
 MultiChildScrollableComponent::update(UpdateType type, float value) {
     ScrollableComponent::update(type, value);
     if (type == kUpdateScrollPosition) {
-        // Force figuring out what is on screen.
-        processLayoutChanges(true);
+        // Force figuring out what is on screen.  Scrolling does not move the children, so only the
+        // children coming into view are laid out.
+        layoutChildrenInView(true, false);
         updateChildrenVisibility();
     }
 }
@@ -256,9 +262,10 @@ MultiChildScrollableComponent::trimScroll(const Point& point) const
 
         // Ensure children until they cover the sequence.
         int startingChild = std::max(mEnsuredChildren.upperBound(), 0);
-        for (int i = startingChild ; i<mChildren.size() ; i++) {
+        for (int i = startingChild ; i < mChildren.size() ; i++) {
+            if (!mChildren.at(i)->isAttached())
+                ensureChildrenLayout(i, estimateChildrenToCover(i - 1, y - maxY), false);
             const auto& child = mChildren.at(i);
-            child->ensureLayout(false);
             maxY = nonNegative(child->getCalculated(kPropertyBounds).getRect().getBottom() - bottom);
             if (y <= maxY)
                 return Point(0,y);
@@ -283,9 +290,10 @@ MultiChildScrollableComponent::trimScroll(const Point& point) const
 
         // Ensure children until they cover the sequence.
         int startingChild = std::max(mEnsuredChildren.upperBound(), 0);
-        for (int i = startingChild ; i<mChildren.size(); i++) {
+        for (int i = startingChild ; i < mChildren.size() ; i++) {
+            if (!mChildren.at(i)->isAttached())
+                ensureChildrenLayout(i, estimateChildrenToCover(i - 1, x - maxX), true);
             const auto& child = mChildren.at(i);
-            child->ensureLayout(true);
             maxX = nonNegative(child->getCalculated(kPropertyBounds).getRect().getRight() - right);
             if (x <= maxX)
                 return Point(x,0);
@@ -300,7 +308,7 @@ MultiChildScrollableComponent::getTags(rapidjson::Value& outMap, rapidjson::Docu
     bool actionable = ScrollableComponent::getTags(outMap, allocator);
     if(!mChildren.empty()) {
         rapidjson::Value list(rapidjson::kObjectType);
-        list.AddMember("itemCount", static_cast<int>(mChildren.size()), allocator);
+        list.AddMember("itemCount", static_cast<int>(mChildren.size() + getDeferredChildCount()), allocator);
 
         if (!mIndexesSeen.empty()) {
             auto lowestOrdinalSeen = INT_MAX;
@@ -332,21 +340,46 @@ MultiChildScrollableComponent::getTags(rapidjson::Value& outMap, rapidjson::Docu
     return actionable;
 }
 
-void
-MultiChildScrollableComponent::layoutChildIfRequired(
-        const Rect& parentBounds, CoreComponentPtr& child, size_t childIdx, bool useDirtyFlag) {
-    if (!child->isAttached() || child->getCalculated(kPropertyBounds).empty()) {
-        ensureChildAttached(child, childIdx);
-        if (childIdx > 0 && childrenUseSpacingProperty()) {
-            child->fixSpacing();
-        }
-        YGNodeCalculateLayout(
-                mYGNodeRef,
-                parentBounds.getWidth(),
-                parentBounds.getHeight(),
-                YGDirection::YGDirectionLTR);
-        CoreComponent::processLayoutChanges(useDirtyFlag);
+bool
+MultiChildScrollableComponent::attachChildIfRequired(const CoreComponentPtr& child, size_t childIdx) {
+    prepareChild(child, childIdx);
+    if (child->isAttached() && !child->getCalculated(kPropertyBounds).empty())
+        return false;
+
+    ensureChildAttached(child, childIdx);
+    if (childIdx > 0 && childrenUseSpacingProperty()) {
+        child->fixSpacing();
     }
+    return true;
+}
+
+void
+MultiChildScrollableComponent::layoutChildren(const Rect& parentBounds, bool useDirtyFlag) {
+    calculateLayout(parentBounds.getWidth(), parentBounds.getHeight());
+    processAttachedLayoutChanges(useDirtyFlag);
+}
+
+int
+MultiChildScrollableComponent::estimateChildrenToCover(size_t referenceIdx, float distance) const {
+    if (distance <= 0 || referenceIdx >= mChildren.size())
+        return 1;
+
+    // Children are assumed to be the size of a neighbour that has been laid out.  Spacing is not
+    // included, so the estimate rarely exceeds what the walk needs; an underestimate costs another pass.
+    auto bounds = mChildren.at(referenceIdx)->getCalculated(kPropertyBounds).getRect();
+    float extent = isHorizontal() ? bounds.getWidth() : bounds.getHeight();
+    if (extent <= 0)
+        return 1;
+
+    return std::max(1, static_cast<int>(std::ceil(std::min(distance / extent, static_cast<float>(mChildren.size())))));
+}
+
+void
+MultiChildScrollableComponent::ensureChildrenLayout(size_t index, int count, bool useDirtyFlag) const {
+    // Attaching the last child of the batch attaches the ones before it, so one layout pass covers them
+    // all.  Children that have not been inflated are not laid out; see inflateAndTrimScroll().
+    auto target = std::min(index + std::max(count, 1) - 1, mChildren.size() - 1);
+    mChildren.at(target)->ensureLayout(useDirtyFlag);
 }
 
 float
@@ -369,6 +402,16 @@ MultiChildScrollableComponent::shouldAttachChildYogaNode(int index) const {
     return (mEnsuredChildren.empty() && index == 0);
 }
 
+bool
+MultiChildScrollableComponent::isSearchableChild(size_t index) const {
+    // Matches the children visited by raccept()
+    if (!mEnsuredChildren.contains(index))
+        return false;
+
+    const auto& child = mChildren.at(index);
+    return child->isAttached() && !child->getCalculated(kPropertyBounds).getRect().isEmpty();
+}
+
 bool
 MultiChildScrollableComponent::insertChild(const ComponentPtr& child, size_t index, bool useDirtyFlag)
 {
@@ -395,6 +438,12 @@ MultiChildScrollableComponent::removeChild(const CoreComponentPtr& child, size_t
 
 void
 MultiChildScrollableComponent::processLayoutChanges(bool useDirtyFlag)
+{
+    layoutChildrenInView(useDirtyFlag, true);
+}
+
+void
+MultiChildScrollableComponent::layoutChildrenInView(bool useDirtyFlag, bool processOwnLayout)
 {
     // We need to account for padding as find function don't do that automatically.
     bool horizontal = isHorizontal();
@@ -406,7 +455,8 @@ MultiChildScrollableComponent::processLayoutChanges(bool useDirtyFlag)
         oldAnchorBounds = anchor->getCalculated(kPropertyBounds).getRect();
     }
 
-    CoreComponent::processLayoutChanges(useDirtyFlag);
+    if (processOwnLayout)
+        CoreComponent::processLayoutChanges(useDirtyFlag);
 
     if (mChildren.empty()) {
         // Starting with empty sequence
@@ -440,15 +490,25 @@ MultiChildScrollableComponent::processLayoutChanges(bool useDirtyFlag)
 
     // Lay out children in positive direction until we hit cache limit.
     float distanceToCover = (childCache + 1) * pageSize + anchorPosition;
+    // Children that need layout are attached in batches sized from the children laid out so far, and
+    // each batch is laid out in a single pass.
     int lastLoaded = mEnsuredChildren.lowerBound();
-    for (; lastLoaded < mChildren.size(); lastLoaded++) {
+    float distance = 0;
+    while (ensureChildInflated(lastLoaded, useDirtyFlag)) {
         auto child = mChildren.at(lastLoaded);
-        layoutChildIfRequired(sequenceBounds, child, lastLoaded, useDirtyFlag);
+        if (attachChildIfRequired(child, lastLoaded)) {
+            int count = lastLoaded > mEnsuredChildren.lowerBound()
+                        ? estimateChildrenToCover(lastLoaded - 1, distanceToCover - distance) : 1;
+            for (int index = lastLoaded + 1; index < lastLoaded + count && ensureChildInflated(index, useDirtyFlag); index++)
+                attachChildIfRequired(mChildren.at(index), index);
+            layoutChildren(sequenceBounds, useDirtyFlag);
+        }
         auto childBounds = child->getCalculated(kPropertyBounds).getRect();
-        float distance = horizontal ? childBounds.getRight() : childBounds.getBottom();
+        distance = horizontal ? childBounds.getRight() : childBounds.getBottom();
         if (distance > distanceToCover) {
             break;
         }
+        lastLoaded++;
     }
 
     reportLoaded(std::min(lastLoaded, mEnsuredChildren.upperBound()));
@@ -457,13 +517,20 @@ MultiChildScrollableComponent::processLayoutChanges(bool useDirtyFlag)
     // Lay out children in negative direction until we hit cache limit.
     distanceToCover = childCache * pageSize;
     int firstLoaded = mEnsuredChildren.upperBound();
+    distance = 0;
     for (; firstLoaded >= 0; firstLoaded--) {
         auto child = mChildren.at(firstLoaded);
-        layoutChildIfRequired(sequenceBounds, child, firstLoaded, useDirtyFlag);
+        if (attachChildIfRequired(child, firstLoaded)) {
+            int count = firstLoaded < mEnsuredChildren.upperBound()
+                        ? estimateChildrenToCover(firstLoaded + 1, distanceToCover - distance) : 1;
+            for (int index = firstLoaded - 1; index > firstLoaded - count && index >= 0; index--)
+                attachChildIfRequired(mChildren.at(index), index);
+            layoutChildren(sequenceBounds, useDirtyFlag);
+        }
         auto childBounds = child->getCalculated(kPropertyBounds).getRect();
         anchorBounds = anchor->getCalculated(kPropertyBounds).getRect();
-        float distance = (horizontal ? anchorBounds.getLeft() : anchorBounds.getTop())
-                       - (horizontal ? childBounds.getLeft() : childBounds.getTop());
+        distance = (horizontal ? anchorBounds.getLeft() : anchorBounds.getTop())
+                 - (horizontal ? childBounds.getLeft() : childBounds.getTop());
         if (distance > distanceToCover) {
             break;
         }
@@ -20,6 +20,7 @@
 #include "apl/content/rootconfig.h"
 #include "apl/primitives/keyboard.h"
 #include "apl/time/sequencer.h"
+#include "apl/utils/arena.h"
 
 namespace apl {
 
@@ -28,7 +29,7 @@ CoreComponentPtr
 PagerComponent::create(const ContextPtr& context,
                        Properties&& properties,
                        const std::string& path) {
-    auto ptr = std::make_shared<PagerComponent>(context, std::move(properties), path);
+    auto ptr = allocateShared<PagerComponent>(context->arena(), context, std::move(properties), path);
     ptr->initialize();
     return ptr;
 }
@@ -233,6 +234,12 @@ PagerComponent::raccept(Visitor<CoreComponent>& visitor) const {
     visitor.pop();
 }
 
+bool
+PagerComponent::isSearchableChild(size_t index) const {
+    // Only the current page is visited by raccept()
+    return static_cast<int>(index) == pagePosition();
+}
+
 bool
 PagerComponent::insertChild(const ComponentPtr& child, size_t index, bool useDirtyFlag) {
     size_t initialSize = mChildren.size();
@@ -19,6 +19,7 @@
 #include "apl/component/scrollviewcomponent.h"
 #include "apl/component/yogaproperties.h"
 #include "apl/time/sequencer.h"
+#include "apl/utils/arena.h"
 
 namespace apl {
 
@@ -26,7 +27,7 @@ CoreComponentPtr
 ScrollViewComponent::create(const ContextPtr& context,
                             Properties&& properties,
                             const std::string& path) {
-    auto ptr = std::make_shared<ScrollViewComponent>(context, std::move(properties), path);
+    auto ptr = allocateShared<ScrollViewComponent>(context->arena(), context, std::move(properties), path);
     ptr->initialize();
     return ptr;
 }
@@ -17,6 +17,7 @@
 #include "apl/component/sequencecomponent.h"
 #include "apl/component/yogaproperties.h"
 #include "apl/content/rootconfig.h"
+#include "apl/utils/arena.h"
 
 namespace apl {
 
@@ -25,7 +26,7 @@ SequenceComponent::create(const ContextPtr& context,
                           Properties&& properties,
                           const std::string& path)
 {
-    auto ptr = std::make_shared<SequenceComponent>(context, std::move(properties), path);
+    auto ptr = allocateShared<SequenceComponent>(context->arena(), context, std::move(properties), path);
     ptr->initialize();
     return ptr;
 }
@@ -16,6 +16,7 @@
 #include "apl/component/componentpropdef.h"
 #include "apl/component/textcomponent.h"
 #include "apl/content/rootconfig.h"
+#include "apl/utils/arena.h"
 
 namespace apl {
 
@@ -25,7 +26,7 @@ TextComponent::create(const ContextPtr& context,
                       Properties&& properties,
                       const std::string& path)
 {
-    auto ptr = std::make_shared<TextComponent>(context, std::move(properties), path);
+    auto ptr = allocateShared<TextComponent>(context->arena(), context, std::move(properties), path);
     ptr->initialize();
     return ptr;
 }
@@ -0,0 +1,296 @@
+/**
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+#include <cmath>
+
+#include "apl/component/corecomponent.h"
+#include "apl/component/textmeasurecache.h"
+#include "apl/primitives/styledtext.h"
+#include "apl/utils/log.h"
+
+namespace apl {
+
+static inline size_t
+combine(size_t seed, size_t value)
+{
+    return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+static size_t
+hashValue(const Object& value)
+{
+    switch (value.getType()) {
+        case Object::kStringType:
+            return std::hash<std::string>()(value.getString());
+        case Object::kStyledTextType:
+            return std::hash<std::string>()(value.getStyledText().getRawText());
+        case Object::kNullType:
+            return 0;
+        case Object::kBoolType:
+        case Object::kNumberType:
+        case Object::kAbsoluteDimensionType:
+        case Object::kRelativeDimensionType:
+            return std::hash<double>()(value.asNumber());
+        default:
+            return std::hash<std::string>()(value.asString());
+    }
+}
+
+/**
+ * Yoga passes NaN for undefined constraints, which must match itself.
+ */
+static inline bool
+sameConstraint(float lhs, float rhs)
+{
+    return lhs == rhs || (std::isnan(lhs) && std::isnan(rhs));
+}
+
+TextMeasureInput::TextMeasureInput(ComponentType type, std::vector<Object>&& values)
+    : mType(type),
+      mValues(std::move(values)),
+      mHash(std::hash<int>()(type))
+{
+    for (const auto& m : mValues)
+        mHash = combine(mHash, combine(std::hash<int>()(m.getType()), hashValue(m)));
+}
+
+bool
+TextMeasureInput::operator==(const TextMeasureInput& rhs) const
+{
+    return mHash == rhs.mHash && mType == rhs.mType && mValues == rhs.mValues;
+}
+
+bool
+TextMeasureCache::Key::operator==(const Key& rhs) const
+{
+    return (input == rhs.input || *input == *rhs.input) &&
+           sameConstraint(width, rhs.width) && sameConstraint(height, rhs.height) &&
+           widthMode == rhs.widthMode && heightMode == rhs.heightMode && baseline == rhs.baseline;
+}
+
+size_t
+TextMeasureCache::KeyHash::operator()(const Key& key) const
+{
+    auto result = key.input->hash();
+    result = combine(result, std::hash<float>()(std::isnan(key.width) ? 0 : key.width));
+    result = combine(result, std::hash<float>()(std::isnan(key.height) ? 0 : key.height));
+    result = combine(result, key.widthMode * 4 + key.heightMode);
+    return combine(result, key.baseline);
+}
+
+TextMeasureCache::TextMeasureCache(const TextMeasurementPtr& measurement, size_t capacity)
+    : mMeasurement(measurement),
+      mBatch(std::dynamic_pointer_cast<BatchTextMeasurement>(measurement)),
+      mCapacity(capacity)
+{
+}
+
+LayoutSize
+TextMeasureCache::measure(CoreComponent& component, float width, MeasureMode widthMode,
+                          float height, MeasureMode heightMode)
+{
+    if (mCapacity == 0 && !mBatchActive)
+        return mMeasurement->measure(&component, width, widthMode, height, heightMode);
+
+    Key key{component.getMeasureInput(), width, height, widthMode, heightMode, false};
+    auto cached = find(key);
+    if (cached)
+        return *cached;
+
+    if (mQueueing) {
+        queue(component, std::move(key));
+        return LayoutSize({0, 0});
+    }
+
+    auto size = mMeasurement->measure(&component, width, widthMode, height, heightMode);
+    store(std::move(key), size);
+    return size;
+}
+
+float
+TextMeasureCache::baseline(CoreComponent& component, float width, float height)
+{
+    if (mCapacity == 0 && !mBatchActive)
+        return mMeasurement->baseline(&component, width, height);
+
+    Key key{component.getMeasureInput(), width, height, Undefined, Undefined, true};
+    auto cached = find(key);
+    if (cached)
+        return cached->width;
+
+    if (mQueueing) {
+        // Sizes are not final while measurements are queued, so wait for a later pass
+        if (mQueuedMeasures == 0)
+            queue(component, std::move(key));
+        return 0;
+    }
+
+    auto baseline = mMeasurement->baseline(&component, width, height);
+    store(std::move(key), LayoutSize({baseline, 0}));
+    return baseline;
+}
+
+void
+TextMeasureCache::clear()
+{
+    mEntries.clear();
+    mIndex.clear();
+}
+
+void
+TextMeasureCache::beginBatch()
+{
+    mBatchActive = mBatch != nullptr;
+    mQueueing = mBatchActive;
+}
+
+bool
+TextMeasureCache::measureBatch()
+{
+    if (mQueue.empty())
+        return false;
+
+    // Baselines are requested at the size the component was laid out
+    std::vector<TextMeasureRequest> requests;
+    requests.reserve(mQueue.size());
+    for (const auto& m : mQueue) {
+        const auto& key = m.key;
+        requests.emplace_back(TextMeasureRequest{m.component.get(),
+                                                 key.width, key.baseline ? Exactly : key.widthMode,
+                                                 key.height, key.baseline ? Exactly : key.heightMode});
+    }
+
+    std::vector<TextMeasureResult> results;
+    mBatch->measureBatch(requests, results);
+    mBatches++;
+
+    auto pending = std::move(mQueue);
+    auto waiting = std::move(mWaiting);
+    mQueue.clear();
+    mWaiting.clear();
+    mQueued.clear();
+    mQueuedMeasures = 0;
+
+    if (results.size() != pending.size()) {
+        LOG(LogLevel::ERROR) << "Text measurement returned " << results.size() << " results for "
+                             << pending.size() << " requests";
+        mQueueing = false;
+    }
+
+    for (size_t i = 0 ; i < pending.size() && i < results.size() ; i++) {
+        auto& key = pending.at(i).key;
+        const auto& result = results.at(i);
+        if (key.baseline) {
+            store(std::move(key), LayoutSize({result.baseline, 0}));
+        }
+        else {
+            // Yoga usually asks for the baseline at the measured size
+            Key baselineKey{key.input, result.size.width, result.size.height, Undefined, Undefined, true};
+            if (!mResults.count(baselineKey))
+                store(std::move(baselineKey), LayoutSize({result.baseline, 0}));
+            store(std::move(key), result.size);
+        }
+    }
+
+    for (const auto& m : waiting)
+        if (!YGNodeIsDirty(m->getNode()))
+            YGNodeMarkDirty(m->getNode());
+
+    return true;
+}
+
+void
+TextMeasureCache::endBatch()
+{
+    mBatchActive = false;
+    mQueueing = false;
+    mQueuedMeasures = 0;
+    mQueue.clear();
+    mWaiting.clear();
+    mQueued.clear();
+    mResults.clear();
+}
+
+void
+TextMeasureCache::queue(CoreComponent& component, Key&& key)
+{
+    auto ptr = std::static_pointer_cast<CoreComponent>(component.shared_from_this());
+    mWaiting.emplace_back(ptr);
+
+    // Components with the same inputs share a request
+    if (!mQueued.insert(key).second)
+        return;
+
+    if (!key.baseline)
+        mQueuedMeasures++;
+
+    mQueue.emplace_back(Pending{std::move(ptr), std::move(key)});
+}
+
+const LayoutSize*
+TextMeasureCache::find(const Key& key)
+{
+    if (mBatchActive) {
+        auto it = mResults.find(key);
+        if (it != mResults.end()) {
+            mHits++;
+            return &it->second;
+        }
+    }
+
+    if (mCapacity == 0) {
+        mMisses++;
+        return nullptr;
+    }
+
+    auto it = mIndex.find(key);
+    if (it == mIndex.end()) {
+        mMisses++;
+        return nullptr;
+    }
+
+    mHits++;
+    mEntries.splice(mEntries.begin(), mEntries, it->second);
+    return &it->second->second;
+}
+
+void
+TextMeasureCache::store(Key&& key, const LayoutSize& size)
+{
+    if (mBatchActive)
+        mResults[key] = size;
+
+    if (mCapacity == 0)
+        return;
+
+    // A key may be stored again, for example a baseline derived from a batched measurement
+    auto it = mIndex.find(key);
+    if (it != mIndex.end()) {
+        it->second->second = size;
+        mEntries.splice(mEntries.begin(), mEntries, it->second);
+        return;
+    }
+
+    mEntries.emplace_front(std::move(key), size);
+    mIndex.emplace(mEntries.front().first, mEntries.begin());
+
+    while (mEntries.size() > mCapacity) {
+        mIndex.erase(mEntries.back().first);
+        mEntries.pop_back();
+    }
+}
+
+} // namespace apl
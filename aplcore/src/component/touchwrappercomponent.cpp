@@ -18,6 +18,7 @@
 #include "apl/component/yogaproperties.h"
 #include "apl/primitives/keyboard.h"
 #include "apl/time/sequencer.h"
+#include "apl/utils/arena.h"
 
 namespace apl {
 
@@ -25,7 +26,7 @@ CoreComponentPtr
 TouchWrapperComponent::create(const ContextPtr& context,
                               Properties&& properties,
                               const std::string& path) {
-    auto ptr = std::make_shared<TouchWrapperComponent>(context, std::move(properties), path);
+    auto ptr = allocateShared<TouchWrapperComponent>(context->arena(), context, std::move(properties), path);
     ptr->initialize();
     return ptr;
 }
@@ -19,6 +19,7 @@
 #include "apl/component/vectorgraphiccomponent.h"
 #include "apl/component/yogaproperties.h"
 #include "apl/graphic/graphic.h"
+#include "apl/utils/arena.h"
 
 namespace apl {
 
@@ -28,7 +29,7 @@ VectorGraphicComponent::create(const ContextPtr& context,
                                Properties&& properties,
                                const std::string& path)
 {
-    auto ptr = std::make_shared<VectorGraphicComponent>(context, std::move(properties), path);
+    auto ptr = allocateShared<VectorGraphicComponent>(context->arena(), context, std::move(properties), path);
     ptr->initialize();
     return ptr;
 }
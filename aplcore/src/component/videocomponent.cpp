@@ -17,6 +17,7 @@
 #include "apl/component/videocomponent.h"
 #include "apl/component/yogaproperties.h"
 #include "apl/time/sequencer.h"
+#include "apl/utils/arena.h"
 
 namespace apl {
 
@@ -26,7 +27,7 @@ VideoComponent::create(const ContextPtr& context,
                        Properties&& properties,
                        const std::string& path)
 {
-    auto ptr = std::make_shared<VideoComponent>(context, std::move(properties), path);
+    auto ptr = allocateShared<VideoComponent>(context->arena(), context, std::move(properties), path);
     ptr->initialize();
     return ptr;
 }
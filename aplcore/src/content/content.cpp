@@ -18,6 +18,7 @@
 #include "apl/engine/arrayify.h"
 #include "apl/engine/parameterarray.h"
 #include "apl/content/package.h"
+#include "apl/content/packagecache.h"
 #include "apl/engine/propdef.h"
 #include "apl/content/settings.h"
 #include "apl/content/importrequest.h"
@@ -148,13 +149,23 @@ Content::addPackage(const ImportRequest& request, JsonData&& raw) {
         return;
     }
 
-    mLoaded.emplace(request.reference(), ptr);
-    addExtensions(*ptr);
-    // Process the import list for this package
-    addImportList(*ptr);
+    loadPackage(request.reference(), ptr);
+
+    // A package is only shared once its import list is known to be valid
+    if (mState != ERROR)
+        PackageCache::instance().put(request.reference(), ptr);
+
     updateStatus();
 }
 
+void
+Content::loadPackage(const ImportRef& reference, const PackagePtr& package) {
+    mLoaded.emplace(reference, package);
+    addExtensions(*package);
+    // Process the import list for this package
+    addImportList(*package);
+}
+
 void Content::addData(const std::string& name, JsonData&& raw) {
     if (mState != LOADING)
         return;
@@ -208,6 +219,9 @@ Content::addImportList(Package& package) {
 
     const rapidjson::Value& value = package.json();
 
+    // A package taken from the PackageCache already has its dependencies recorded
+    bool recordDependencies = package.getDependencies().empty();
+
     auto it = value.FindMember(DOCUMENT_IMPORT);
     if (it != value.MemberEnd()) {
         if (!it->value.IsArray()) {
@@ -216,12 +230,12 @@ Content::addImportList(Package& package) {
             return;
         }
         for (const auto& v : it->value.GetArray())
-            addImport(package, v);
+            addImport(package, v, recordDependencies);
     }
 }
 
 void
-Content::addImport(Package& package, const rapidjson::Value& value) {
+Content::addImport(Package& package, const rapidjson::Value& value, bool recordDependency) {
     LOG_IF(DEBUG_CONTENT) << "addImport " << &package;
 
     if (!value.IsObject()) {
@@ -237,13 +251,18 @@ Content::addImport(Package& package, const rapidjson::Value& value) {
         return;
     }
 
-    package.addDependency(request.reference());
+    if (recordDependency)
+        package.addDependency(request.reference());
 
     if (mRequested.find(request) == mRequested.end() &&
         mPending.find(request) == mPending.end() &&
         mLoaded.find(request.reference()) == mLoaded.end()) {
-        // It is a new request
-        mRequested.insert(std::move(request));
+        // It is a new request.  Packages in the cache are loaded without asking the runtime.
+        auto cached = PackageCache::instance().get(request.reference());
+        if (cached)
+            loadPackage(request.reference(), cached);
+        else
+            mRequested.insert(std::move(request));
     }
 }
 
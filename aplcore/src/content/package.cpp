@@ -14,12 +14,14 @@
  */
 
 #include "apl/content/package.h"
+#include "apl/engine/styledefinition.h"
 #include "apl/utils/session.h"
 
 namespace apl {
 
 const char *DOCUMENT_TYPE = "type";
 const char *DOCUMENT_VERSION = "version";
+static const char *DOCUMENT_STYLES = "styles";
 
 PackagePtr
 Package::create(const SessionPtr& session, const std::string& name, JsonData&& json)
@@ -65,4 +67,20 @@ Package::type()
     return std::string(it_type->value.GetString());
 }
 
+const std::map<std::string, StyleBlocksPtr>&
+Package::styleBlocks() const
+{
+    std::call_once(mStyleBlocksFlag, [this]() {
+        const auto& json = mJson.get();
+        auto it = json.FindMember(DOCUMENT_STYLES);
+        if (it == json.MemberEnd() || !it->value.IsObject())
+            return;
+
+        for (const auto& m : it->value.GetObject())
+            mStyleBlocks.emplace(m.name.GetString(), std::make_shared<StyleBlocks>(m.value));
+    });
+
+    return mStyleBlocks;
+}
+
 } // namespace apl
\ No newline at end of file
@@ -0,0 +1,112 @@
+/**
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "apl/content/packagecache.h"
+
+namespace apl {
+
+PackageCache&
+PackageCache::instance()
+{
+    static PackageCache *sCache = new PackageCache();
+    return *sCache;
+}
+
+PackagePtr
+PackageCache::get(const ImportRef& reference)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mCapacity == 0)
+        return nullptr;
+
+    auto it = mIndex.find(reference);
+    if (it == mIndex.end()) {
+        mMisses++;
+        return nullptr;
+    }
+
+    mHits++;
+    mEntries.splice(mEntries.begin(), mEntries, it->second);
+    return it->second->second;
+}
+
+void
+PackageCache::put(const ImportRef& reference, const PackagePtr& package)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mCapacity == 0 || mIndex.find(reference) != mIndex.end())
+        return;
+
+    mEntries.emplace_front(reference, package);
+    mIndex.emplace(reference, mEntries.begin());
+    trim();
+}
+
+void
+PackageCache::setCapacity(size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mCapacity = capacity;
+    trim();
+}
+
+void
+PackageCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mEntries.clear();
+    mIndex.clear();
+    mHits = 0;
+    mMisses = 0;
+}
+
+size_t
+PackageCache::capacity() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mCapacity;
+}
+
+size_t
+PackageCache::size() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mEntries.size();
+}
+
+unsigned long
+PackageCache::hits() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mHits;
+}
+
+unsigned long
+PackageCache::misses() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mMisses;
+}
+
+void
+PackageCache::trim()
+{
+    while (mEntries.size() > mCapacity) {
+        mIndex.erase(mEntries.back().first);
+        mEntries.pop_back();
+    }
+}
+
+} // namespace apl
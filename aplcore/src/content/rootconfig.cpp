@@ -39,6 +39,9 @@ RootConfig::RootConfig()
       mDefaultThemeFontColor({{"light", 0x1e2222ff}, {"dark", 0xfafafaff}}),
       mDefaultThemeHighlightColor({{"light", 0x0070ba4d}, {"dark",  0x00caff4d}}),
       mTrackProvenance(true),
+      mArenaAllocation(false),
+      mLazySequenceInflation(false),
+      mTextMeasurementCacheSize(0),
       mDefaultComponentSize({
           // Set default sizes for components that aren't "auto" width and "auto" height.
         {{kComponentTypeImage, true}, {Dimension(100), Dimension(100)}},
@@ -0,0 +1,281 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cassert>
+
+#include "apl/datagrammar/bytecode.h"
+#include "apl/datagrammar/node.h"
+
+namespace apl {
+namespace datagrammar {
+
+// The value stack is shared by all byte code executing on a thread.  Each evaluation
+// works above the current top of the stack, so nested evaluations are safe.
+static thread_local std::vector<Object> sStack;
+
+/**
+ * Restore the value stack to its original size when an evaluation finishes (or throws).
+ */
+class StackGuard {
+public:
+    StackGuard(std::vector<Object>& stack) : mStack(stack), mBase(stack.size()) {}
+    ~StackGuard() { mStack.resize(mBase); }
+
+private:
+    std::vector<Object>& mStack;
+    size_t mBase;
+};
+
+/**
+ * String concatenation of a range of values, skipping empty strings.  This matches the
+ * behavior of the "combine" operator in the Node tree.
+ */
+static Object
+combine(std::vector<Object>::const_iterator begin, std::vector<Object>::const_iterator end)
+{
+    std::string result;
+    for (auto it = begin ; it != end ; it++) {
+        if (it->isString() && it->getString().empty())
+            continue;
+        result += it->asString();
+    }
+    return result;
+}
+
+ByteCodePtr
+ByteCode::compile(const Object& equation)
+{
+    if (!equation.isEvaluable())
+        return nullptr;
+
+    auto byteCode = std::make_shared<ByteCode>();
+    byteCode->compileObject(equation);
+    return byteCode;
+}
+
+void
+ByteCode::compileObject(const Object& object)
+{
+    if (object.isNode())
+        compileNode(object);
+    else if (object.isBoundSymbol())
+        emitData(kByteCodeEvaluate, object);
+    else
+        emitData(kByteCodeLoadConstant, object);
+}
+
+void
+ByteCode::compileNode(const Object& object)
+{
+    auto node = object.getNode();
+    auto description = describeOperator(node->op());
+
+    // Unknown operators fall back to the tree walker
+    if (!description) {
+        emitData(kByteCodeEvaluate, object);
+        return;
+    }
+
+    const auto& args = node->args();
+    auto start = mInstructions.size();
+
+    switch (description->kind) {
+        case kOperatorUnary:
+            compileObject(args.at(0));
+            if (isConstant(start, 1))
+                emitData(kByteCodeLoadConstant, description->unary(popConstant()));
+            else
+                emit(kByteCodeUnary, 0, description->unary);
+            break;
+
+        case kOperatorBinary:
+            compileObject(args.at(0));
+            compileObject(args.at(1));
+            if (isConstant(start, 2)) {
+                auto b = popConstant();
+                auto a = popConstant();
+                emitData(kByteCodeLoadConstant, description->binary(a, b));
+            }
+            else
+                emit(kByteCodeBinary, 0, nullptr, description->binary);
+            break;
+
+        case kOperatorTernary:
+            compileObject(args.at(0));
+            if (isConstant(start, 1)) {
+                compileObject(args.at(popConstant().asBoolean() ? 1 : 2));
+            }
+            else {
+                auto jumpToFalse = mInstructions.size();
+                emit(kByteCodePopJumpIfFalse);
+                compileObject(args.at(1));
+                auto jumpToEnd = mInstructions.size();
+                emit(kByteCodeJump);
+                mInstructions.at(jumpToFalse).value = mInstructions.size();
+                compileObject(args.at(2));
+                mInstructions.at(jumpToEnd).value = mInstructions.size();
+            }
+            break;
+
+        case kOperatorCombine:
+            for (const auto& m : args)
+                compileObject(m);
+            if (isConstant(start, args.size())) {
+                std::vector<Object> values(args.size());
+                for (auto it = values.rbegin() ; it != values.rend() ; it++)
+                    *it = popConstant();
+                emitData(kByteCodeLoadConstant, combine(values.begin(), values.end()));
+            }
+            else
+                emit(kByteCodeCombine, args.size());
+            break;
+
+        case kOperatorFunctionCall: {
+            // Function calls are never folded; the function may not be pure.  The arguments are
+            // only evaluated if the function is callable.
+            compileObject(args.at(0));
+            auto jumpToEnd = mInstructions.size();
+            emit(kByteCodeJumpIfNotCallable);
+            const auto& arguments = args.at(1);
+            assert(arguments.isArray());
+            for (size_t i = 0 ; i < arguments.size() ; i++)
+                compileObject(arguments.at(i));
+            emit(kByteCodeCall, arguments.size());
+            mInstructions.at(jumpToEnd).value = mInstructions.size();
+        }
+            break;
+    }
+}
+
+void
+ByteCode::emit(ByteCodeOpcode opcode, int value, UnaryCalculation unary, BinaryCalculation binary)
+{
+    mInstructions.emplace_back(ByteCodeInstruction{opcode, value, unary, binary});
+}
+
+void
+ByteCode::emitData(ByteCodeOpcode opcode, const Object& object)
+{
+    mData.emplace_back(object);
+    emit(opcode, mData.size() - 1);
+}
+
+bool
+ByteCode::isConstant(size_t start, size_t count) const
+{
+    if (mInstructions.size() - start != count)
+        return false;
+
+    for (auto i = start ; i < mInstructions.size() ; i++)
+        if (mInstructions.at(i).opcode != kByteCodeLoadConstant)
+            return false;
+
+    return true;
+}
+
+Object
+ByteCode::popConstant()
+{
+    assert(!mInstructions.empty() && mInstructions.back().opcode == kByteCodeLoadConstant);
+    auto index = mInstructions.back().value;
+    mInstructions.pop_back();
+
+    auto result = mData.at(index);
+    if (index == mData.size() - 1)
+        mData.pop_back();
+    return result;
+}
+
+Object
+ByteCode::eval() const
+{
+    auto& stack = sStack;
+    StackGuard guard(stack);
+
+    const auto count = mInstructions.size();
+    for (size_t pc = 0 ; pc < count ; pc++) {
+        const auto& instruction = mInstructions[pc];
+        switch (instruction.opcode) {
+            case kByteCodeLoadConstant:
+                stack.emplace_back(mData[instruction.value]);
+                break;
+
+            case kByteCodeEvaluate:
+                stack.emplace_back(mData[instruction.value].eval());
+                break;
+
+            case kByteCodeUnary:
+                stack.back() = instruction.unary(stack.back());
+                break;
+
+            case kByteCodeBinary: {
+                auto result = instruction.binary(stack[stack.size() - 2], stack.back());
+                stack.pop_back();
+                stack.back() = std::move(result);
+            }
+                break;
+
+            case kByteCodeCombine: {
+                auto start = stack.end() - instruction.value;
+                auto result = combine(start, stack.end());
+                stack.erase(start, stack.end());
+                stack.emplace_back(std::move(result));
+            }
+                break;
+
+            case kByteCodeCall: {
+                auto start = stack.end() - instruction.value;
+                ObjectArray arguments(start, stack.end());
+                stack.erase(start, stack.end());
+                auto function = std::move(stack.back());
+                stack.back() = function.call(arguments);
+            }
+                break;
+
+            case kByteCodeJumpIfNotCallable:
+                if (!stack.back().isCallable()) {
+                    stack.back() = Object::NULL_OBJECT();
+                    pc = instruction.value - 1;
+                }
+                break;
+
+            case kByteCodeJump:
+                pc = instruction.value - 1;
+                break;
+
+            case kByteCodePopJumpIfFalse: {
+                auto value = stack.back().asBoolean();
+                stack.pop_back();
+                if (!value)
+                    pc = instruction.value - 1;
+            }
+                break;
+        }
+    }
+
+    assert(!stack.empty());
+    Object result = std::move(stack.back());
+    return result;
+}
+
+std::string
+ByteCode::toDebugString() const
+{
+    return "ByteCode<instructions=" + std::to_string(mInstructions.size()) +
+           " data=" + std::to_string(mData.size()) + ">";
+}
+
+} // namespace datagrammar
+} // namespace apl
@@ -0,0 +1,137 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "apl/datagrammar/expressioncache.h"
+#include "apl/datagrammar/databindingrules.h"
+
+namespace apl {
+namespace datagrammar {
+
+namespace pegtl = tao::TAO_PEGTL_NAMESPACE;
+
+const size_t ExpressionCache::DEFAULT_CAPACITY;
+
+ExpressionCache&
+ExpressionCache::instance()
+{
+    static ExpressionCache *sCache = new ExpressionCache();
+    return *sCache;
+}
+
+CompiledExpressionPtr
+ExpressionCache::compile(const std::string& source)
+{
+    auto result = std::make_shared<CompiledExpression>();
+
+    try {
+        Stacks stacks;
+        pegtl::string_input<> in(source, "");
+        pegtl::parse<grammar, action>(in, stacks);
+        result->expression = stacks.finish();
+    }
+    catch (pegtl::parse_error e) {
+        result->error = e.what();
+    }
+
+    return result;
+}
+
+CompiledExpressionPtr
+ExpressionCache::get(const std::string& source)
+{
+    if (source.find("${") == std::string::npos)
+        return compile(source);
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto it = mIndex.find(source);
+        if (it != mIndex.end()) {
+            mHits++;
+            mEntries.splice(mEntries.begin(), mEntries, it->second);
+            return it->second->second;
+        }
+        mMisses++;
+    }
+
+    // Compile outside of the lock; another thread may race us to store the same string
+    auto result = compile(source);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mCapacity > 0 && mIndex.find(source) == mIndex.end()) {
+        mEntries.emplace_front(source, result);
+        mIndex.emplace(source, mEntries.begin());
+        trim();
+    }
+
+    return result;
+}
+
+void
+ExpressionCache::setCapacity(size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mCapacity = capacity;
+    trim();
+}
+
+void
+ExpressionCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mEntries.clear();
+    mIndex.clear();
+    mHits = 0;
+    mMisses = 0;
+}
+
+size_t
+ExpressionCache::capacity() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mCapacity;
+}
+
+size_t
+ExpressionCache::size() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mEntries.size();
+}
+
+unsigned long
+ExpressionCache::hits() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mHits;
+}
+
+unsigned long
+ExpressionCache::misses() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mMisses;
+}
+
+void
+ExpressionCache::trim()
+{
+    while (mEntries.size() > mCapacity) {
+        mIndex.erase(mEntries.back().first);
+        mEntries.pop_back();
+    }
+}
+
+} // namespace datagrammar
+} // namespace apl
@@ -0,0 +1,142 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "apl/datagrammar/expressiontemplate.h"
+#include "apl/datagrammar/functions.h"
+#include "apl/engine/context.h"
+#include "apl/primitives/dimension.h"
+
+namespace apl {
+namespace datagrammar {
+
+ExpressionTemplatePtr
+ExpressionTemplate::constant(const Object& value)
+{
+    return std::make_shared<ExpressionTemplate>(kConstant, value, nullptr,
+                                                std::vector<ExpressionTemplatePtr>{}, "");
+}
+
+ExpressionTemplatePtr
+ExpressionTemplate::symbol(const std::string& name)
+{
+    return std::make_shared<ExpressionTemplate>(kSymbol, Object(name), nullptr,
+                                                std::vector<ExpressionTemplatePtr>{}, "Symbol");
+}
+
+ExpressionTemplatePtr
+ExpressionTemplate::resource(const std::string& name)
+{
+    return std::make_shared<ExpressionTemplate>(kResource, Object(name), nullptr,
+                                                std::vector<ExpressionTemplatePtr>{}, "Resource");
+}
+
+ExpressionTemplatePtr
+ExpressionTemplate::dimension(const std::string& value)
+{
+    return std::make_shared<ExpressionTemplate>(kDimension, Object(value), nullptr,
+                                                std::vector<ExpressionTemplatePtr>{}, "Dimension");
+}
+
+ExpressionTemplatePtr
+ExpressionTemplate::vector(std::vector<ExpressionTemplatePtr>&& children)
+{
+    return std::make_shared<ExpressionTemplate>(kVector, Object::NULL_OBJECT(), nullptr,
+                                                std::move(children), "vector");
+}
+
+ExpressionTemplatePtr
+ExpressionTemplate::op(CreateFunction func,
+                       std::vector<ExpressionTemplatePtr>&& children,
+                       const std::string& name)
+{
+    // Function calls are never folded; the function itself is a symbol lookup
+    bool foldable = func != FunctionCall;
+    for (const auto& m : children)
+        foldable = foldable && m->type() == kConstant;
+
+    if (foldable) {
+        std::vector<Object> args;
+        args.reserve(children.size());
+        for (const auto& m : children)
+            args.emplace_back(m->value());
+
+        auto result = func(std::move(args));
+        if (!result.isEvaluable())
+            return constant(result);
+    }
+
+    return std::make_shared<ExpressionTemplate>(kOperator, Object::NULL_OBJECT(), func,
+                                                std::move(children), name);
+}
+
+Object
+ExpressionTemplate::bind(const Context& context) const
+{
+    switch (mType) {
+        case kConstant:
+            return mValue;
+
+        case kSymbol:
+        case kResource:
+            return Symbol(context, std::vector<Object>{mValue}, mName);
+
+        case kDimension:
+            return Object(Dimension(context, mValue.getString()));
+
+        case kVector: {
+            auto v = std::make_shared<std::vector<Object>>();
+            v->reserve(mChildren.size());
+            for (const auto& m : mChildren)
+                v->emplace_back(m->bind(context));
+            return Object(v);
+        }
+
+        case kOperator: {
+            std::vector<Object> args;
+            args.reserve(mChildren.size());
+            for (const auto& m : mChildren)
+                args.emplace_back(m->bind(context));
+            return mFunc(std::move(args));
+        }
+    }
+
+    return Object::NULL_OBJECT();
+}
+
+std::string
+ExpressionTemplate::toDebugString() const
+{
+    switch (mType) {
+        case kConstant:
+            return mValue.toDebugString();
+        case kSymbol:
+        case kResource:
+        case kDimension:
+            return mName + "<" + mValue.getString() + ">";
+        case kVector:
+        case kOperator:
+            return "Template<" + mName + ">";
+    }
+
+    return "";
+}
+
+streamer& operator<<(streamer& os, const ExpressionTemplate& expressionTemplate) {
+    os << expressionTemplate.toDebugString();
+    return os;
+}
+
+} // namespace datagrammar
+} // namespace apl
@@ -15,8 +15,10 @@
 
 #include <cassert>
 #include <cmath>
+#include <map>
 
 #include "apl/datagrammar/boundsymbol.h"
+#include "apl/datagrammar/functions.h"
 #include "apl/datagrammar/node.h"
 #include "apl/engine/context.h"
 #include "apl/primitives/dimension.h"
@@ -900,5 +902,38 @@ FunctionCall(std::vector<Object>&& args)
     return a.call(std::move(argArray));
 }
 
+const OperatorDescription*
+describeOperator(OperatorFunc func)
+{
+    static const std::map<OperatorFunc, OperatorDescription> sDescriptions = {
+        {Unary<CalculateUnaryPlus>,      {kOperatorUnary, CalculateUnaryPlus, nullptr}},
+        {Unary<CalculateUnaryMinus>,     {kOperatorUnary, CalculateUnaryMinus, nullptr}},
+        {Unary<CalculateUnaryNot>,       {kOperatorUnary, CalculateUnaryNot, nullptr}},
+        {Unary<CalculateUnaryTruthy>,    {kOperatorUnary, CalculateUnaryTruthy, nullptr}},
+        {Binary<CalculateMultiply>,      {kOperatorBinary, nullptr, CalculateMultiply}},
+        {Binary<CalculateDivide>,        {kOperatorBinary, nullptr, CalculateDivide}},
+        {Binary<CalculateRemainder>,     {kOperatorBinary, nullptr, CalculateRemainder}},
+        {Binary<CalculateAdd>,           {kOperatorBinary, nullptr, CalculateAdd}},
+        {Binary<CalculateSubtract>,      {kOperatorBinary, nullptr, CalculateSubtract}},
+        {Binary<CalculateLessThan>,      {kOperatorBinary, nullptr, CalculateLessThan}},
+        {Binary<CalculateGreaterThan>,   {kOperatorBinary, nullptr, CalculateGreaterThan}},
+        {Binary<CalculateLessEqual>,     {kOperatorBinary, nullptr, CalculateLessEqual}},
+        {Binary<CalculateGreaterEqual>,  {kOperatorBinary, nullptr, CalculateGreaterEqual}},
+        {Binary<CalculateEqual>,         {kOperatorBinary, nullptr, CalculateEqual}},
+        {Binary<CalculateNotEqual>,      {kOperatorBinary, nullptr, CalculateNotEqual}},
+        {Binary<CalculateAnd>,           {kOperatorBinary, nullptr, CalculateAnd}},
+        {Binary<CalculateOr>,            {kOperatorBinary, nullptr, CalculateOr}},
+        {Binary<CalculateNullc>,         {kOperatorBinary, nullptr, CalculateNullc}},
+        {ApplyFieldAccess,               {kOperatorBinary, nullptr, CalcFieldAccess}},
+        {ApplyArrayAccess,               {kOperatorBinary, nullptr, CalcArrayAccess}},
+        {EvalUnaryTernary,               {kOperatorTernary, nullptr, nullptr}},
+        {EvalCombine,                    {kOperatorCombine, nullptr, nullptr}},
+        {EvalFunctionCall,               {kOperatorFunctionCall, nullptr, nullptr}},
+    };
+
+    auto it = sDescriptions.find(func);
+    return it != sDescriptions.end() ? &it->second : nullptr;
+}
+
 }  // namespace datagrammar
 }  // namespace apl
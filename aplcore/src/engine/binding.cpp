@@ -47,5 +47,26 @@ const std::map<BindingType, BindingFunction> sBindingFunctions = {
     {kBindingTypeString,    [](const Context& c, const Object& v) { return v.asString(); }},
 };
 
+const Bimap<TimeGranularity, std::string> sTimeGranularityMap = {
+    {kTimeGranularityFrame, "frame"},
+    {kTimeGranularitySecond, "second"},
+    {kTimeGranularityMinute, "minute"},
+};
+
+double
+timeGranularityPeriod(TimeGranularity granularity)
+{
+    switch (granularity) {
+        case kTimeGranularitySecond: return 1000;
+        case kTimeGranularityMinute: return 60000;
+        default: return 0;
+    }
+}
+
+std::string
+timeGranularityKey(const std::string& symbol, TimeGranularity granularity)
+{
+    return symbol + "#" + sTimeGranularityMap.at(granularity);
+}
 
 } // namespace apl
@@ -21,22 +21,12 @@
 
 #include "apl/engine/binding.h"
 #include "apl/engine/builder.h"
+#include "apl/engine/childinflater.h"
+#include "apl/engine/componenttemplate.h"
 #include "apl/engine/context.h"
 #include "apl/engine/contextdependant.h"
 #include "apl/engine/arrayify.h"
 #include "apl/engine/evaluate.h"
-#include "apl/component/containercomponent.h"
-#include "apl/component/edittextcomponent.h"
-#include "apl/component/framecomponent.h"
-#include "apl/component/gridsequencecomponent.h"
-#include "apl/component/imagecomponent.h"
-#include "apl/component/pagercomponent.h"
-#include "apl/component/scrollviewcomponent.h"
-#include "apl/component/sequencecomponent.h"
-#include "apl/component/textcomponent.h"
-#include "apl/component/touchwrappercomponent.h"
-#include "apl/component/vectorgraphiccomponent.h"
-#include "apl/component/videocomponent.h"
 #include "apl/content/rootconfig.h"
 #include "apl/engine/properties.h"
 #include "apl/engine/parameterarray.h"
@@ -51,27 +41,9 @@ namespace apl {
 
 const bool DEBUG_BUILDER = false;
 
-
-using MakeComponentFunc = CoreComponentPtr (*)(const ContextPtr&, Properties&&, const std::string&);
-
-static const std::map<std::string, MakeComponentFunc> sComponentMap = {
-    {"Container",     ContainerComponent::create},
-    {"Text",          TextComponent::create},
-    {"Image",         ImageComponent::create},
-    {"ScrollView",    ScrollViewComponent::create},
-    {"EditText",      EditTextComponent::create},
-    {"Frame",         FrameComponent::create},
-    {"Sequence",      SequenceComponent::create},
-    {"GridSequence",  GridSequenceComponent::create},
-    {"TouchWrapper",  TouchWrapperComponent::create},
-    {"Pager",         PagerComponent::create},
-    {"VectorGraphic", VectorGraphicComponent::create},
-    {"Video",         VideoComponent::create}
-};
-
 void
 Builder::populateSingleChildLayout(const ContextPtr& context,
-                                   const Object& item,
+                                   const ComponentTemplate& item,
                                    const CoreComponentPtr& layout,
                                    const Path& path)
 {
@@ -79,16 +51,16 @@ Builder::populateSingleChildLayout(const ContextPtr& context,
 
     Properties props;
     auto child = expandSingleComponentFromArray(context,
-                                                arrayifyProperty(*context, item, "item", "items"),
+                                                *item.items().get(*context),
                                                 props,
                                                 layout,
-                                                path.addProperty(item, "item", "items"));
+                                                path.addProperty(item.item(), "item", "items"));
     layout->appendChild(child, false);
 }
 
 void
 Builder::populateLayoutComponent(const ContextPtr& context,
-                                 const Object& item,
+                                 const ComponentTemplate& item,
                                  const CoreComponentPtr& layout,
                                  const Path& path)
 {
@@ -97,10 +69,10 @@ Builder::populateLayoutComponent(const ContextPtr& context,
     Properties firstProps;
 
     auto child = expandSingleComponentFromArray(context,
-                                                arrayifyProperty(*context, item, "firstItem"),
+                                                *item.firstItem().get(*context),
                                                 firstProps,
                                                 layout,
-                                                path.addProperty(item, "firstItem"));
+                                                path.addProperty(item.item(), "firstItem"));
     bool hasFirstItem = false;
     if (child && child->isValid()) {
         hasFirstItem = true;
@@ -108,15 +80,14 @@ Builder::populateLayoutComponent(const ContextPtr& context,
     }
 
     bool numbered = layout->getCalculated(kPropertyNumbered).asBoolean();
-    int ordinal = 1;
-    int index = 0;
 
     std::shared_ptr<LayoutRebuilder> layoutBuilder = nullptr;  // Reserve space for now.  In the future, move all logic in
+    std::shared_ptr<ChildInflater> inflater;
 
-    const auto items = arrayifyProperty(*context, item, "item", "items");
-    if (!items.empty()) {
-        auto childPath = path.addProperty(item, "item", "items");
-        auto data = arrayifyPropertyAsObject(*context, item, "data");
+    const auto items = item.items().get(*context);
+    if (!items->empty()) {
+        auto childPath = path.addProperty(item.item(), "item", "items");
+        auto data = arrayifyPropertyAsObject(*context, item.item(), "data");
 
         auto liveData = data.getLiveDataObject();
         if (liveData && liveData->asArray()) {
@@ -125,75 +96,24 @@ Builder::populateLayoutComponent(const ContextPtr& context,
         }
         else {
             auto dataItems = evaluateRecursive(*context, data);
-            if (!dataItems.empty()) {
-                LOG_IF(DEBUG_BUILDER) << "data size=" << dataItems.size();
-                auto length = dataItems.size();
-                for (size_t dataIndex = 0; dataIndex < length; dataIndex++) {
-                    const auto& dataItem = dataItems.at(dataIndex);
-                    auto childContext = Context::create(context);
-                    childContext->putConstant("data", dataItem);
-                    childContext->putConstant("index", index);
-                    childContext->putConstant("length", length);
-                    if (numbered)
-                        childContext->putConstant("ordinal", ordinal);
-
-                    Properties childProps;
-                    child = expandSingleComponentFromArray(childContext,
-                                                           items,
-                                                           childProps,
-                                                           layout, childPath);
-                    if (child && child->isValid()) {
-                        layout->appendChild(child, false);
-                        index++;
-
-                        if (numbered) {
-                            int numbering = child->getCalculated(kPropertyNumbering).getInteger();
-                            if (numbering == kNumberingNormal) ordinal++;
-                            else if (numbering == kNumberingReset) ordinal = 1;
-                        }
-                    }
-                }
+            LOG_IF(DEBUG_BUILDER) << "data size=" << dataItems.size() << " items size=" << items->size();
+            inflater = std::make_shared<ChildInflater>(context, layout, items, dataItems, childPath, numbered);
+            if (layout->supportsLazyInflation() && context->getRootConfig().getLazySequenceInflation()) {
+                // Only the first child is inflated now; layout inflates the rest as it needs them
+                inflater->inflateNext(false);
             }
-                // TODO: A list of children.  Ignore the data object???  Or add to context??
             else {
-                LOG_IF(DEBUG_BUILDER) << "items size=" << items.size();
-                auto length = items.size();
-                for (int i = 0; i < length; i++) {
-                    const auto& element = items.at(i);
-                    auto childContext = Context::create(context);
-                    childContext->putConstant("index", index);
-                    childContext->putConstant("length", length);
-                    if (numbered)
-                        childContext->putConstant("ordinal", ordinal);
-
-                    // TODO: Numbered, spacing, ordinal changes
-                    Properties childProps;
-                    child = expandSingleComponentFromArray(childContext,
-                                                           arrayify(*context, element),
-                                                           childProps,
-                                                           layout,
-                                                           childPath.addIndex(i));
-                    if (child && child->isValid()) {
-                        layout->appendChild(child, false);
-                        index++;
-
-                        if (numbered) {
-                            int numbering = child->getCalculated(kPropertyNumbering).getInteger();
-                            if (numbering == kNumberingNormal) ordinal++;
-                            else if (numbering == kNumberingReset) ordinal = 1;
-                        }
-                    }
-                }
+                inflater->inflateAll(false);
             }
         }
     }
 
     Properties lastProps;
     child = expandSingleComponentFromArray(context,
-                                           arrayifyProperty(*context, item, "lastItem"),
+                                           *item.lastItem().get(*context),
                                            lastProps,
                                            layout,
-                                           path.addProperty(item, "lastItem"));
+                                           path.addProperty(item.item(), "lastItem"));
 
     bool hasLastItem = false;
     if (child && child->isValid()) {
@@ -206,63 +126,69 @@ Builder::populateLayoutComponent(const ContextPtr& context,
 
     if (layoutBuilder)
         layoutBuilder->setFirstLast(hasFirstItem, hasLastItem);
+
+    if (inflater && !inflater->done()) {
+        inflater->setHasLastItem(hasLastItem);
+        layout->attachInflater(inflater);
+    }
 }
 
 /**
  * Expand a single component or layout by type.
  *
  * @param context Current data-binding context
- * @param item The JSON-definition of the item to expand.
+ * @param item The compiled definition of the item to expand.
  * @param properties The user-specified properties for this component
  * @param parent The parent component of this component
  * @param path The path of this component
  */
 CoreComponentPtr
 Builder::expandSingleComponent(const ContextPtr& context,
-                               const Object& item,
+                               const ComponentTemplate& item,
                                Properties& properties,
                                const CoreComponentPtr& parent,
                                const Path& path)
 {
     LOG_IF(DEBUG_BUILDER) << path.toString();
 
-    std::string type = propertyAsString(*context, item, "type");
+    std::string type = item.type(*context);
     if (type.empty()) {
         CONSOLE_CTP(context) << "Invalid type in component";
         return nullptr;
     }
 
-    auto method = sComponentMap.find(type);
-    if (method != sComponentMap.end()) {
+    auto method = item.factory(type);
+    if (method) {
         LOG_IF(DEBUG_BUILDER) << "Expanding primitive " << type;
 
         // Copy the items into the properties map.
-        properties.emplace(item);
+        properties.emplace(item.properties());
 
         // Create a new context and fill out the binding
         ContextPtr expanded = Context::create(context);
-        auto bindings = arrayifyProperty(*context, item, "bind");
-        for (const auto& binding : bindings) {
-            auto name = propertyAsString(*expanded, binding, "name");
-            if (name.empty() || !binding.has("value"))
+        auto bindings = item.bindings(*context);
+        for (const auto& binding : *bindings) {
+            auto name = binding.name(*expanded);
+            if (name.empty() || !binding.hasValue())
                 continue;
 
             // Extract the binding as an optional node tree.
-            auto tmp = propertyAsNode(*expanded, binding, "value");
+            const auto& raw = binding.value();
+            auto tmp = raw.isString() ? parseDataBinding(*expanded, raw.getString()) : raw;
             auto value = evaluate(*expanded, tmp);
-            auto bindingType = propertyAsMapped<BindingType>(*expanded, binding, "type", kBindingTypeAny, sBindingMap);
-            auto bindingFunc = sBindingFunctions.at(bindingType);
+            auto bindingFunc = sBindingFunctions.at(binding.type(*expanded));
 
             // Store the value in the new context.  Binding values are mutable; they can be changed later.
             expanded->putUserWriteable(name, bindingFunc(*expanded, value));
 
             // If it is a node, we connect up the symbols that it is dependant upon
             if (tmp.isEvaluable())
-                ContextDependant::create(expanded, name, tmp, expanded, bindingFunc);
+                ContextDependant::create(expanded, name, tmp, expanded, bindingFunc,
+                                         binding.granularity(*expanded));
         }
 
         // Construct the component
-        CoreComponentPtr component = CoreComponentPtr(method->second(expanded, std::move(properties), path.toString()));
+        CoreComponentPtr component = CoreComponentPtr(method(expanded, std::move(properties), path.toString()));
         if (!component) {
             CONSOLE_CTP(context) << "Unable to inflate component";
             return nullptr;
@@ -279,10 +205,10 @@ Builder::expandSingleComponent(const ContextPtr& context,
     }
 
     LOG_IF(DEBUG_BUILDER) << "Expanding layout '" << type << "'";
-    auto resource = context->getLayout(type);
-    if (!resource.empty()) {
-        properties.emplace(item);
-        return expandLayout(context, properties, resource.json(), parent, resource.path());
+    auto layout = context->getLayoutTemplate(type);
+    if (layout) {
+        properties.emplace(item.properties());
+        return expandLayout(context, properties, *layout, parent, layout->path());
     }
 
     CONSOLE_CTP(context) << "Unable to find layout or component '" << type << "'";
@@ -293,14 +219,14 @@ Builder::expandSingleComponent(const ContextPtr& context,
  * Expand a single component from a "when" list of possible components
  *
  * @param context Current data-binding context
- * @param items A vector of the components to expand
+ * @param items A vector of the compiled components to expand
  * @param properties The user-specified properties for this component
  * @param parent The parent component of this component
  * @param path The path description of this component
  */
 CoreComponentPtr
 Builder::expandSingleComponentFromArray(const ContextPtr& context,
-                                        const std::vector<Object>& items,
+                                        const ComponentTemplateList& items,
                                         Properties& properties,
                                         const CoreComponentPtr& parent,
                                         const Path& path)
@@ -308,11 +234,11 @@ Builder::expandSingleComponentFromArray(const ContextPtr& context,
     LOG_IF(DEBUG_BUILDER) << path;
     for (int index = 0; index < items.size(); index++) {
         const auto& item = items.at(index);
-        if (!item.isMap())
+        if (!item->isValid())
             continue;
 
-        if (propertyAsBoolean(*context, item, "when", true))
-            return expandSingleComponent(context, item, properties, parent, path.addIndex(index));
+        if (item->when(*context))
+            return expandSingleComponent(context, *item, properties, parent, path.addIndex(index));
     }
 
     return nullptr;
@@ -324,18 +250,17 @@ Builder::expandSingleComponentFromArray(const ContextPtr& context,
  *
  * @param context Current data-binding context.
  * @param properties The user-specified properties for this layout.
- * @param layout The JSON definition of the layout object.
+ * @param layout The compiled layout.
  * @param parent The parent component of this layout.
  */
 CoreComponentPtr
 Builder::expandLayout(const ContextPtr& context,
                       Properties& properties,
-                      const rapidjson::Value& layout,
+                      const LayoutTemplate& layout,
                       const CoreComponentPtr& parent,
                       const Path& path)
 {
     LOG_IF(DEBUG_BUILDER) << path;
-    assert(layout.IsObject());
 
     // Build a new context for this layout.
     ContextPtr cptr = Context::create(context);
@@ -343,8 +268,7 @@ Builder::expandLayout(const ContextPtr& context,
     // Add each parameter to the context.  It's either going to come from
     // a property or its default value.  This will remove the matching property from
     // the property map.
-    ParameterArray params(layout);
-    for (const auto& param : params) {
+    for (const auto& param : layout.parameters()) {
         LOG_IF(DEBUG_BUILDER) << "Parsing parameter: " << param.name;
         properties.addToContext(cptr, param, true);
     }
@@ -356,10 +280,10 @@ Builder::expandLayout(const ContextPtr& context,
         }
     }
     return expandSingleComponentFromArray(cptr,
-                                          arrayifyProperty(*cptr, layout, "item", "items"),
+                                          *layout.items().get(*cptr),
                                           properties,
                                           parent,
-                                          path.addProperty(layout, "item", "items"));
+                                          path.addProperty(layout.layout(), "item", "items"));
 }
 
 
@@ -369,7 +293,8 @@ Builder::inflate(const ContextPtr& context,
                  Properties& mainProperties,
                  const rapidjson::Value& mainDocument)
 {
-    return expandLayout(context, mainProperties, mainDocument, nullptr,
+    assert(mainDocument.IsObject());
+    return expandLayout(context, mainProperties, LayoutTemplate(mainDocument), nullptr,
         Path(context->getRootConfig().getTrackProvenance() ? std::string(Path::MAIN) + "/mainTemplate" : ""));
 }
 
@@ -381,10 +306,10 @@ Builder::inflate(const ContextPtr& context,
 
     Properties p;
     if (component.isMap())
-        return expandSingleComponent(context, component, p, nullptr,
+        return expandSingleComponent(context, *ComponentTemplate::create(component), p, nullptr,
             Path(context->getRootConfig().getTrackProvenance() ? "_virtual" : ""));
     else if (component.isArray())
-        return expandSingleComponentFromArray(context, component.getArray(), p, nullptr,
+        return expandSingleComponentFromArray(context, *ComponentTemplate::create(component.getArray()), p, nullptr,
             Path(context->getRootConfig().getTrackProvenance() ? "_virtual" : ""));
     else
         return nullptr;
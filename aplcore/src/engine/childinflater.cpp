@@ -0,0 +1,126 @@
+/**
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "apl/command/arraycommand.h"
+#include "apl/engine/arrayify.h"
+#include "apl/engine/builder.h"
+#include "apl/engine/childinflater.h"
+#include "apl/engine/context.h"
+#include "apl/time/sequencer.h"
+
+namespace apl {
+
+// Symbols defined for each child of a multi-child component
+static const Atom DATA_SYMBOL = "data";
+static const Atom INDEX_SYMBOL = "index";
+static const Atom LENGTH_SYMBOL = "length";
+static const Atom ORDINAL_SYMBOL = "ordinal";
+
+/**
+ * Run the "onMount" commands of a component and its descendants.  The document "onMount" only
+ * reaches the children that existed when it ran, so later children are mounted as they arrive.
+ */
+static void
+mount(const CoreComponentPtr& component)
+{
+    auto commands = component->getCalculated(kPropertyOnMount);
+    if (commands.isArray() && !commands.empty()) {
+        auto context = component->createDefaultEventContext("Mount");
+        context->sequencer().executeParallel(ArrayCommand::create(context, commands, component, Properties(), ""));
+    }
+
+    for (size_t i = 0 ; i < component->getChildCount() ; i++)
+        mount(component->getCoreChildAt(i));
+}
+
+ChildInflater::ChildInflater(const ContextPtr& context,
+                             const CoreComponentPtr& layout,
+                             const ComponentTemplateListPtr& items,
+                             const Object& data,
+                             const Path& childPath,
+                             bool numbered)
+    : mContext(context),
+      mLayout(layout),
+      mItems(items),
+      mData(data),
+      mChildPath(childPath),
+      mNumbered(numbered),
+      mLength(data.empty() ? items->size() : data.size())
+{
+}
+
+bool
+ChildInflater::inflateNext(bool useDirtyFlag)
+{
+    auto layout = mLayout.lock();
+    if (!layout)
+        return false;
+
+    while (!done()) {
+        auto childContext = Context::create(mContext);
+        childContext->putConstant(INDEX_SYMBOL, mIndex);
+        childContext->putConstant(LENGTH_SYMBOL, mLength);
+        if (mNumbered)
+            childContext->putConstant(ORDINAL_SYMBOL, mOrdinal);
+
+        Properties childProps;
+        CoreComponentPtr child;
+        if (!mData.empty()) {
+            childContext->putConstant(DATA_SYMBOL, mData.at(mNext));
+            child = Builder::expandSingleComponentFromArray(childContext, *mItems, childProps, layout, mChildPath);
+        }
+        else {
+            // A component definition is used directly; anything else is array-ified
+            const auto& element = mItems->at(mNext);
+            ComponentTemplateListPtr elementItems;
+            if (element->isValid())
+                elementItems = std::make_shared<ComponentTemplateList>(ComponentTemplateList{element});
+            else
+                elementItems = ComponentTemplate::create(arrayify(*mContext, element->item()));
+
+            child = Builder::expandSingleComponentFromArray(childContext, *elementItems, childProps, layout,
+                                                            mChildPath.addIndex(mNext));
+        }
+        mNext++;
+
+        if (child && child->isValid()) {
+            auto position = layout->getChildCount() - (mHasLastItem ? 1 : 0);
+            layout->insertChild(child, position, useDirtyFlag);
+            mIndex++;
+
+            // Children inflated by the first layout pass are mounted with the document
+            if (useDirtyFlag)
+                mount(child);
+
+            if (mNumbered) {
+                int numbering = child->getCalculated(kPropertyNumbering).getInteger();
+                if (numbering == kNumberingNormal) mOrdinal++;
+                else if (numbering == kNumberingReset) mOrdinal = 1;
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void
+ChildInflater::inflateAll(bool useDirtyFlag)
+{
+    while (!done())
+        inflateNext(useDirtyFlag);
+}
+
+} // namespace apl
@@ -18,6 +18,7 @@
 #include "apl/engine/evaluate.h"
 #include "apl/component/corecomponent.h"
 #include "apl/primitives/symbolreferencemap.h"
+#include "apl/utils/arena.h"
 
 namespace apl {
 
@@ -25,18 +26,19 @@ void ComponentDependant::create(const CoreComponentPtr& downstreamComponent,
                                 PropertyKey downstreamKey,
                                 const Object& equation,
                                 const ContextPtr& bindingContext,
-                                BindingFunction bindingFunction)
+                                BindingFunction bindingFunction,
+                                TimeGranularity granularity)
 {
     SymbolReferenceMap symbols;
     equation.symbols(symbols);
     if (symbols.empty())
         return;
 
-    auto dependant = std::make_shared<ComponentDependant>(downstreamComponent, downstreamKey, equation,
-                                                          bindingContext, bindingFunction);
+    auto dependant = allocateShared<ComponentDependant>(bindingContext->arena(),
+                                                        downstreamComponent, downstreamKey, equation,
+                                                        bindingContext, bindingFunction);
 
-    for (const auto& symbol : symbols.get())
-        symbol.second->addDownstream(symbol.first, dependant);
+    dependant->connectSources(symbols, granularity);
 
     downstreamComponent->addUpstream(downstreamKey, dependant);
 }
@@ -47,7 +49,7 @@ ComponentDependant::recalculate(bool useDirtyFlag) const
     auto downstream = mDownstreamComponent.lock();
     auto bindingContext = mBindingContext.lock();
     if (downstream && bindingContext) {
-        auto value = mBindingFunction(*bindingContext, reevaluate(*bindingContext, mEquation));
+        auto value = mBindingFunction(*bindingContext, calculate(*bindingContext));
         downstream->updateProperty(mDownstreamKey, value);
     }
 }
@@ -0,0 +1,312 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "apl/engine/componenttemplate.h"
+#include "apl/engine/arrayify.h"
+#include "apl/engine/evaluate.h"
+#include "apl/engine/properties.h"
+#include "apl/component/containercomponent.h"
+#include "apl/component/edittextcomponent.h"
+#include "apl/component/framecomponent.h"
+#include "apl/component/gridsequencecomponent.h"
+#include "apl/component/imagecomponent.h"
+#include "apl/component/pagercomponent.h"
+#include "apl/component/scrollviewcomponent.h"
+#include "apl/component/sequencecomponent.h"
+#include "apl/component/textcomponent.h"
+#include "apl/component/touchwrappercomponent.h"
+#include "apl/component/vectorgraphiccomponent.h"
+#include "apl/component/videocomponent.h"
+
+namespace apl {
+
+static const std::map<std::string, MakeComponentFunc> sComponentMap = {
+    {"Container",     ContainerComponent::create},
+    {"Text",          TextComponent::create},
+    {"Image",         ImageComponent::create},
+    {"ScrollView",    ScrollViewComponent::create},
+    {"EditText",      EditTextComponent::create},
+    {"Frame",         FrameComponent::create},
+    {"Sequence",      SequenceComponent::create},
+    {"GridSequence",  GridSequenceComponent::create},
+    {"TouchWrapper",  TouchWrapperComponent::create},
+    {"Pager",         PagerComponent::create},
+    {"VectorGraphic", VectorGraphicComponent::create},
+    {"Video",         VideoComponent::create}
+};
+
+static const ComponentTemplateListPtr EMPTY_TEMPLATE_LIST = std::make_shared<ComponentTemplateList>();
+
+/**
+ * A value is static if evaluating it does not depend on the data-binding context.  Strings
+ * are static unless they contain data-binding or may refer to a resource.
+ */
+static bool
+isStaticValue(const Object& value)
+{
+    if (value.isEvaluable())
+        return false;
+
+    if (!value.isString())
+        return true;
+
+    const auto& s = value.getString();
+    return s.find("${") == std::string::npos && (s.empty() || s[0] != '@');
+}
+
+/**
+ * Return the first named property of a map or NULL_OBJECT if it is not found.
+ */
+static Object
+findProperty(const Object& item, const char *name, const char *alternate = nullptr)
+{
+    if (item.has(name))
+        return item.get(name);
+
+    if (alternate && item.has(alternate))
+        return item.get(alternate);
+
+    return Object::NULL_OBJECT();
+}
+
+static bool
+hasProperty(const Object& item, const char *name, const char *alternate = nullptr)
+{
+    return item.has(name) || (alternate && item.has(alternate));
+}
+
+/*************************************************************************************/
+
+TemplateList::TemplateList(const Object& value)
+    : mValue(value)
+{
+    // Array-ification only performs data-binding on strings.  Anything else is used as-is.
+    if (value.isString())
+        return;
+
+    if (value.isArray()) {
+        const auto& items = value.getArray();
+        for (const auto& m : items)
+            if (m.isString())
+                return;
+
+        mTemplates = ComponentTemplate::create(items);
+    }
+    else {
+        mTemplates = std::make_shared<ComponentTemplateList>(ComponentTemplateList{ComponentTemplate::create(value)});
+    }
+}
+
+ComponentTemplateListPtr
+TemplateList::get(const Context& context) const
+{
+    if (mTemplates)
+        return mTemplates;
+
+    if (mValue.isNull())
+        return EMPTY_TEMPLATE_LIST;
+
+    return ComponentTemplate::create(arrayify(context, mValue));
+}
+
+/*************************************************************************************/
+
+BindingTemplate::BindingTemplate(const Object& binding)
+    : mBinding(binding),
+      mType(kBindingTypeAny),
+      mGranularity(kTimeGranularityFrame),
+      mHasValue(false),
+      mStaticName(true),
+      mStaticType(true),
+      mStaticGranularity(true)
+{
+    if (!binding.isMap())
+        return;
+
+    mHasValue = binding.has("value");
+    if (mHasValue)
+        mValue = binding.get("value");
+
+    if (binding.has("name")) {
+        auto name = binding.get("name");
+        mStaticName = isStaticValue(name);
+        if (mStaticName)
+            mName = name.asString();
+    }
+
+    if (binding.has("type")) {
+        auto type = binding.get("type");
+        mStaticType = isStaticValue(type);
+        if (mStaticType) {
+            auto s = type.asString();
+            mType = s.empty() ? kBindingTypeAny : sBindingMap.get(s, static_cast<BindingType>(-1));
+        }
+    }
+
+    if (binding.has("granularity")) {
+        auto granularity = binding.get("granularity");
+        mStaticGranularity = isStaticValue(granularity);
+        if (mStaticGranularity)
+            mGranularity = sTimeGranularityMap.get(granularity.asString(), kTimeGranularityFrame);
+    }
+}
+
+std::string
+BindingTemplate::name(const Context& context) const
+{
+    return mStaticName ? mName : propertyAsString(context, mBinding, "name");
+}
+
+BindingType
+BindingTemplate::type(const Context& context) const
+{
+    return mStaticType ? mType
+                       : propertyAsMapped<BindingType>(context, mBinding, "type", kBindingTypeAny, sBindingMap);
+}
+
+TimeGranularity
+BindingTemplate::granularity(const Context& context) const
+{
+    return mStaticGranularity ? mGranularity
+                              : propertyAsMapped<TimeGranularity>(context, mBinding, "granularity",
+                                                                  kTimeGranularityFrame, sTimeGranularityMap);
+}
+
+/*************************************************************************************/
+
+ComponentTemplatePtr
+ComponentTemplate::create(const Object& item)
+{
+    return std::make_shared<ComponentTemplate>(item);
+}
+
+ComponentTemplateListPtr
+ComponentTemplate::create(const std::vector<Object>& items)
+{
+    auto result = std::make_shared<ComponentTemplateList>();
+    result->reserve(items.size());
+    for (const auto& m : items)
+        result->emplace_back(create(m));
+    return result;
+}
+
+MakeComponentFunc
+ComponentTemplate::findFactory(const std::string& type)
+{
+    auto it = sComponentMap.find(type);
+    return it != sComponentMap.end() ? it->second : nullptr;
+}
+
+ComponentTemplate::ComponentTemplate(const Object& item)
+    : mItem(item),
+      mValid(item.isMap())
+{
+    if (!mValid)
+        return;
+
+    if (item.has("when")) {
+        mWhen = item.get("when");
+        mStaticWhen = isStaticValue(mWhen);
+        if (mStaticWhen)
+            mWhen = mWhen.asBoolean();
+    }
+    else {
+        mWhen = true;
+    }
+
+    mType = findProperty(item, "type");
+    mStaticType = isStaticValue(mType);
+    if (mStaticType) {
+        mStaticTypeName = mType.isNull() ? "" : mType.asString();
+        mFactory = findFactory(mStaticTypeName);
+    }
+
+    for (const auto& kv : item.getMap()) {
+        if (kv.first != "type" && kv.first != "when")
+            mProperties.emplace(kv.first, kv.second);
+    }
+
+    if (item.has("bind")) {
+        mBind = item.get("bind");
+        // Array-ification only performs data-binding on strings
+        bool dynamic = mBind.isString();
+        if (mBind.isArray())
+            for (const auto& m : mBind.getArray())
+                dynamic = dynamic || m.isString();
+
+        if (!dynamic) {
+            auto bindings = std::make_shared<BindingTemplateList>();
+            if (mBind.isArray())
+                for (const auto& m : mBind.getArray())
+                    bindings->emplace_back(m);
+            else
+                bindings->emplace_back(mBind);
+            mBindings = bindings;
+        }
+    }
+    else {
+        mBindings = std::make_shared<BindingTemplateList>();
+    }
+
+    if (hasProperty(item, "item", "items"))
+        mItems = TemplateList(findProperty(item, "item", "items"));
+    if (item.has("firstItem"))
+        mFirstItem = TemplateList(item.get("firstItem"));
+    if (item.has("lastItem"))
+        mLastItem = TemplateList(item.get("lastItem"));
+}
+
+bool
+ComponentTemplate::when(const Context& context) const
+{
+    return mStaticWhen ? mWhen.getBoolean() : evaluate(context, mWhen).asBoolean();
+}
+
+std::string
+ComponentTemplate::type(const Context& context) const
+{
+    return mStaticType ? mStaticTypeName : evaluate(context, mType).asString();
+}
+
+MakeComponentFunc
+ComponentTemplate::factory(const std::string& type) const
+{
+    return mStaticType ? mFactory : findFactory(type);
+}
+
+BindingTemplateListPtr
+ComponentTemplate::bindings(const Context& context) const
+{
+    if (mBindings)
+        return mBindings;
+
+    auto result = std::make_shared<BindingTemplateList>();
+    for (const auto& m : arrayify(context, mBind))
+        result->emplace_back(m);
+    return result;
+}
+
+/*************************************************************************************/
+
+LayoutTemplate::LayoutTemplate(const rapidjson::Value& layout, const Path& path)
+    : mLayout(layout),
+      mPath(path),
+      mParameters(layout)
+{
+    if (hasProperty(mLayout, "item", "items"))
+        mItems = TemplateList(findProperty(mLayout, "item", "items"));
+}
+
+} // namespace apl
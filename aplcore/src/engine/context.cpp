@@ -31,6 +31,7 @@
 #include "apl/engine/styles.h"
 #include "apl/primitives/functions.h"
 #include "apl/primitives/object.h"
+#include "apl/utils/arena.h"
 #include "apl/utils/session.h"
 
 namespace apl {
@@ -73,14 +74,20 @@ Context::create(const Metrics& metrics, const RootConfig& config, const std::str
 ContextPtr
 Context::create(const Metrics& metrics, const std::shared_ptr<RootContextData>& core)
 {
-    return std::make_shared<Context>(metrics, core);
+    return allocateShared<Context>(core->arena(), metrics, core);
+}
+
+ContextPtr
+Context::create(const ContextPtr& parent)
+{
+    return allocateShared<Context>(parent->arena(), parent);
 }
 
 ContextPtr
 Context::createClean(const ContextPtr& other)
 {
     auto context = other->top();
-    return std::make_shared<Context>(context);
+    return allocateShared<Context>(context->arena(), context);
 }
 
 Context::Context( const Metrics& metrics, const std::shared_ptr<RootContextData>& core )
@@ -167,6 +174,13 @@ Context::getLayout(const std::string& name) const
     return JsonResource();
 }
 
+std::shared_ptr<const LayoutTemplate>
+Context::getLayoutTemplate(const std::string& name) const
+{
+    assert(mCore);
+    return mCore->layoutTemplate(name);
+}
+
 const JsonResource
 Context::getCommand(const std::string& name) const
 {
@@ -270,6 +284,11 @@ Context::extensionManager() const {
     return mCore->extensionManager();
 }
 
+TickScheduler&
+Context::tickScheduler() const {
+    return mCore->tickScheduler();
+}
+
 const SessionPtr&
 Context::session() const {
     return mCore->session();
@@ -287,6 +306,18 @@ Context::measure() const
     return mCore->measure();
 }
 
+TextMeasureCache&
+Context::textMeasureCache() const
+{
+    return mCore->textMeasureCache();
+}
+
+const std::shared_ptr<Arena>&
+Context::arena() const
+{
+    return mCore->arena();
+}
+
 void Context::takeScreenLock() const
 {
     mCore->takeScreenLock();
@@ -321,11 +352,11 @@ operator<<(streamer& os, const Context& context)
 
 
 bool Context::userUpdateAndRecalculate(const std::string& key, const Object& value, bool useDirtyFlag) {
-    auto it = mMap.find(key);
-    if (it != mMap.end()) {
-        if (it->second.isUserWriteable()) {
+    auto object = mMap.find(key);
+    if (object) {
+        if (object->isUserWriteable()) {
             removeUpstream(key);  // Break any dependency chain
-            if (it->second.set(value))  // If the value changes, recalculate downstream values
+            if (object->set(value))  // If the value changes, recalculate downstream values
                 recalculateDownstream(key, useDirtyFlag);
         } else {
             CONSOLE_S(mCore->session()) << "Data-binding field '" << key << "' is read-only";
@@ -341,13 +372,13 @@ bool Context::userUpdateAndRecalculate(const std::string& key, const Object& val
 }
 
 bool Context::systemUpdateAndRecalculate(const std::string& key, const Object& value, bool useDirtyFlag) {
-    auto it = mMap.find(key);
-    if (it == mMap.end())
+    auto object = mMap.find(key);
+    if (!object)
         return false;
 
-    if (it->second.isMutable()) {
+    if (object->isMutable()) {
         removeUpstream(key);  // Break any dependency chain
-        if (it->second.set(value))  // If the value changes, recalculate downstream values
+        if (object->set(value))  // If the value changes, recalculate downstream values
             recalculateDownstream(key, useDirtyFlag);
     }
 
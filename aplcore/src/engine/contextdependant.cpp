@@ -14,8 +14,10 @@
  */
 
 #include "apl/engine/contextdependant.h"
+#include "apl/engine/context.h"
 #include "apl/engine/evaluate.h"
 #include "apl/primitives/symbolreferencemap.h"
+#include "apl/utils/arena.h"
 
 namespace apl {
 
@@ -26,7 +28,8 @@ ContextDependant::create(const ContextPtr& downstreamContext,
                          const std::string& downstreamName,
                          const Object& equation,
                          const ContextPtr& bindingContext,
-                         BindingFunction bindingFunction)
+                         BindingFunction bindingFunction,
+                         TimeGranularity granularity)
 {
     LOG_IF(DEBUG_CONTEXT_DEP) << "to '" << downstreamName << "' (" << downstreamContext.get() << ")";
 
@@ -35,13 +38,24 @@ ContextDependant::create(const ContextPtr& downstreamContext,
     if (symbols.empty())
         return;
 
-    auto dependant = std::make_shared<ContextDependant>(downstreamContext, downstreamName, equation,
-                                                        bindingContext, bindingFunction);
+    auto dependant = allocateShared<ContextDependant>(bindingContext->arena(),
+                                                      downstreamContext, downstreamName, equation,
+                                                      bindingContext, bindingFunction);
 
-    for (const auto& symbol : symbols.get())
-        symbol.second->addDownstream(symbol.first, dependant);
+    dependant->connectSources(symbols, granularity);
 
     downstreamContext->addUpstream(downstreamName, dependant);
+
+    // Dependants already reading the downstream symbol must recalculate after this one
+    downstreamContext->raiseDownstreamRank(downstreamName, dependant->rank() + 1);
+}
+
+void
+ContextDependant::raiseDownstreamRank()
+{
+    auto downstream = mDownstreamContext.lock();
+    if (downstream)
+        downstream->raiseDownstreamRank(mDownstreamName, mRank + 1);
 }
 
 /**
@@ -53,7 +67,7 @@ ContextDependant::recalculate(bool useDirtyFlag) const
     auto downstream = mDownstreamContext.lock();
     auto bindingContext = mBindingContext.lock();
     if (downstream && bindingContext) {
-        auto value = mBindingFunction(*bindingContext, reevaluate(*bindingContext, mEquation));
+        auto value = mBindingFunction(*bindingContext, calculate(*bindingContext));
         downstream->propagate(mDownstreamName, value, useDirtyFlag);
     }
 }
@@ -0,0 +1,146 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "apl/engine/contextmap.h"
+
+namespace apl {
+
+// Maps with more entries than this are indexed.  Below this a linear scan of the hashes is faster.
+static const size_t LINEAR_SCAN_LIMIT = 8;
+
+const size_t ContextMap::INLINE_CAPACITY;
+
+ContextMap::ContextMap(const ContextMap& other)
+{
+    for (const auto& m : other)
+        append(m.first, m.second);
+}
+
+ContextMap&
+ContextMap::operator=(const ContextMap& other)
+{
+    if (this != &other) {
+        clear();
+        for (const auto& m : other)
+            append(m.first, m.second);
+    }
+    return *this;
+}
+
+ContextMap::~ContextMap()
+{
+    clear();
+}
+
+void
+ContextMap::clear()
+{
+    for (size_t i = 0 ; i < mSize && i < INLINE_CAPACITY ; i++)
+        inlineEntry(i).~value_type();
+
+    mOverflow.clear();
+    mIndex.clear();
+    mSize = 0;
+}
+
+size_t
+ContextMap::indexOf(const std::string& key, size_t hash) const
+{
+    if (mIndex.empty()) {
+        for (size_t i = 0 ; i < mSize ; i++) {
+            const auto& entry = at(i);
+            if (entry.first.hash() == hash && entry.first == key)
+                return i;
+        }
+        return mSize;
+    }
+
+    const auto mask = mIndex.size() - 1;
+    for (auto slot = hash & mask ; ; slot = (slot + 1) & mask) {
+        auto position = mIndex[slot];
+        if (position == 0)
+            return mSize;
+
+        const auto& entry = at(position - 1);
+        if (entry.first.hash() == hash && entry.first == key)
+            return position - 1;
+    }
+}
+
+bool
+ContextMap::emplace(const Atom& key, const ContextObject& object)
+{
+    if (indexOf(key, key.hash()) < mSize)
+        return false;
+
+    append(key, object);
+    return true;
+}
+
+void
+ContextMap::replace(const Atom& key, const ContextObject& object)
+{
+    auto index = indexOf(key, key.hash());
+    if (index < mSize)
+        at(index).second = object;
+    else
+        append(key, object);
+}
+
+void
+ContextMap::append(const Atom& key, const ContextObject& object)
+{
+    if (mSize < INLINE_CAPACITY)
+        new (&mInline[mSize]) value_type(key, object);
+    else
+        mOverflow.emplace_back(key, object);
+    mSize++;
+
+    if (mIndex.empty()) {
+        if (mSize > LINEAR_SCAN_LIMIT)
+            rebuildIndex();
+    }
+    else if (mSize * 2 > mIndex.size()) {
+        rebuildIndex();
+    }
+    else {
+        insertIndex(key.hash(), mSize);
+    }
+}
+
+void
+ContextMap::insertIndex(size_t hash, uint32_t position)
+{
+    const auto mask = mIndex.size() - 1;
+    auto slot = hash & mask;
+    while (mIndex[slot] != 0)
+        slot = (slot + 1) & mask;
+    mIndex[slot] = position;
+}
+
+void
+ContextMap::rebuildIndex()
+{
+    // Keep the load factor at or below one half
+    size_t capacity = 32;
+    while (capacity < mSize * 2)
+        capacity <<= 1;
+
+    mIndex.assign(capacity, 0);
+    for (size_t i = 0 ; i < mSize ; i++)
+        insertIndex(at(i).first.hash(), i + 1);
+}
+
+} // namespace apl
@@ -0,0 +1,402 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cstring>
+
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+#include "apl/engine/deltastream.h"
+#include "apl/primitives/color.h"
+#include "apl/primitives/radii.h"
+#include "apl/primitives/rect.h"
+#include "apl/primitives/transform2d.h"
+#include "apl/utils/log.h"
+
+namespace apl {
+
+static const uint8_t MAGIC[4] = {'A', 'P', 'L', 'D'};
+static const uint8_t COMPONENT_RECORD = 0x01;
+
+const uint16_t DeltaEncoder::VERSION;
+
+DeltaEncoder::DeltaEncoder(void *buffer, size_t capacity)
+    : mBuffer(static_cast<uint8_t*>(buffer)),
+      mCapacity(capacity)
+{
+    write(MAGIC, sizeof(MAGIC));
+    writeU16(VERSION);
+    writeU16(0);
+}
+
+bool
+DeltaEncoder::add(const ComponentPtr& component)
+{
+    const auto& dirty = component->getDirtyProperties();
+    if (dirty.empty())
+        return !overflow();
+
+    auto uid = component->getUniqueId();
+    writeU8(COMPONENT_RECORD);
+    writeU16(static_cast<uint16_t>(uid.size()));
+    write(uid.data(), uid.size());
+    writeU16(static_cast<uint16_t>(dirty.size()));
+
+    for (auto key : dirty) {
+        writeU16(static_cast<uint16_t>(key));
+        writeValue(component->getCalculated(key));
+    }
+
+    return !overflow();
+}
+
+bool
+DeltaEncoder::add(const std::set<ComponentPtr>& components)
+{
+    for (const auto& component : components)
+        add(component);
+
+    return !overflow();
+}
+
+void
+DeltaEncoder::writeValue(const Object& value)
+{
+    switch (value.getType()) {
+        case Object::kNullType:
+            writeU8(kDeltaNull);
+            break;
+        case Object::kBoolType:
+            writeU8(kDeltaBoolean);
+            writeU8(value.getBoolean() ? 1 : 0);
+            break;
+        case Object::kNumberType:
+            writeU8(kDeltaNumber);
+            writeF64(value.getDouble());
+            break;
+        case Object::kStringType: {
+            const auto& s = value.getString();
+            writeU8(kDeltaString);
+            writeU32(static_cast<uint32_t>(s.size()));
+            write(s.data(), s.size());
+            break;
+        }
+        case Object::kColorType:
+            writeU8(kDeltaColor);
+            writeU32(value.getColor());
+            break;
+        case Object::kAbsoluteDimensionType:
+            writeU8(kDeltaAbsoluteDimension);
+            writeF64(value.getAbsoluteDimension());
+            break;
+        case Object::kRelativeDimensionType:
+            writeU8(kDeltaRelativeDimension);
+            writeF64(value.getRelativeDimension());
+            break;
+        case Object::kAutoDimensionType:
+            writeU8(kDeltaAutoDimension);
+            break;
+        case Object::kRectType: {
+            auto rect = value.getRect();
+            writeU8(kDeltaRect);
+            writeF32(rect.getLeft());
+            writeF32(rect.getTop());
+            writeF32(rect.getWidth());
+            writeF32(rect.getHeight());
+            break;
+        }
+        case Object::kRadiiType:
+            writeU8(kDeltaRadii);
+            for (auto f : value.getRadii().get())
+                writeF32(f);
+            break;
+        case Object::kTransform2DType:
+            writeU8(kDeltaTransform2D);
+            for (auto f : value.getTransform2D().get())
+                writeF32(f);
+            break;
+        default: {
+            rapidjson::Document doc;
+            auto json = value.serializeDirty(doc.GetAllocator());
+            rapidjson::StringBuffer buffer;
+            rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+            json.Accept(writer);
+            writeU8(kDeltaJson);
+            writeU32(static_cast<uint32_t>(buffer.GetSize()));
+            write(buffer.GetString(), buffer.GetSize());
+            break;
+        }
+    }
+}
+
+void
+DeltaEncoder::write(const void *data, size_t length)
+{
+    if (mSize + length <= mCapacity)
+        memcpy(mBuffer + mSize, data, length);
+    mSize += length;
+}
+
+void
+DeltaEncoder::writeU8(uint8_t value)
+{
+    write(&value, 1);
+}
+
+void
+DeltaEncoder::writeU16(uint16_t value)
+{
+    uint8_t bytes[2] = {static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8)};
+    write(bytes, sizeof(bytes));
+}
+
+void
+DeltaEncoder::writeU32(uint32_t value)
+{
+    uint8_t bytes[4];
+    for (int i = 0 ; i < 4 ; i++)
+        bytes[i] = static_cast<uint8_t>(value >> (8 * i));
+    write(bytes, sizeof(bytes));
+}
+
+void
+DeltaEncoder::writeF32(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    writeU32(bits);
+}
+
+void
+DeltaEncoder::writeF64(double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint8_t bytes[8];
+    for (int i = 0 ; i < 8 ; i++)
+        bytes[i] = static_cast<uint8_t>(bits >> (8 * i));
+    write(bytes, sizeof(bytes));
+}
+
+/****************************************************************************/
+
+DeltaDecoder::DeltaDecoder(const void *buffer, size_t size)
+    : mBuffer(static_cast<const uint8_t*>(buffer)),
+      mSize(size)
+{
+    uint8_t magic[4];
+    uint16_t version, reserved;
+    if (!read(magic, sizeof(magic)) || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        !readU16(version) || !readU16(reserved) || version != DeltaEncoder::VERSION) {
+        LOG(LogLevel::WARN) << "Unsupported delta stream";
+        mError = true;
+        return;
+    }
+
+    mVersion = version;
+}
+
+bool
+DeltaDecoder::next(DeltaRecord& record)
+{
+    if (mError || mOffset == mSize)
+        return false;
+
+    uint8_t tag;
+    uint16_t uidLength, count;
+    if (!readU8(tag) || tag != COMPONENT_RECORD || !readU16(uidLength) || mOffset + uidLength > mSize) {
+        mError = true;
+        return false;
+    }
+
+    record.uid.assign(reinterpret_cast<const char*>(mBuffer + mOffset), uidLength);
+    mOffset += uidLength;
+
+    if (!readU16(count)) {
+        mError = true;
+        return false;
+    }
+
+    record.properties.clear();
+    record.properties.reserve(count);
+    for (uint16_t i = 0 ; i < count ; i++) {
+        uint16_t key;
+        Object value;
+        if (!readU16(key) || !readValue(value)) {
+            mError = true;
+            return false;
+        }
+        record.properties.emplace_back(static_cast<PropertyKey>(key), std::move(value));
+    }
+
+    return true;
+}
+
+bool
+DeltaDecoder::readValue(Object& value)
+{
+    uint8_t type;
+    if (!readU8(type))
+        return false;
+
+    switch (type) {
+        case kDeltaNull:
+            value = Object::NULL_OBJECT();
+            return true;
+        case kDeltaBoolean: {
+            uint8_t b;
+            if (!readU8(b))
+                return false;
+            value = Object(b != 0);
+            return true;
+        }
+        case kDeltaNumber: {
+            double d;
+            if (!readF64(d))
+                return false;
+            value = Object(d);
+            return true;
+        }
+        case kDeltaString: {
+            uint32_t length;
+            if (!readU32(length) || mOffset + length > mSize)
+                return false;
+            value = Object(std::string(reinterpret_cast<const char*>(mBuffer + mOffset), length));
+            mOffset += length;
+            return true;
+        }
+        case kDeltaColor: {
+            uint32_t color;
+            if (!readU32(color))
+                return false;
+            value = Object(Color(color));
+            return true;
+        }
+        case kDeltaAbsoluteDimension:
+        case kDeltaRelativeDimension: {
+            double d;
+            if (!readF64(d))
+                return false;
+            value = Object(Dimension(type == kDeltaAbsoluteDimension ? DimensionType::Absolute
+                                                                     : DimensionType::Relative, d));
+            return true;
+        }
+        case kDeltaAutoDimension:
+            value = Object::AUTO_OBJECT();
+            return true;
+        case kDeltaRect: {
+            float f[4];
+            for (auto& m : f)
+                if (!readF32(m))
+                    return false;
+            value = Object(Rect(f[0], f[1], f[2], f[3]));
+            return true;
+        }
+        case kDeltaRadii: {
+            std::array<float, 4> f;
+            for (auto& m : f)
+                if (!readF32(m))
+                    return false;
+            value = Object(Radii(std::move(f)));
+            return true;
+        }
+        case kDeltaTransform2D: {
+            std::array<float, 6> f;
+            for (auto& m : f)
+                if (!readF32(m))
+                    return false;
+            value = Object(Transform2D(std::move(f)));
+            return true;
+        }
+        case kDeltaJson: {
+            uint32_t length;
+            if (!readU32(length) || mOffset + length > mSize)
+                return false;
+            rapidjson::Document doc;
+            doc.Parse(reinterpret_cast<const char*>(mBuffer + mOffset), length);
+            mOffset += length;
+            if (doc.HasParseError())
+                return false;
+            value = Object(std::move(doc));
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+bool
+DeltaDecoder::read(void *data, size_t length)
+{
+    if (mOffset + length > mSize)
+        return false;
+
+    memcpy(data, mBuffer + mOffset, length);
+    mOffset += length;
+    return true;
+}
+
+bool
+DeltaDecoder::readU8(uint8_t& value)
+{
+    return read(&value, 1);
+}
+
+bool
+DeltaDecoder::readU16(uint16_t& value)
+{
+    uint8_t bytes[2];
+    if (!read(bytes, sizeof(bytes)))
+        return false;
+    value = static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+    return true;
+}
+
+bool
+DeltaDecoder::readU32(uint32_t& value)
+{
+    uint8_t bytes[4];
+    if (!read(bytes, sizeof(bytes)))
+        return false;
+    value = 0;
+    for (int i = 0 ; i < 4 ; i++)
+        value |= static_cast<uint32_t>(bytes[i]) << (8 * i);
+    return true;
+}
+
+bool
+DeltaDecoder::readF32(float& value)
+{
+    uint32_t bits;
+    if (!readU32(bits))
+        return false;
+    memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+bool
+DeltaDecoder::readF64(double& value)
+{
+    uint8_t bytes[8];
+    if (!read(bytes, sizeof(bytes)))
+        return false;
+    uint64_t bits = 0;
+    for (int i = 0 ; i < 8 ; i++)
+        bits |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+    memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+} // namespace apl
@@ -13,21 +13,102 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
+
 #include "apl/engine/dependant.h"
+#include "apl/datagrammar/bytecode.h"
 #include "apl/engine/context.h"
+#include "apl/engine/evaluate.h"
+#include "apl/engine/rootcontext.h"
 #include "apl/primitives/symbolreferencemap.h"
 
 namespace apl {
 
+Dependant::Dependant(const Object& equation, const ContextPtr& bindingContext, BindingFunction bindingFunction)
+    : mEquation(equation),
+      mByteCode(datagrammar::ByteCode::compile(equation)),
+      mBindingContext(bindingContext),
+      mBindingFunction(bindingFunction)
+{}
+
+Dependant::~Dependant()
+{
+    detach();
+}
+
 void
 Dependant::removeFromSource()
 {
-    SymbolReferenceMap symbols;
-    mEquation.symbols(symbols);
-    for (const auto& symbol : symbols.get())
-        symbol.second->removeDownstream(shared_from_this());
+    detach();
 
     mEquation = Object::NULL_OBJECT();
+    mByteCode = nullptr;
 };
 
+void
+Dependant::detach()
+{
+    for (const auto& handle : mSources)
+        if (handle.registry)
+            handle.registry->remove(handle.bucket, handle.position);
+
+    mSources.clear();
+}
+
+void
+Dependant::assignRank(const SymbolReferenceMap& symbols)
+{
+    for (const auto& symbol : symbols.get())
+        mRank = std::max(mRank, symbol.second->downstreamRank(downstreamName(symbol.first)));
+}
+
+/**
+ * @return The name of the time symbol referenced by a symbol in the top-level context or an
+ *         empty string if the symbol is not a time symbol.
+ */
+static std::string
+timeSymbolName(const Context& context, const std::string& symbol)
+{
+    if (context.parent())
+        return "";
+
+    auto name = downstreamName(symbol).str();
+    return name == ELAPSED_TIME || name == LOCAL_TIME || name == UTC_TIME ? name : "";
+}
+
+void
+Dependant::connectSources(const SymbolReferenceMap& symbols, TimeGranularity granularity)
+{
+    assignRank(symbols);
+
+    auto self = shared_from_this();
+    for (const auto& symbol : symbols.get()) {
+        // Coarse time dependants are scheduled separately by the RootContext
+        auto timeSymbol = granularity != kTimeGranularityFrame ? timeSymbolName(*symbol.second, symbol.first) : "";
+        if (!timeSymbol.empty())
+            symbol.second->addDownstream(timeGranularityKey(timeSymbol, granularity), self);
+        else
+            symbol.second->addDownstream(symbol.first, self);
+    }
+}
+
+void
+Dependant::raiseRank(unsigned int rank)
+{
+    if (rank <= mRank)
+        return;
+
+    mRank = rank;
+    raiseDownstreamRank();
+}
+
+Object
+Dependant::calculate(const Context& bindingContext) const
+{
+    if (mByteCode)
+        return reevaluate(bindingContext, *mByteCode);
+
+    return reevaluate(bindingContext, mEquation);
+}
+
 }  // namespace apl
\ No newline at end of file
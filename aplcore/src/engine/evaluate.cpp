@@ -14,7 +14,8 @@
  */
 
 #include "apl/engine/evaluate.h"
-#include "apl/datagrammar/databindingrules.h"
+#include "apl/datagrammar/bytecode.h"
+#include "apl/datagrammar/expressioncache.h"
 #include "apl/engine/context.h"
 #include "apl/primitives/dimension.h"
 #include "apl/utils/log.h"
@@ -22,8 +23,6 @@
 
 namespace apl {
 
-namespace pegtl = tao::TAO_PEGTL_NAMESPACE;
-
 const bool DEBUG_DATA_BINDING = false;
 
 /**
@@ -36,18 +35,15 @@ const bool DEBUG_DATA_BINDING = false;
 Object
 parseDataBinding(const Context& context, const std::string& value)
 {
-    try {
-        datagrammar::Stacks stacks(context);
-        pegtl::string_input<> in(value, "");
-        pegtl::parse<datagrammar::grammar, datagrammar::action>(in, stacks);
-        Object result = stacks.finish();
+    // The compiled template is shared; symbols are bound to this context
+    auto compiled = datagrammar::ExpressionCache::instance().get(value);
+    if (compiled->expression) {
+        Object result = compiled->expression->bind(context);
         LOG_IF(DEBUG_DATA_BINDING) << "Parse data binding " << value << "=" << result;
         return result;
     }
-    catch (pegtl::parse_error e) {
-        CONSOLE_CTX(context) << "Parse error in '" << value << "' - " << e.what();
-    }
 
+    CONSOLE_CTX(context) << "Parse error in '" << value << "' - " << compiled->error;
     return value;
 }
 
@@ -125,6 +121,21 @@ reevaluate(const Context& context, const Object& equation)
     return result;
 }
 
+Object
+reevaluate(const Context& context, const datagrammar::ByteCode& byteCode)
+{
+    auto result = byteCode.eval();
+
+    // Strings get a resource check
+    if (result.isString()) {
+        std::string s = result.getString();
+        if (!s.empty() && s[0] == '@' && context.has(s))
+            return context.opt(s);    // This isn't efficient because we do a has() and a get().
+    }
+
+    return result;
+}
+
 Object
 evaluateRecursive(const Context& context, const Object& object)
 {
@@ -77,7 +77,7 @@ Info::resources() const
     std::map<std::string, std::string> result;
 
     for (const auto& m : *mContext) {
-        if (m.first.at(0) == '@')
+        if (m.first.str().at(0) == '@')
             result.emplace(m.first, mContext->provenance(m.first));
     }
 
@@ -32,7 +32,7 @@ namespace apl {
 std::string
 Properties::asLabel(const Context& context, const char *name)
 {
-    auto s = mProperties.find(name);
+    auto s = find(name);
     if (s == mProperties.end())
         return "";
 
@@ -45,7 +45,7 @@ Properties::asLabel(const Context& context, const char *name)
 std::string
 Properties::asString(const Context& context, const char *name, const char *defvalue)
 {
-    auto s = mProperties.find(name);
+    auto s = find(name);
     if (s == mProperties.end())
         return defvalue;
 
@@ -55,7 +55,7 @@ Properties::asString(const Context& context, const char *name, const char *defva
 bool
 Properties::asBoolean(const Context& context, const char *name, bool defvalue)
 {
-    auto s = mProperties.find(name);
+    auto s = find(name);
     if (s == mProperties.end())
         return defvalue;
 
@@ -65,7 +65,7 @@ Properties::asBoolean(const Context& context, const char *name, bool defvalue)
 double
 Properties::asNumber(const Context& context, const char *name, double defvalue)
 {
-    auto s = mProperties.find(name);
+    auto s = find(name);
     if (s == mProperties.end())
         return defvalue;
 
@@ -75,7 +75,7 @@ Properties::asNumber(const Context& context, const char *name, double defvalue)
 Dimension
 Properties::asAbsoluteDimension(const Context& context, const char *name, double defvalue)
 {
-    auto s = mProperties.find(name);
+    auto s = find(name);
     if (s == mProperties.end())
         return Dimension(DimensionType::Absolute, defvalue);
 
@@ -97,6 +97,16 @@ Properties::emplace(const Object& item)
     }
 }
 
+void
+Properties::emplace(const PropertyValueMap& properties)
+{
+    // Note that this doesn't override an existing one (deliberately!)
+    if (mProperties.empty())
+        mProperties = properties;
+    else
+        mProperties.insert(properties.begin(), properties.end());
+}
+
 void
 Properties::addToContext(const ContextPtr &context, const Parameter &parameter, bool userWriteable)
 {
@@ -105,7 +115,7 @@ Properties::addToContext(const ContextPtr &context, const Parameter &parameter,
     Object result;
     auto bindingFunc = sBindingFunctions.at(parameter.type);
 
-    auto it = mProperties.find(parameter.name);
+    auto it = find(parameter.name);
     if (it != mProperties.end()) {
         tmp = it->second;
         mProperties.erase(it);   // Remove the property from the list
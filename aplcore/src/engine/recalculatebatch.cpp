@@ -0,0 +1,98 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include "apl/engine/recalculatebatch.h"
+#include "apl/engine/dependant.h"
+
+namespace apl {
+
+namespace {
+
+struct PendingDependant {
+    unsigned int rank;
+    size_t sequence;   // Dependants of equal rank are recalculated in the order they were added
+    std::shared_ptr<Dependant> dependant;
+
+    // Reversed so that the heap returns the lowest rank first
+    bool operator<(const PendingDependant& rhs) const {
+        return rank != rhs.rank ? rank > rhs.rank : sequence > rhs.sequence;
+    }
+};
+
+struct BatchState {
+    int depth = 0;
+    size_t sequence = 0;
+    std::vector<PendingDependant> heap;
+    std::unordered_map<const Dependant*, bool> dirty;   // Pending dependants and their dirty flag
+};
+
+thread_local BatchState sBatch;
+
+} // namespace
+
+RecalculateBatch::RecalculateBatch()
+{
+    sBatch.depth++;
+}
+
+RecalculateBatch::~RecalculateBatch()
+{
+    // The outermost batch commits.  The depth is held at one while committing so that batches
+    // opened by the recalculated dependants add to this one.
+    if (sBatch.depth == 1)
+        commit();
+
+    sBatch.depth--;
+}
+
+void
+RecalculateBatch::add(const std::shared_ptr<Dependant>& dependant, bool useDirtyFlag)
+{
+    auto it = sBatch.dirty.find(dependant.get());
+    if (it != sBatch.dirty.end()) {
+        it->second = it->second || useDirtyFlag;
+        return;
+    }
+
+    sBatch.dirty.emplace(dependant.get(), useDirtyFlag);
+    sBatch.heap.emplace_back(PendingDependant{dependant->rank(), sBatch.sequence++, dependant});
+    std::push_heap(sBatch.heap.begin(), sBatch.heap.end());
+}
+
+void
+RecalculateBatch::commit()
+{
+    while (!sBatch.heap.empty()) {
+        std::pop_heap(sBatch.heap.begin(), sBatch.heap.end());
+        auto dependant = std::move(sBatch.heap.back().dependant);
+        sBatch.heap.pop_back();
+
+        auto it = sBatch.dirty.find(dependant.get());
+        auto useDirtyFlag = it->second;
+        sBatch.dirty.erase(it);
+
+        // A dependant may have been disconnected by an earlier recalculation in this batch
+        if (dependant->isAttached())
+            dependant->recalculate(useDirtyFlag);
+    }
+
+    sBatch.sequence = 0;
+}
+
+} // namespace apl
@@ -0,0 +1,76 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "apl/engine/recalculatesource.h"
+
+namespace apl {
+
+DownstreamRegistry::~DownstreamRegistry()
+{
+    for (const auto& bucket : mBuckets)
+        for (const auto& entry : bucket)
+            entry.dependant->mSources[entry.handle].registry = nullptr;
+}
+
+uint32_t
+DownstreamRegistry::createBucket()
+{
+    mBuckets.emplace_back();
+    return static_cast<uint32_t>(mBuckets.size() - 1);
+}
+
+bool
+DownstreamRegistry::add(uint32_t bucket, const std::shared_ptr<Dependant>& dependant)
+{
+    // A dependant is registered with a handful of sources, so this search is short
+    for (const auto& handle : dependant->mSources)
+        if (handle.registry == this && handle.bucket == bucket)
+            return false;
+
+    auto& entries = mBuckets[bucket];
+    entries.emplace_back(Entry{dependant.get(), static_cast<uint32_t>(dependant->mSources.size())});
+    dependant->mSources.emplace_back(Dependant::SourceHandle{this, bucket, static_cast<uint32_t>(entries.size() - 1)});
+    mSize++;
+    return true;
+}
+
+void
+DownstreamRegistry::remove(uint32_t bucket, uint32_t position)
+{
+    auto& entries = mBuckets[bucket];
+    if (position + 1 != entries.size()) {
+        entries[position] = entries.back();
+        entries[position].dependant->mSources[entries[position].handle].position = position;
+    }
+
+    entries.pop_back();
+    mSize--;
+}
+
+void
+DownstreamRegistry::schedule(uint32_t bucket, RecalculateBatch& batch, bool useDirtyFlag) const
+{
+    for (const auto& entry : mBuckets[bucket])
+        batch.add(entry.dependant->shared_from_this(), useDirtyFlag);
+}
+
+void
+DownstreamRegistry::raiseRank(uint32_t bucket, unsigned int rank) const
+{
+    for (const auto& entry : mBuckets[bucket])
+        entry.dependant->raiseRank(rank);
+}
+
+} // namespace apl
@@ -14,6 +14,7 @@
  */
 
 #include <algorithm>
+#include <cmath>
 
 #include "rapidjson/stringbuffer.h"
 
@@ -22,6 +23,7 @@
 #include "apl/engine/evaluate.h"
 #include "apl/engine/styles.h"
 #include "apl/engine/propdef.h"
+#include "apl/engine/recalculatebatch.h"
 #include "apl/action/scrolltoaction.h"
 #include "apl/command/documentcommand.h"
 #include "apl/content/content.h"
@@ -275,12 +277,10 @@ RootContext::updateTime(apl_time_t elapsedTime)
 {
     auto lastTime = mTimeManager->currentTime();
     mTimeManager->updateTime(elapsedTime);
-    mContext->systemUpdateAndRecalculate(ELAPSED_TIME, mTimeManager->currentTime(), true); // Read back in case it gets changed
 
     // Update the local time by how much time passed on the "elapsed" timer
     mUTCTime += mTimeManager->currentTime() - lastTime;
-    mContext->systemUpdateAndRecalculate(UTC_TIME, mUTCTime, true);
-    mContext->systemUpdateAndRecalculate(LOCAL_TIME, mUTCTime + mLocalTimeAdjustment, true);
+    updateTimeSymbols();
 
     mCore->pointerManager().handleTimeUpdate(elapsedTime);
 }
@@ -289,15 +289,39 @@ void
 RootContext::updateTime(apl_time_t elapsedTime, apl_time_t utcTime)
 {
     mTimeManager->updateTime(elapsedTime);
-    mContext->systemUpdateAndRecalculate(ELAPSED_TIME, mTimeManager->currentTime(), true); // Read back in case it gets changed
 
     mUTCTime = utcTime;
-    mContext->systemUpdateAndRecalculate(UTC_TIME, mUTCTime, true);
-    mContext->systemUpdateAndRecalculate(LOCAL_TIME, mUTCTime + mLocalTimeAdjustment, true);
+    updateTimeSymbols();
 
     mCore->pointerManager().handleTimeUpdate(elapsedTime);
 }
 
+void
+RootContext::updateTimeSymbols()
+{
+    // Bindings that use more than one of the time symbols are recalculated once
+    RecalculateBatch batch;
+    updateTimeSymbol(ELAPSED_TIME, mTimeManager->currentTime()); // Read back in case it gets changed
+    updateTimeSymbol(UTC_TIME, mUTCTime);
+    updateTimeSymbol(LOCAL_TIME, mUTCTime + mLocalTimeAdjustment);
+}
+
+void
+RootContext::updateTimeSymbol(const char *name, apl_time_t value)
+{
+    static const TimeGranularity COARSE[] = {kTimeGranularitySecond, kTimeGranularityMinute};
+
+    auto previous = mContext->opt(name).asNumber();
+    mContext->systemUpdateAndRecalculate(name, value, true);
+
+    // Coarse dependants only care when the time crosses into a new period
+    for (auto granularity : COARSE) {
+        auto period = timeGranularityPeriod(granularity);
+        if (std::floor(previous / period) != std::floor(value / period))
+            mContext->recalculateDownstream(timeGranularityKey(name, granularity), true);
+    }
+}
+
 void
 RootContext::scrollToRectInComponent(const ComponentPtr& component, const Rect &bounds,
                                      CommandScrollAlign align) {
@@ -377,7 +401,8 @@ RootContext::setup()
 
         auto styleIter = json.FindMember("styles");
         if (styleIter != json.MemberEnd() && styleIter->value.IsObject())
-            mCore->styles()->addStyleDefinitions(mCore->session(), &styleIter->value, path.addObject("styles"));
+            mCore->styles()->addStyleDefinitions(mCore->session(), &styleIter->value, path.addObject("styles"),
+                                                 &child->styleBlocks());
     }
 
     // Layout processing
@@ -464,28 +489,6 @@ RootContext::setup()
     return true;
 }
 
-void
-RootContext::scheduleTickHandler(const Object& handler, double delay) {
-    auto weak_ptr = std::weak_ptr<RootContext>(shared_from_this());
-
-    // Lambda capture takes care of handler here as it's a copy.
-    mTimeManager->setTimeout([weak_ptr, handler, delay]() {
-        auto self = weak_ptr.lock();
-        if (!self)
-            return;
-
-        auto ctx = self->createDocumentContext("Tick");
-        if (propertyAsBoolean(*ctx, handler, "when", true)) {
-            auto commands = Object(arrayifyProperty(*ctx, handler, "commands"));
-            if (!commands.empty())
-                self->context().sequencer().executeCommands(commands, ctx, nullptr, true);
-        }
-
-        self->scheduleTickHandler(handler, delay);
-
-    }, delay);
-}
-
 void
 RootContext::processTickHandlers() {
     auto& json = content()->getDocument()->json();
@@ -499,9 +502,7 @@ RootContext::processTickHandlers() {
         return;
 
     for (const auto& handler : tickHandlers.getArray()) {
-        auto delay = std::max(propertyAsDouble(*mContext, handler, "minimumDelay", 1000),
-                mCore->rootConfig().getTickHandlerUpdateLimit());
-        scheduleTickHandler(handler, delay);
+        mCore->tickScheduler().add(shared_from_this(), handler);
     }
 }
 
@@ -592,6 +593,12 @@ RootContext::measure() const
     return mCore->measure();
 }
 
+const TextMeasureCache&
+RootContext::textMeasureCache() const
+{
+    return mCore->textMeasureCache();
+}
+
 ComponentPtr
 RootContext::findComponentById(const std::string& id) const
 {
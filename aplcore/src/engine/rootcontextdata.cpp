@@ -21,6 +21,7 @@
 #include "apl/engine/rootcontextdata.h"
 #include "apl/engine/styles.h"
 #include "apl/livedata/livedatamanager.h"
+#include "apl/utils/arena.h"
 #include "apl/utils/log.h"
 
 namespace apl {
@@ -90,22 +91,42 @@ RootContextData::RootContextData(const Metrics& metrics,
       mKeyboardManager(new KeyboardManager()),
       mDataManager(new LiveDataManager()),
       mExtensionManager(new ExtensionManager(extensions, config)),
+      mTickScheduler(new TickScheduler(config.getTimeManager())),
       mYGConfigRef(YGConfigNew()),
       mTextMeasurement(config.getMeasure()),
+      mTextMeasureCache(new TextMeasureCache(config.getMeasure(), config.getTextMeasurementCacheSize())),
       mConfig(config),
       mScreenLockCount(0),
       mSettings(settings),
-      mSession(session)
+      mSession(session),
+      mArena(config.getArenaAllocation() ? std::make_shared<Arena>() : nullptr)
 {
     YGConfigSetPrintTreeFlag(mYGConfigRef, DEBUG_YG_PRINT_TREE);
     YGConfigSetLogger(mYGConfigRef, ygLogger);
     YGConfigSetPointScaleFactor(mYGConfigRef, metrics.getDpi() / 160.0);
 }
 
+LayoutTemplatePtr
+RootContextData::layoutTemplate(const std::string& name)
+{
+    auto it = mLayoutTemplates.find(name);
+    if (it != mLayoutTemplates.end())
+        return it->second;
+
+    auto layout = mLayouts.find(name);
+    if (layout == mLayouts.end() || layout->second.empty())
+        return nullptr;
+
+    auto result = std::make_shared<LayoutTemplate>(layout->second.json(), layout->second.path());
+    mLayoutTemplates.emplace(name, result);
+    return result;
+}
+
 void
 RootContextData::terminate()     {
     assert(mSequencer);
     mSequencer->terminate();
+    mTickScheduler->terminate();
     if (mTop) {
         mTop->release();
         mTop = nullptr;
@@ -15,6 +15,7 @@
 
 #include <cstring>
 
+#include "apl/datagrammar/expressioncache.h"
 #include "apl/engine/evaluate.h"
 #include "apl/engine/styledefinition.h"
 #include "apl/engine/arrayify.h"
@@ -29,12 +30,64 @@ static const char *VALUE = "value";
 static const char *VALUES = "values";
 static const char *DESCRIPTION = "description";
 
-StyleDefinition::StyleDefinition(const rapidjson::Value& value, const Path& styleProvenance)
+StyleBlocks::CompiledValue::CompiledValue(const rapidjson::Value& json)
+    : value(json)
+{
+    if (!value.isString())
+        return;
+
+    // Strings that fail to parse are left for evaluate() so that the error is reported
+    constant = false;
+    auto compiled = datagrammar::ExpressionCache::instance().get(value.getString());
+    if (!compiled->expression ||
+        compiled->expression->type() != datagrammar::ExpressionTemplate::kConstant)
+        return;
+
+    // Constant strings may still name a resource, which must be looked up in the context
+    const auto& v = compiled->expression->value();
+    if (!v.isString() || v.getString().empty() || v.getString()[0] != '@') {
+        value = v;
+        constant = true;
+    }
+}
+
+Object
+StyleBlocks::CompiledValue::eval(const Context& context) const
+{
+    // The compiled expression is shared through the expression cache
+    return constant ? value : evaluate(context, value);
+}
+
+StyleBlocks::StyleBlocks(const rapidjson::Value& value)
+{
+    size_t index = 0;
+    for (auto& block : arrayifyProperty(value, VALUE, VALUES)) {
+        CompiledBlock compiled{index++, nullptr, {}};
+        if (!block.IsObject())
+            continue;
+
+        for (auto& m : block.GetObject()) {
+            const char *name = m.name.GetString();
+            if (std::strcmp(name, WHEN) == 0)
+                compiled.when.reset(new CompiledValue(m.value));
+            else if (std::strcmp(name, DESCRIPTION) != 0)
+                compiled.properties.emplace_back(CompiledProperty{Atom(name), CompiledValue(m.value)});
+        }
+
+        // A block that is always false can never contribute a property
+        if (compiled.when && compiled.when->constant && !compiled.when->value.asBoolean())
+            continue;
+
+        mBlocks.emplace_back(std::move(compiled));
+    }
+}
+
+StyleDefinition::StyleDefinition(const rapidjson::Value& value, const Path& styleProvenance,
+                                 const StyleBlocksPtr& blocks)
     : mStyleProvenance(styleProvenance),
-      mBlockBaseProvenance(styleProvenance.addProperty(value, VALUE, VALUES))
+      mBlockBaseProvenance(styleProvenance.addProperty(value, VALUE, VALUES)),
+      mBlocks(blocks ? blocks : std::make_shared<StyleBlocks>(value))
 {
-    for (auto& m : arrayifyProperty(value, VALUE, VALUES))
-        mBlocks.push_back(&m);
 }
 
 void
@@ -64,23 +117,13 @@ StyleDefinition::get(const ContextPtr& context, const State& state)
 
     // Evaluate each block in order
     auto extendedContext = state.extend(context);
-    size_t index = 0;
-    for (const rapidjson::Value *block : mBlocks) {
-        const Path path = mBlockBaseProvenance.addIndex(index++);
-        if (!block->IsObject())
-            continue;
-
-        // Check the "when" clause
-        auto when = block->FindMember(WHEN);
-        if (when != block->MemberEnd() && !evaluate(*extendedContext, when->value).asBoolean())
+    for (const auto& block : mBlocks->blocks()) {
+        if (block.when && !block.when->eval(*extendedContext).asBoolean())
             continue;
 
-        // Iterate over all members (skipping "when" and "description")
-        for (auto& m : block->GetObject()) {
-            const char *name = m.name.GetString();
-            if (std::strcmp(name, WHEN) != 0 && std::strcmp(name, DESCRIPTION) != 0)
-                ptr->put(name, evaluate(*extendedContext, m.value), path.addObject(name).toString());
-        }
+        const Path path = mBlockBaseProvenance.addIndex(block.index);
+        for (const auto& m : block.properties)
+            ptr->put(m.name, m.value.eval(*extendedContext), path.addObject(m.name.str()).toString());
     }
 
     mCache[state] = ptr;
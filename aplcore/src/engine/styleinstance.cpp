@@ -24,7 +24,7 @@ StyleInstance::StyleInstance(const Path& styleProvenance)
 }
 
 void
-StyleInstance::put(const std::string& key, const Object& value, const std::string& provenance)
+StyleInstance::put(const Atom& key, const Object& value, const std::string& provenance)
 {
     mValue[key] = value;
     if (!provenance.empty())
@@ -32,7 +32,7 @@ StyleInstance::put(const std::string& key, const Object& value, const std::strin
 }
 
 Object
-StyleInstance::at(const std::string& key) const
+StyleInstance::at(const Atom& key) const
 {
     auto it = mValue.find(key);
     if (it != mValue.end())
@@ -42,7 +42,7 @@ StyleInstance::at(const std::string& key) const
 }
 
 std::string
-StyleInstance::provenance(const std::string& key) const
+StyleInstance::provenance(const Atom& key) const
 {
     auto it = mProvenance.find(key);
     if (it != mProvenance.end())
@@ -51,6 +51,44 @@ StyleInstance::provenance(const std::string& key) const
     return "";
 }
 
+const std::vector<Atom>&
+StyleInstance::changedFrom(const StyleInstancePtr& previous) const
+{
+    auto it = mChanges.find(previous);
+    if (it != mChanges.end())
+        return it->second;
+
+    // Both maps are sorted by name, so walk them together
+    std::vector<Atom> changes;
+    auto a = previous->mValue.begin();
+    auto b = mValue.begin();
+    while (a != previous->mValue.end() || b != mValue.end()) {
+        if (b == mValue.end() || (a != previous->mValue.end() && a->first < b->first)) {
+            changes.emplace_back(a->first);
+            a++;
+        }
+        else if (a == previous->mValue.end() || b->first < a->first) {
+            changes.emplace_back(b->first);
+            b++;
+        }
+        else {
+            if (a->second != b->second)
+                changes.emplace_back(a->first);
+            a++;
+            b++;
+        }
+    }
+
+    // Drop the entries for styles that no longer exist before memoizing a new one
+    for (auto entry = mChanges.begin() ; entry != mChanges.end() ; ) {
+        if (entry->first.expired())
+            entry = mChanges.erase(entry);
+        else
+            entry++;
+    }
+
+    return mChanges.emplace(previous, std::move(changes)).first->second;
+}
 
 } // namespace apl
 
@@ -35,8 +35,9 @@ static const bool DEBUG_STYLES = false;
  */
 class StyleProcessSet {
 public:
-    StyleProcessSet(const SessionPtr& session, Styles& styles, const rapidjson::Value *json, const Path& path)
-        : mSession(session), mStyles(styles), mJson(json), mPath(path)
+    StyleProcessSet(const SessionPtr& session, Styles& styles, const rapidjson::Value *json, const Path& path,
+                    const std::map<std::string, StyleBlocksPtr> *blocks)
+        : mSession(session), mStyles(styles), mJson(json), mPath(path), mBlocks(blocks)
     {}
 
     void process() {
@@ -81,7 +82,14 @@ public:
         LOG_IF(DEBUG_STYLES) << name;
 
         const rapidjson::Value& value = mJson->GetObject()[name.c_str()];
-        StyleDefinitionPtr styledef = std::make_shared<StyleDefinition>(value, mPath.addObject(name));
+        StyleBlocksPtr blocks;
+        if (mBlocks) {
+            auto it = mBlocks->find(name);
+            if (it != mBlocks->end())
+                blocks = it->second;
+        }
+
+        StyleDefinitionPtr styledef = std::make_shared<StyleDefinition>(value, mPath.addObject(name), blocks);
 
         LOG_IF(DEBUG_STYLES) << "  extend, extends";
         for (auto&& m : arrayifyProperty(value, "extend", "extends")) {
@@ -99,6 +107,7 @@ private:
     Styles& mStyles;
     const rapidjson::Value* mJson;
     const Path mPath;
+    const std::map<std::string, StyleBlocksPtr> *mBlocks;
     std::set<std::string> mToBeProcessed;
     std::set<std::string> mInProcess;
 };
@@ -119,9 +128,10 @@ Styles::get(const ContextPtr& context, const std::string& name, const State& sta
 }
 
 void
-Styles::addStyleDefinitions(const SessionPtr& session, const rapidjson::Value *json, const Path& provenance)
+Styles::addStyleDefinitions(const SessionPtr& session, const rapidjson::Value *json, const Path& provenance,
+                            const std::map<std::string, StyleBlocksPtr> *blocks)
 {
-    StyleProcessSet sps(session, *this, json, provenance);
+    StyleProcessSet sps(session, *this, json, provenance, blocks);
     sps.process();
 }
 
@@ -0,0 +1,221 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include "apl/component/corecomponent.h"
+#include "apl/content/rootconfig.h"
+#include "apl/datagrammar/expressioncache.h"
+#include "apl/engine/arrayify.h"
+#include "apl/engine/evaluate.h"
+#include "apl/engine/rootcontext.h"
+#include "apl/engine/tickscheduler.h"
+#include "apl/time/sequencer.h"
+#include "apl/time/timemanager.h"
+
+namespace apl {
+
+/**
+ * A component is suspended when it, or one of its ancestors, has not been attached to the
+ * layout of its parent.  This happens to the children of a Sequence or Pager that are outside
+ * of the ensured range.
+ */
+static bool
+isSuspended(const CoreComponent& component)
+{
+    auto current = &component;
+    while (auto parent = current->getParent()) {
+        if (!current->isAttached())
+            return true;
+        current = static_cast<CoreComponent*>(parent.get());
+    }
+
+    return false;
+}
+
+/**
+ * Commands must be evaluated on every tick if they are a data-bound expression or contain one
+ * at the top level.
+ */
+static bool
+needsBinding(const Object& commands)
+{
+    if (commands.isString())
+        return true;
+
+    if (commands.isArray())
+        for (const auto& m : commands.getArray())
+            if (m.isString())
+                return true;
+
+    return false;
+}
+
+TickScheduler::TickScheduler(const std::shared_ptr<TimeManager>& timeManager)
+    : mTimeManager(timeManager)
+{
+}
+
+TickScheduler::~TickScheduler()
+{
+    terminate();
+}
+
+void
+TickScheduler::add(const CoreComponentPtr& component, const Object& handler)
+{
+    auto prepared = prepare(*component->getContext(), handler);
+    if (!prepared)
+        return;
+
+    prepared->component = component;
+    schedule(prepared);
+}
+
+void
+TickScheduler::add(const RootContextPtr& root, const Object& handler)
+{
+    auto prepared = prepare(root->context(), handler);
+    if (!prepared)
+        return;
+
+    prepared->root = root;
+    schedule(prepared);
+}
+
+void
+TickScheduler::terminate()
+{
+    for (const auto& m : mBuckets)
+        mTimeManager->clearTimeout(m.second.timeout);
+    mBuckets.clear();
+}
+
+size_t
+TickScheduler::size() const
+{
+    size_t result = 0;
+    for (const auto& m : mBuckets)
+        result += m.second.handlers.size();
+    return result;
+}
+
+TickScheduler::HandlerPtr
+TickScheduler::prepare(const Context& context, const Object& handler)
+{
+    auto result = std::make_shared<Handler>();
+    result->period = std::max(propertyAsDouble(context, handler, "minimumDelay", 1000),
+                              context.getRootConfig().getTickHandlerUpdateLimit());
+    result->earliest = mTimeManager->currentTime() + result->period;
+
+    // A "when" clause that is not data-bound is resolved now.
+    auto when = handler.isMap() && handler.has("when") ? handler.get("when") : Object::TRUE_OBJECT();
+    result->whenBound = false;
+    if (when.isString()) {
+        auto compiled = datagrammar::ExpressionCache::instance().get(when.getString());
+        if (compiled->expression && (compiled->expression->type() != datagrammar::ExpressionTemplate::kConstant ||
+                                     compiled->expression->value().isString()))
+            result->whenBound = true;
+        else
+            when = evaluate(context, when);
+    }
+    result->when = when;
+
+    // Commands that don't need data-binding are arrayified once.
+    auto commands = handler.isMap() && handler.has("commands") ? handler.get("commands") : Object::EMPTY_ARRAY();
+    result->commandsBound = needsBinding(commands);
+    result->commands = result->commandsBound ? commands : arrayifyAsObject(context, commands);
+
+    // A handler that can never execute a command is not scheduled at all
+    if (!result->whenBound && !result->when.asBoolean())
+        return nullptr;
+    if (!result->commandsBound && result->commands.empty())
+        return nullptr;
+
+    return result;
+}
+
+void
+TickScheduler::schedule(const HandlerPtr& handler)
+{
+    auto period = handler->period;
+    auto it = mBuckets.find(period);
+    if (it == mBuckets.end()) {
+        auto timeout = mTimeManager->setTimeout([this, period]() { fire(period); }, period);
+        it = mBuckets.emplace(period, Bucket{timeout, mTimeManager->currentTime() + period, {}}).first;
+    }
+
+    it->second.handlers.emplace_back(handler);
+}
+
+void
+TickScheduler::fire(apl_duration_t period)
+{
+    auto it = mBuckets.find(period);
+    if (it == mBuckets.end())
+        return;
+
+    auto time = it->second.due;
+    auto handlers = std::move(it->second.handlers);
+    it->second.handlers.clear();
+    it->second.timeout = 0;
+
+    // Running a handler may add handlers to this bucket or terminate the scheduler
+    std::vector<HandlerPtr> remaining;
+    for (const auto& handler : handlers)
+        if (handler->earliest > time || run(*handler))
+            remaining.emplace_back(handler);
+
+    it = mBuckets.find(period);
+    if (it == mBuckets.end() || it->second.timeout != 0)
+        return;
+
+    auto& bucket = it->second;
+    remaining.insert(remaining.end(), bucket.handlers.begin(), bucket.handlers.end());
+    if (remaining.empty()) {
+        mBuckets.erase(it);
+        return;
+    }
+
+    bucket.handlers = std::move(remaining);
+    bucket.due = time + period;
+    bucket.timeout = mTimeManager->setTimeout([this, period]() { fire(period); }, period);
+}
+
+bool
+TickScheduler::run(const Handler& handler)
+{
+    auto root = handler.root.lock();
+    auto component = handler.component.lock();
+    if (!root && !component)
+        return false;
+
+    if (component && isSuspended(*component))
+        return true;
+
+    auto context = root ? root->createDocumentContext("Tick") : component->createEventContext("Tick");
+
+    auto when = handler.whenBound ? evaluate(*context, handler.when) : handler.when;
+    if (!when.asBoolean())
+        return true;
+
+    auto commands = handler.commandsBound ? arrayifyAsObject(*context, handler.commands) : handler.commands;
+    if (!commands.empty())
+        context->sequencer().executeCommands(commands, context, component, true);
+
+    return true;
+}
+
+} // namespace apl
@@ -14,6 +14,7 @@
  */
 
 #include "apl/engine/contextdependant.h"
+#include "apl/engine/recalculatebatch.h"
 #include "apl/engine/resources.h"
 #include "apl/engine/arrayify.h"
 #include "apl/graphic/graphic.h"
@@ -261,6 +262,7 @@ Graphic::layout(double width, double height, bool useDirtyFlag) {
     if (viewportWidthNew != viewportWidthActual || viewportHeightNew != viewportHeightActual) {
         mRootElement->setValue(kGraphicPropertyViewportWidthActual, viewportWidthNew, useDirtyFlag);
         mRootElement->setValue(kGraphicPropertyViewportHeightActual, viewportHeightNew, useDirtyFlag);
+        RecalculateBatch batch;
         mInternalContext->systemUpdateAndRecalculate("height", viewportHeightNew, useDirtyFlag);
         mInternalContext->systemUpdateAndRecalculate("width", viewportWidthNew, useDirtyFlag);
     }
@@ -313,11 +315,15 @@ Graphic::clearDirty()
 void
 Graphic::addDirtyChild(const GraphicElementPtr& child)
 {
+    auto component = mComponent.lock();
     if (mDirty.emplace(child).second) {
-        auto component = mComponent.lock();
         if (component)
             component->setDirty(kPropertyGraphic);
     }
+    else if (component) {
+        // Already dirty, but the serialized graphic has changed
+        component->invalidateSnapshot();
+    }
 }
 
 rapidjson::Value
@@ -19,6 +19,7 @@
 #include "apl/engine/context.h"
 #include "apl/engine/evaluate.h"
 #include "apl/primitives/symbolreferencemap.h"
+#include "apl/utils/arena.h"
 
 namespace apl {
 
@@ -29,7 +30,8 @@ GraphicDependant::create(const GraphicElementPtr& downstreamGraphicElement,
                          GraphicPropertyKey downstreamKey,
                          const Object& equation,
                          const ContextPtr& bindingContext,
-                         BindingFunction bindingFunction)
+                         BindingFunction bindingFunction,
+                         TimeGranularity granularity)
 {
     LOG_IF(DEBUG_GRAPHIC_DEP) << " to " << sGraphicPropertyBimap.at(downstreamKey)
                               << "(" << downstreamGraphicElement.get() << ")";
@@ -39,11 +41,11 @@ GraphicDependant::create(const GraphicElementPtr& downstreamGraphicElement,
     if (symbols.empty())
         return;
 
-    auto dependant = std::make_shared<GraphicDependant>(downstreamGraphicElement, downstreamKey, equation,
-                                                        bindingContext, bindingFunction);
+    auto dependant = allocateShared<GraphicDependant>(bindingContext->arena(),
+                                                      downstreamGraphicElement, downstreamKey, equation,
+                                                      bindingContext, bindingFunction);
 
-    for (const auto& symbol : symbols.get())
-        symbol.second->addDownstream(symbol.first, dependant);
+    dependant->connectSources(symbols, granularity);
 
     downstreamGraphicElement->addUpstream(downstreamKey, dependant);
 }
@@ -54,7 +56,7 @@ GraphicDependant::recalculate(bool useDirtyFlag) const
     auto downstream = mDownstreamGraphicElement.lock();
     auto bindingContext = mBindingContext.lock();
     if (downstream && bindingContext) {
-        auto value = mBindingFunction(*bindingContext, reevaluate(*bindingContext, mEquation));
+        auto value = mBindingFunction(*bindingContext, calculate(*bindingContext));
         LOG_IF(DEBUG_GRAPHIC_DEP) << " new value " << value.toDebugString();
         downstream->setValue(mDownstreamKey, value, useDirtyFlag);
     }
@@ -145,7 +145,8 @@ GraphicElement::setValue(GraphicPropertyKey key, const Object& value, bool useDi
     if (it->second.trigger != nullptr)
         it->second.trigger(*this);
 
-    if (useDirtyFlag && (it->second.flags & kPropOut) && mDirtyProperties.emplace(key).second) {
+    if (useDirtyFlag && (it->second.flags & kPropOut)) {
+        mDirtyProperties.emplace(key);
         markAsDirty();
     }
 
@@ -18,6 +18,7 @@
 #include "apl/component/corecomponent.h"
 #include "apl/livedata/livearrayobject.h"
 #include "apl/engine/builder.h"
+#include "apl/engine/recalculatebatch.h"
 
 namespace apl {
 
@@ -79,6 +80,29 @@ public:
         return false;
     }
 
+    /**
+     * Step over the children with a "dataIndex" less than dataIndex.  The children are sorted by
+     * "dataIndex", so a binary search finds the first child to keep without visiting the others.
+     * @param dataIndex The first data index to stop at.
+     * @param hasLastItem True if the layout has a "lastItem" child
+     * @return The number of children stepped over.
+     */
+    int skipBefore(int dataIndex, bool hasLastItem) {
+        int start = mIndex;
+        int end = mLayout->getChildCount() - (hasLastItem ? 1 : 0);
+        while (mIndex < end) {
+            int middle = mIndex + (end - mIndex) / 2;
+            auto value = mLayout->getCoreChildAt(middle)->getContext()->opt("dataIndex");
+            if (value.isNumber() && value.getInteger() < dataIndex)
+                mIndex = middle + 1;
+            else
+                end = middle;
+        }
+
+        LOG_IF(DEBUG_WALKER) << "skipped " << mIndex - start << " children before dataIndex=" << dataIndex;
+        return mIndex - start;
+    }
+
     void advance() {
         LOG_IF(DEBUG_WALKER) << "mIndex=" << mIndex << " total=" << mLayout->getChildCount();
         mIndex++;
@@ -88,6 +112,10 @@ public:
         return mLayout->getCoreChildAt(mIndex);
     }
 
+    CoreComponentPtr previousChild() {
+        return mLayout->getCoreChildAt(mIndex - 1);
+    }
+
 private:
     CoreComponentPtr mLayout;
     int mIndex;
@@ -108,6 +136,16 @@ inline ContextPtr findToken(const CoreComponentPtr& component, int token)
     return nullptr;
 }
 
+/**
+ * Return the ordinal of the child that follows this child.
+ */
+inline int nextOrdinal(const CoreComponentPtr& child, int ordinal)
+{
+    int numbering = child->getCalculated(kPropertyNumbering).getInteger();
+    if (numbering == kNumberingNormal) return ordinal + 1;
+    if (numbering == kNumberingReset) return 1;
+    return ordinal;
+}
 
 int LayoutRebuilder::sRebuilderToken = 100;
 
@@ -115,7 +153,7 @@ std::shared_ptr<LayoutRebuilder>
 LayoutRebuilder::create(const ContextPtr& context,
                         const CoreComponentPtr& layout,
                         const std::shared_ptr<LiveArrayObject>& array,
-                        const std::vector<Object>& items,
+                        const ComponentTemplateListPtr& items,
                         const Path& childPath,
                         bool numbered)
 {
@@ -127,10 +165,10 @@ LayoutRebuilder::create(const ContextPtr& context,
 LayoutRebuilder::LayoutRebuilder(const ContextPtr& context,
                                  const CoreComponentPtr& layout,
                                  const std::shared_ptr<LiveArrayObject>& array,
-                                 const std::vector<Object>& items,
+                                 const ComponentTemplateListPtr& items,
                                  const Path& childPath,
                                  bool numbered)
-    : mContext(context),
+    : mContext(Context::create(context)),
       mLayout(layout),
       mArray(array),
       mItems(items),
@@ -138,6 +176,9 @@ LayoutRebuilder::LayoutRebuilder(const ContextPtr& context,
       mNumbered(numbered),
       mRebuilderToken(sRebuilderToken++)
 {
+    // Values shared by all of the children are stored once
+    mContext->putSystemWriteable("length", array->size());
+
     mWatcherToken = array->addFlushCallback([this]() {
         rebuild();
     });
@@ -175,7 +216,6 @@ LayoutRebuilder::build()
         auto childContext = Context::create(mContext);
         childContext->putSystemWriteable("data", data);  // This can be changed
         childContext->putSystemWriteable("index", index);
-        childContext->putSystemWriteable("length", length);
         childContext->putSystemWriteable("dataIndex", dataIndex);  // This is an addition
         childContext->putSystemWriteable("_token", mRebuilderToken);  // Drop a token for later sanity checking
 
@@ -184,18 +224,15 @@ LayoutRebuilder::build()
 
         Properties childProps;
         auto child = Builder::expandSingleComponentFromArray(childContext,
-                                                             mItems,
+                                                             *mItems,
                                                              childProps,
                                                              layout, mChildPath);
         if (child && child->isValid()) {
             layout->appendChild(child, false);
             index++;
 
-            if (mNumbered) {
-                int numbering = child->getCalculated(kPropertyNumbering).getInteger();
-                if (numbering == kNumberingNormal) ordinal++;
-                else if (numbering == kNumberingReset) ordinal = 1;
-            }
+            if (mNumbered)
+                ordinal = nextOrdinal(child, ordinal);
         }
     }
 }
@@ -218,11 +255,19 @@ LayoutRebuilder::rebuild()
 
     auto walker = ChildWalker(layout, mHasFirstItem);
 
+    mContext->systemUpdateAndRecalculate("length", array->size(), true);
+
+    // The children in front of the first change have not moved and their data has not changed
+    int firstChanged = array->firstChanged();
+    int index = walker.skipBefore(firstChanged, mHasLastItem);
     int ordinal = 1;
-    int index = 0;
+    if (mNumbered && index > 0) {
+        auto previous = walker.previousChild();
+        ordinal = nextOrdinal(previous, previous->getContext()->opt("ordinal").getInteger());
+    }
 
     // Walk the list of new items
-    for (int newIndex = 0 ; newIndex < array->size() ; newIndex++) {
+    for (int newIndex = firstChanged ; newIndex < array->size() ; newIndex++) {
         const auto& data = array->at(newIndex);
         auto p = array->newToOld(newIndex);
         auto oldIndex = p.first;
@@ -232,16 +277,15 @@ LayoutRebuilder::rebuild()
             auto childContext = Context::create(mContext);
             childContext->putSystemWriteable("data", data);
             childContext->putSystemWriteable("index", index);
-            childContext->putSystemWriteable("length", array->size());
             childContext->putSystemWriteable("dataIndex", newIndex);  // This is an addition
             childContext->putSystemWriteable("_token", mRebuilderToken);  // Drop a token for later sanity checking
 
             if (mNumbered)
-                childContext->putConstant("ordinal", ordinal);
+                childContext->putSystemWriteable("ordinal", ordinal);
 
             Properties childProps;
             auto child = Builder::expandSingleComponentFromArray(childContext,
-                                                                 mItems,
+                                                                 *mItems,
                                                                  childProps,
                                                                  layout, mChildPath);
             if (child && child->isValid()) {
@@ -249,35 +293,32 @@ LayoutRebuilder::rebuild()
                 index++;
                 walker.advance();  // Must step over the child we just inserted
 
-                if (mNumbered) {
-                    int numbering = child->getCalculated(kPropertyNumbering).getInteger();
-                    if (numbering == kNumberingNormal) ordinal++;
-                    else if (numbering == kNumberingReset) ordinal = 1;
-                }
+                if (mNumbered)
+                    ordinal = nextOrdinal(child, ordinal);
             }
         } else if (walker.advanceUntil(oldIndex)) {
             // If we get here we found the old index and it should be updated
             auto child = walker.currentChild();
             auto childContext = findToken(child, mRebuilderToken);  // Search up through contexts to find the right one to modify
             if (childContext) {
-                // TODO: Can we optimize recalculation by batching these and only changing some of them?
-                childContext->systemUpdateAndRecalculate("index", index, true);
+                {
+                    // Dependants of several of these symbols are recalculated once.  Symbols that
+                    // have not changed do not trigger any recalculation.
+                    RecalculateBatch batch;
+                    childContext->systemUpdateAndRecalculate("index", index, true);
 
-                if (needsRefresh)
-                    childContext->systemUpdateAndRecalculate("data", data, true);
+                    if (needsRefresh)
+                        childContext->systemUpdateAndRecalculate("data", data, true);
 
-                childContext->systemUpdateAndRecalculate("length", array->size(), true);
-                childContext->systemUpdateAndRecalculate("dataIndex", newIndex, true);
-                childContext->systemUpdateAndRecalculate("ordinal", ordinal, true);
+                    childContext->systemUpdateAndRecalculate("dataIndex", newIndex, true);
+                    childContext->systemUpdateAndRecalculate("ordinal", ordinal, true);
+                }
 
                 index += 1;
                 walker.advance();
 
-                if (mNumbered) {
-                    int numbering = child->getCalculated(kPropertyNumbering).getInteger();
-                    if (numbering == kNumberingNormal) ordinal++;
-                    else if (numbering == kNumberingReset) ordinal = 1;
-                }
+                if (mNumbered)
+                    ordinal = nextOrdinal(child, ordinal);
             }
         }
     }
@@ -13,6 +13,8 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
+
 #include "apl/livedata/livearrayobject.h"
 #include "apl/livedata/livearray.h"
 #include "apl/livedata/livearraychange.h"
@@ -29,6 +31,7 @@ LiveArrayObject::LiveArrayObject(const LiveArrayPtr& liveArray, const ContextPtr
     mToken = liveArray->addChangeCallback([this](const LiveArrayChange& change) {
         handleArrayMessage(change);
     });
+    resetChanges();
 }
 
 LiveArrayObject::~LiveArrayObject() {
@@ -76,17 +79,123 @@ LiveArrayObject::handleArrayMessage(const LiveArrayChange& change)
     if (mReplaced)
         return;
 
-    if (change.command() == LiveArrayChange::REPLACE) {
-        mReplaced = true;
-        mChanges.clear();
-    }
-    else {
-        mChanges.push_back(change);
+    auto position = change.position();
+    auto count = change.count();
+
+    switch (change.command()) {
+        case LiveArrayChange::REPLACE:
+            mReplaced = true;
+            mSegments.clear();
+            break;
+
+        case LiveArrayChange::INSERT: {
+            auto index = split(position);
+            mSegments.insert(mSegments.begin() + index, Segment{position, count, -1, false});
+            shift(index + 1, count, true);
+            coalesce(index > 0 ? index - 1 : 0, index + 2);
+            break;
+        }
+
+        case LiveArrayChange::REMOVE: {
+            auto first = split(position);
+            auto last = split(position + count);
+            mSegments.erase(mSegments.begin() + first, mSegments.begin() + last);
+            shift(first, count, false);
+            coalesce(first > 0 ? first - 1 : 0, first + 1);
+            break;
+        }
+
+        case LiveArrayChange::UPDATE: {
+            auto first = split(position);
+            auto last = split(position + count);
+            for (auto i = first ; i < last ; i++)
+                if (mSegments[i].old != -1)
+                    mSegments[i].changed = true;
+            coalesce(first > 0 ? first - 1 : 0, last + 1);
+            break;
+        }
     }
 
     markDirty();
 }
 
+void
+LiveArrayObject::resetChanges()
+{
+    mSegments.clear();
+    auto length = size();
+    if (length > 0)
+        mSegments.emplace_back(Segment{0, length, 0, false});
+}
+
+/**
+ * Make sure that a segment starts at this position.
+ * @param position A current index in the array.  It may be equal to the length of the array.
+ * @return The offset of the segment starting at position, or the number of segments if the
+ *         position is the end of the array.
+ */
+size_t
+LiveArrayObject::split(size_type position)
+{
+    auto it = std::upper_bound(mSegments.begin(), mSegments.end(), position,
+                               [](size_type value, const Segment& segment) { return value < segment.start; });
+    if (it == mSegments.begin())
+        return 0;
+
+    auto index = std::distance(mSegments.begin(), it) - 1;
+    auto& segment = mSegments[index];
+    if (segment.start == position)
+        return index;
+
+    auto offset = position - segment.start;
+    if (offset >= segment.count)
+        return index + 1;
+
+    Segment tail{position, segment.count - offset, segment.old == -1 ? -1 : segment.old + static_cast<int>(offset),
+                 segment.changed};
+    segment.count = offset;
+    mSegments.insert(mSegments.begin() + index + 1, tail);
+    return index + 1;
+}
+
+/**
+ * Merge adjacent segments in the range [first, last) that continue each other.
+ */
+void
+LiveArrayObject::coalesce(size_t first, size_t last)
+{
+    last = std::min(last, mSegments.size());
+    auto i = first;
+    while (i + 1 < last) {
+        auto& a = mSegments[i];
+        const auto& b = mSegments[i + 1];
+        bool inserted = a.old == -1 && b.old == -1;
+        bool continued = a.old != -1 && b.old == a.old + static_cast<int>(a.count) && a.changed == b.changed;
+        if (inserted || continued) {
+            a.count += b.count;
+            mSegments.erase(mSegments.begin() + i + 1);
+            last--;
+        }
+        else {
+            i++;
+        }
+    }
+}
+
+/**
+ * Move the start of each segment from first onwards.
+ */
+void
+LiveArrayObject::shift(size_t first, size_type count, bool increase)
+{
+    for (auto i = first ; i < mSegments.size() ; i++) {
+        if (increase)
+            mSegments[i].start += count;
+        else
+            mSegments[i].start -= count;
+    }
+}
+
 /**
  * Return the index of the old item and a flag if that item has changed value.
  * The index is -1 if the item is completely new.
@@ -99,33 +208,29 @@ LiveArrayObject::newToOld(ObjectArray::size_type index)
     if (mReplaced)
         return {-1, false};
 
-    bool changed = false;
-
-    for (auto it = mChanges.rbegin() ; it != mChanges.rend() ; it++) {
-        auto cmd = it->command();
-        auto position = it->position();
-        auto count = it->count();
-        switch (cmd) {
-            case LiveArrayChange::REMOVE:
-                if (index >= position)
-                    index += count;
-                break;
-            case LiveArrayChange::UPDATE:
-                if (index >= position && index < position + count)
-                    changed = true;
-                break;
-            case LiveArrayChange::INSERT:
-                if (index >= position + count)
-                    index -= count;
-                else if (index >= position)
-                    return {-1, false};
-                break;
-            default:
-                break;
-        }
-    }
+    auto it = std::upper_bound(mSegments.begin(), mSegments.end(), index,
+                               [](size_type value, const Segment& segment) { return value < segment.start; });
+    if (it == mSegments.begin())
+        return {-1, false};
+
+    const auto& segment = *(it - 1);
+    if (index >= segment.start + segment.count || segment.old == -1)
+        return {-1, false};
+
+    return { segment.old + static_cast<int>(index - segment.start), segment.changed };
+}
+
+ObjectArray::size_type
+LiveArrayObject::firstChanged() const
+{
+    if (mReplaced)
+        return 0;
+
+    for (const auto& m : mSegments)
+        if (m.changed || m.old != static_cast<int>(m.start))
+            return m.start;
 
-    return { index, changed };
+    return size();
 }
 
 } // namespace apl
\ No newline at end of file
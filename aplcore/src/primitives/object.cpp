@@ -14,6 +14,7 @@
  */
 
 #include <clocale>
+#include <new>
 
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
@@ -109,105 +110,192 @@ Object Object::LINEAR_EASING() {
 
 /****************************************************************************/
 
-Object::Object(const Object& object) noexcept
-        : mType(object.mType)
+namespace {
+
+// The member of the Object storage union used by each type
+enum ObjectStorage {
+    kStorageValue,
+    kStorageString,
+    kStorageData,
+    kStorageRect,
+    kStorageRadii,
+    kStorageTransform2D
+};
+
+inline ObjectStorage
+storageOf(Object::ObjectType type)
 {
-    switch (mType) {
-        case kBoolType:
-        case kNumberType:
-        case kAbsoluteDimensionType:
-        case kRelativeDimensionType:
-        case kAutoDimensionType:
-        case kColorType:
-            mValue = object.mValue;
-            break;
-        case kStringType:
-            mString = object.mString;
-            break;
+    switch (type) {
+        case Object::kNullType:
+        case Object::kBoolType:
+        case Object::kNumberType:
+        case Object::kAbsoluteDimensionType:
+        case Object::kRelativeDimensionType:
+        case Object::kAutoDimensionType:
+        case Object::kColorType:
+            return kStorageValue;
+        case Object::kStringType:
+            return kStorageString;
+        case Object::kRectType:
+            return kStorageRect;
+        case Object::kRadiiType:
+            return kStorageRadii;
+        case Object::kTransform2DType:
+            return kStorageTransform2D;
         default:
-            mData = object.mData;
-            break;
+            return kStorageData;
     }
 }
 
-Object::Object(Object&& object) noexcept
-        : mType(object.mType)
+} // namespace
+
+/**
+ * Default-construct the member of the storage union selected by the current type.
+ */
+void
+Object::initialize()
 {
-    switch (mType) {
-        case kBoolType:
-        case kNumberType:
-        case kAbsoluteDimensionType:
-        case kRelativeDimensionType:
-        case kAutoDimensionType:
-        case kColorType:
-            mValue = object.mValue;
-            break;
-        case kStringType:
-            mString = std::move(object.mString);
-            break;
-        default:
-            mData = std::move(object.mData);
-            break;
+    switch (storageOf(mType)) {
+        case kStorageValue: mValue = 0; break;
+        case kStorageString: new (&mString) std::string(); break;
+        case kStorageData: new (&mData) std::shared_ptr<ObjectData>(); break;
+        case kStorageRect: new (&mRect) Rect(); break;
+        case kStorageRadii: new (&mRadii) Radii(); break;
+        case kStorageTransform2D: new (&mTransform2D) Transform2D(); break;
+    }
+}
+
+void
+Object::construct(const Object& other)
+{
+    mType = other.mType;
+    switch (storageOf(mType)) {
+        case kStorageValue: mValue = other.mValue; break;
+        case kStorageString: new (&mString) std::string(other.mString); break;
+        case kStorageData: new (&mData) std::shared_ptr<ObjectData>(other.mData); break;
+        case kStorageRect: new (&mRect) Rect(other.mRect); break;
+        case kStorageRadii: new (&mRadii) Radii(other.mRadii); break;
+        case kStorageTransform2D: new (&mTransform2D) Transform2D(other.mTransform2D); break;
+    }
+}
+
+void
+Object::construct(Object&& other)
+{
+    mType = other.mType;
+    switch (storageOf(mType)) {
+        case kStorageValue: mValue = other.mValue; break;
+        case kStorageString: new (&mString) std::string(std::move(other.mString)); break;
+        case kStorageData: new (&mData) std::shared_ptr<ObjectData>(std::move(other.mData)); break;
+        case kStorageRect: new (&mRect) Rect(other.mRect); break;
+        case kStorageRadii: new (&mRadii) Radii(other.mRadii); break;
+        case kStorageTransform2D: new (&mTransform2D) Transform2D(other.mTransform2D); break;
     }
 }
 
+void
+Object::destroy()
+{
+    // The numeric and POD members have trivial destructors
+    switch (storageOf(mType)) {
+        case kStorageString: mString.~basic_string(); break;
+        case kStorageData: mData.~shared_ptr(); break;
+        default: break;
+    }
+}
+
+Object::Object(const Object& object) noexcept
+{
+    construct(object);
+}
+
+Object::Object(Object&& object) noexcept
+{
+    construct(std::move(object));
+}
+
 Object& Object::operator=(const Object& rhs) noexcept
 {
     if (this == &rhs)
         return *this;
 
-    mType = rhs.mType;
-    switch (mType) {
-        case kBoolType:
-        case kNumberType:
-        case kAbsoluteDimensionType:
-        case kRelativeDimensionType:
-        case kAutoDimensionType:
-        case kColorType:
-            mValue = rhs.mValue;
-            break;
-        case kStringType:
-            mString = rhs.mString;
-            break;
-        default:
-            mData = rhs.mData;
-            break;
+    auto storage = storageOf(rhs.mType);
+    if (storage == storageOf(mType)) {
+        mType = rhs.mType;
+        switch (storage) {
+            case kStorageValue: mValue = rhs.mValue; break;
+            case kStorageString: mString = rhs.mString; break;
+            case kStorageData: mData = rhs.mData; break;
+            case kStorageRect: mRect = rhs.mRect; break;
+            case kStorageRadii: mRadii = rhs.mRadii; break;
+            case kStorageTransform2D: mTransform2D = rhs.mTransform2D; break;
+        }
+        return *this;
     }
 
+    // The right-hand side may be owned by this object, so copy it before releasing our storage
+    Object tmp(rhs);
+    destroy();
+    construct(std::move(tmp));
     return *this;
 }
 
 Object& Object::operator=(Object&& rhs) noexcept
 {
-    mType = rhs.mType;
-    switch (mType) {
-        case kBoolType:
-        case kNumberType:
-        case kAbsoluteDimensionType:
-        case kRelativeDimensionType:
-        case kAutoDimensionType:
-        case kColorType:
-            mValue = rhs.mValue;
-            break;
-        case kStringType:
-            mString = std::move(rhs.mString);
-            break;
-        default:
-            mData = std::move(rhs.mData);
-            break;
+    if (this == &rhs)
+        return *this;
+
+    auto storage = storageOf(rhs.mType);
+    if (storage == storageOf(mType)) {
+        mType = rhs.mType;
+        switch (storage) {
+            case kStorageValue: mValue = rhs.mValue; break;
+            case kStorageString: mString = std::move(rhs.mString); break;
+            case kStorageData: mData = std::move(rhs.mData); break;
+            case kStorageRect: mRect = rhs.mRect; break;
+            case kStorageRadii: mRadii = rhs.mRadii; break;
+            case kStorageTransform2D: mTransform2D = rhs.mTransform2D; break;
+        }
+        return *this;
     }
 
+    Object tmp(std::move(rhs));
+    destroy();
+    construct(std::move(tmp));
     return *this;
 }
 
+template<typename T> const T& Object::as() const {
+    assert(mType == DirectObjectData<T>::sType);
+    return *static_cast<const T*>(mData->inner());
+}
+
+// Rectangles, radii, and 2D transformations are stored inline
+template<> const Rect& Object::as<Rect>() const {
+    assert(mType == kRectType);
+    return mRect;
+}
+
+template<> const Radii& Object::as<Radii>() const {
+    assert(mType == kRadiiType);
+    return mRadii;
+}
+
+template<> const Transform2D& Object::as<Transform2D>() const {
+    assert(mType == kTransform2DType);
+    return mTransform2D;
+}
+
 /****************************************************************************/
 
 Object::~Object() {
     LOG_IF(OBJECT_DEBUG) << "  --- Destroying " << *this;
+    destroy();
 }
 
 Object::Object()
-    : mType(kNullType)
+    : mType(kNullType),
+      mValue(0)
 {
     LOG_IF(OBJECT_DEBUG) << "Object null constructor" << this;
 }
@@ -215,6 +303,7 @@ Object::Object()
 Object::Object(ObjectType type)
     : mType(type)
 {
+    initialize();
     LOG_IF(OBJECT_DEBUG) << "Object type constructor" << this;
 }
 
@@ -321,7 +410,8 @@ Object::Object(const std::shared_ptr<ContextWrapper>& c)
 }
 
 Object::Object(const rapidjson::Value& value)
-    : mValue(0)
+    : mType(kNullType),
+      mValue(0)
 {
     LOG_IF(OBJECT_DEBUG) << "Object constructor value: " << this;
 
@@ -343,21 +433,22 @@ Object::Object(const rapidjson::Value& value)
         break;
     case rapidjson::kStringType:
         mType = kStringType;
-        mString = value.GetString();  // TODO: Should we keep the string in place?
+        new (&mString) std::string(value.GetString());  // TODO: Should we keep the string in place?
         break;
     case rapidjson::kObjectType:
         mType = kMapType;
-        mData = std::static_pointer_cast<ObjectData>(std::make_shared<JSONData>(&value));
+        new (&mData) std::shared_ptr<ObjectData>(std::make_shared<JSONData>(&value));
         break;
     case rapidjson::kArrayType:
         mType = kArrayType;
-        mData = std::static_pointer_cast<ObjectData>(std::make_shared<JSONData>(&value));
+        new (&mData) std::shared_ptr<ObjectData>(std::make_shared<JSONData>(&value));
         break;
     }
 }
 
 Object::Object(rapidjson::Document&& value)
-    : mValue(0)
+    : mType(kNullType),
+      mValue(0)
 {
     if (OBJECT_DEBUG) LOG(LogLevel::DEBUG) << "Object constructor value: " << this;
 
@@ -379,15 +470,15 @@ Object::Object(rapidjson::Document&& value)
             break;
         case rapidjson::kStringType:
             mType = kStringType;
-            mString = value.GetString();  // TODO: Should we keep the string in place?
+            new (&mString) std::string(value.GetString());  // TODO: Should we keep the string in place?
             break;
         case rapidjson::kObjectType:
             mType = kMapType;
-            mData = std::static_pointer_cast<ObjectData>(std::make_shared<JSONDocumentData>(std::move(value)));
+            new (&mData) std::shared_ptr<ObjectData>(std::make_shared<JSONDocumentData>(std::move(value)));
             break;
         case rapidjson::kArrayType:
             mType = kArrayType;
-            mData = std::static_pointer_cast<ObjectData>(std::make_shared<JSONDocumentData>(std::move(value)));
+            new (&mData) std::shared_ptr<ObjectData>(std::make_shared<JSONDocumentData>(std::move(value)));
             break;
     }
 }
@@ -439,14 +530,14 @@ Object::Object(MediaSource&& mediaSource)
 
 Object::Object(Rect&& rect)
     : mType(DirectObjectData<Rect>::sType),
-      mData(DirectObjectData<Rect>::create(std::move(rect)))
+      mRect(rect)
 {
     LOG_IF(OBJECT_DEBUG) << "Object Rect constructor " << this;
 }
 
 Object::Object(Radii&& radii)
     : mType(DirectObjectData<Radii>::sType),
-      mData(DirectObjectData<Radii>::create(std::move(radii)))
+      mRadii(radii)
 {
     LOG_IF(OBJECT_DEBUG) << "Object Radii constructor " << this;
 }
@@ -481,7 +572,7 @@ Object::Object(const std::shared_ptr<Transformation>& transform)
 
 Object::Object(Transform2D&& transform)
     : mType(DirectObjectData<Transform2D>::sType),
-      mData(DirectObjectData<Transform2D>::create(std::move(transform)))
+      mTransform2D(transform)
 {
     LOG_IF(OBJECT_DEBUG) << "Object transform 2D constructor " << this;
 }
@@ -556,11 +647,15 @@ Object::operator==(const Object& rhs) const
         case kGradientType:
         case kFilterType:
         case kMediaSourceType:
+        case kStyledTextType:
+            return *(mData.get()) == *(rhs.mData.get());
+
         case kRectType:
+            return mRect == rhs.mRect;
         case kRadiiType:
+            return mRadii == rhs.mRadii;
         case kTransform2DType:
-        case kStyledTextType:
-            return *(mData.get()) == *(rhs.mData.get());
+            return mTransform2D == rhs.mTransform2D;
 
         case kGraphicType:
             return mData == rhs.mData;
@@ -989,13 +1084,17 @@ Object::truthy() const
         case kGradientType:
         case kMediaSourceType:
         case kEasingType:
-        case kRectType:
-        case kRadiiType:
-        case kTransform2DType:
         case kStyledTextType:
         case kGraphicPatternType:
             return mData->truthy();
 
+        case kRectType:
+            return mRect.truthy();
+        case kRadiiType:
+            return mRadii.truthy();
+        case kTransform2DType:
+            return mTransform2D.truthy();
+
         case kGraphicType:
             return true;
         case kTransformType:
@@ -1076,9 +1175,10 @@ Object::empty() const
             return true;
         case kArrayType:
         case kMapType:
-        case kRectType:
         case kGraphicPatternType:
             return mData->empty();
+        case kRectType:
+            return mRect.empty();
         case kStringType:
             return mString.empty();
         case kStyledTextType:
@@ -1257,13 +1357,16 @@ Object::serialize(rapidjson::Document::AllocatorType& allocator) const
         case kFilterType:
         case kGradientType:
         case kMediaSourceType:
-        case kRectType:
-        case kRadiiType:
         case kEasingType:
-        case kTransform2DType:
         case kStyledTextType:
         case kGraphicPatternType:
             return mData->serialize(allocator);
+        case kRectType:
+            return mRect.serialize(allocator);
+        case kRadiiType:
+            return mRadii.serialize(allocator);
+        case kTransform2DType:
+            return mTransform2D.serialize(allocator);
         case kGraphicType:
             return getGraphic()->serialize(allocator);
         case kTransformType:
@@ -1292,11 +1395,6 @@ Object::serializeDirty(rapidjson::Document::AllocatorType& allocator) const
     }
 }
 
-template<typename T> const T& Object::as() const {
-    assert(mType == DirectObjectData<T>::sType);
-    return *static_cast<const T*>(mData->inner());
-}
-
 std::string
 Object::toDebugString() const
 {
@@ -1322,16 +1420,19 @@ Object::toDebugString() const
             return "AutoDim";
         case Object::kColorType:
             return asString();
+        case Object::kRectType:
+            return mRect.toDebugString();
+        case Object::kRadiiType:
+            return mRadii.toDebugString();
+        case Object::kTransform2DType:
+            return mTransform2D.toDebugString();
         case Object::kFilterType:
         case Object::kGradientType:
         case Object::kMediaSourceType:
-        case Object::kRectType:
-        case Object::kRadiiType:
         case Object::kStyledTextType:
         case Object::kGraphicType:
         case Object::kGraphicPatternType:
         case Object::kTransformType:
-        case Object::kTransform2DType:
         case Object::kEasingType:
         case Object::kBoundSymbolType:
         case Object::kComponentType:
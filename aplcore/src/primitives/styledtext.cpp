@@ -13,57 +13,52 @@
  * permissions and limitations under the License.
  */
 
-#include <regex>
+#include <algorithm>
+#include <cctype>
 #include <vector>
-#include <stack>
-#include <set>
-#include <locale>
-#include <codecvt>
-
-#include <tao/pegtl.hpp>
 
 #include "apl/primitives/object.h"
 #include "apl/primitives/styledtext.h"
 
-
 namespace apl {
 
-namespace pegtl = tao::TAO_PEGTL_NAMESPACE;
-using namespace pegtl;
-
-const std::map<std::string, StyledText::SpanType> sTextSpanTypeMap = {
-        {"br", StyledText::kSpanTypeLineBreak},
-        {"strong", StyledText::kSpanTypeStrong},
-        {"b", StyledText::kSpanTypeStrong},
-        {"em", StyledText::kSpanTypeItalic},
-        {"i", StyledText::kSpanTypeItalic},
-        {"strike", StyledText::kSpanTypeStrike},
-        {"u", StyledText::kSpanTypeUnderline},
-        {"tt", StyledText::kSpanTypeMonospace},
-        {"code", StyledText::kSpanTypeMonospace},
-        {"sup", StyledText::kSpanTypeSuperscript},
-        {"sub", StyledText::kSpanTypeSubscript},
+struct SpanTag {
+    const char *name;
+    size_t length;
+    StyledText::SpanType type;
 };
 
-const std::map<std::string, std::string> sTextSpecialEntity = {
-        {"&amp;", "&"},
-        {"&lt;", "<"},
-        {"&gt;", ">"},
+static const SpanTag sTextSpanTags[] = {
+        {"br",     2, StyledText::kSpanTypeLineBreak},
+        {"strong", 6, StyledText::kSpanTypeStrong},
+        {"b",      1, StyledText::kSpanTypeStrong},
+        {"em",     2, StyledText::kSpanTypeItalic},
+        {"i",      1, StyledText::kSpanTypeItalic},
+        {"strike", 6, StyledText::kSpanTypeStrike},
+        {"u",      1, StyledText::kSpanTypeUnderline},
+        {"tt",     2, StyledText::kSpanTypeMonospace},
+        {"code",   4, StyledText::kSpanTypeMonospace},
+        {"sup",    3, StyledText::kSpanTypeSuperscript},
+        {"sub",    3, StyledText::kSpanTypeSubscript},
 };
 
-/**
- * Character converter to be used for multi-byte sized characters.
- */
-#ifdef APL_CORE_UWP
-// avoids a runtime crash on UWP
-// see:  https://tinyurl.com/ra2coob
-static std::wstring_convert<std::codecvt_utf8<wchar_t>> wchar_converter;
-#else
-static std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> wchar_converter;
-#endif
+struct SpecialEntity {
+    const char *name;
+    size_t length;
+    char value;
+};
+
+static const SpecialEntity sTextSpecialEntities[] = {
+        {"&amp;", 5, '&'},
+        {"&lt;",  4, '<'},
+        {"&gt;",  4, '>'},
+};
+
+static const char *REPLACEMENT_CHARACTER = "\xEF\xBF\xBD";  // U+FFFD
+static const unsigned long MAX_CODE_POINT = 0x10FFFF;
 
 /**
- * Internal utility to identify control characters.
+ * Internal utility to identify control characters.  These are treated as spaces.
  * @param c input character.
  * @return true if control, false otherwise.
  */
@@ -73,87 +68,116 @@ static inline bool controlChar(char c)
 }
 
 /**
- * Internal utility to strip control characters from string.
- * @param str string to process.
- * @return string without control characters.
+ * Characters that end a word: markup, whitespace and control characters.
  */
-static inline std::string stripControl(const std::string& str)
-{
-    std::string output;
-
-    for(char c : str) {
-        if(!controlChar(c)) output += c;
-        else output += ' ';
+class WordBreaks {
+public:
+    WordBreaks() : mBreaks() {
+        for (int c = 1 ; c <= 32 ; c++)
+            mBreaks[c] = true;
+        mBreaks[static_cast<unsigned char>('<')] = true;
+        mBreaks[static_cast<unsigned char>('>')] = true;
+        mBreaks[static_cast<unsigned char>('&')] = true;
     }
 
-    return output;
-}
+    bool operator[](char c) const { return mBreaks[static_cast<unsigned char>(c)]; }
+
+private:
+    bool mBreaks[256];
+};
+
+static const WordBreaks sWordBreaks;
 
 /**
- * Internal utility to convert string to lowercase.
- * Not using transform as it does it inplace.
- * Applicable only to latin characters.
- * @param str string to process.
- * @return lowercase version of str.
+ * Find the tag name in the list of supported styles, ignoring case.
+ * @return True if the tag is supported.
  */
-static inline std::string tolower(const std::string& str) {
-    std::string output = str;
+static bool
+findSpanType(const char *tag, size_t length, StyledText::SpanType& type)
+{
+    for (const auto& m : sTextSpanTags) {
+        if (m.length != length)
+            continue;
 
-    std::transform(output.begin(), output.end(), output.begin(), [](unsigned char ch) {
-        return std::tolower(ch);
-    });
+        size_t i = 0;
+        while (i < length && std::tolower(static_cast<unsigned char>(tag[i])) == m.name[i])
+            i++;
 
-    return output;
-}
+        if (i == length) {
+            type = m.type;
+            return true;
+        }
+    }
 
-static inline std::string rtrim(const std::string &str) {
-    std::string output(str);
-    output.erase(std::find_if(output.rbegin(), output.rend(), [](unsigned char ch) {
-                     return !std::isspace(ch);
-                 }).base(),
-                 output.end());
-    return output;
+    return false;
 }
 
 /**
- * Internal builder to construct StyledText during PEGTL parsing.
+ * Internal builder to construct StyledText while parsing.
  */
 class StyledTextState {
 public:
-    StyledTextState() = default;
+    explicit StyledTextState(std::string& text) : mText(text) {}
 
     /**
      * Append text to raw text "container".
-     * @param val text to append.
+     * @param data The text to append.
+     * @param length The number of bytes to append.
+     * @param count The number of characters in the text.
      */
-    void append( const std::string& val ) {
-        wchar_converter.to_bytes(wchar_converter.from_bytes(val.c_str()));
+    void append(const char *data, size_t length, size_t count) {
+        mPosition += count;
+        mText.append(data, length);
+    }
 
-        // Get real number of characters.
-        mPosition += wchar_converter.converted();
-        mText = mText.append(val);
+    /**
+     * Append a single code point, encoded as UTF-8.
+     * @param code The code point.
+     */
+    void appendCodePoint(unsigned long code) {
+        if (code > MAX_CODE_POINT || (code >= 0xD800 && code <= 0xDFFF)) {
+            mText.append(REPLACEMENT_CHARACTER);
+        }
+        else if (code < 0x80) {
+            mText.push_back(static_cast<char>(code));
+        }
+        else if (code < 0x800) {
+            mText.push_back(static_cast<char>(0xC0 | (code >> 6)));
+            mText.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        }
+        else if (code < 0x10000) {
+            mText.push_back(static_cast<char>(0xE0 | (code >> 12)));
+            mText.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            mText.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        }
+        else {
+            mText.push_back(static_cast<char>(0xF0 | (code >> 18)));
+            mText.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+            mText.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            mText.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        }
+        mPosition += 1;
     }
 
     /**
-     * Add space. Avoids wchar processing for spaces.
+     * Add space.
      */
     void space() {
-        mPosition+=1;
-        mText = mText.append(" ");
+        mPosition += 1;
+        mText.push_back(' ');
     }
 
     /**
      * Start style span on current text position.
      * @param tag style tag.
+     * @param length The length of the tag.
      */
-    void start(const std::string& tag) {
-        auto typeIt = sTextSpanTypeMap.find(tolower(tag));
-        if(typeIt == sTextSpanTypeMap.end()) {
+    void start(const char *tag, size_t length) {
+        StyledText::SpanType type;
+        if (!findSpanType(tag, length, type))
             return;
-        }
 
-        auto type = typeIt->second;
-        if(StyledText::kSpanTypeLineBreak == type) {
+        if (StyledText::kSpanTypeLineBreak == type) {
             // Handle as single tag.
             single(type);
             return;
@@ -162,59 +186,28 @@ public:
         size_t start = mPosition;
         // If type same as previously closed tag - merge it instead of creating new one.
         // TODO: Not ideal but simple enough. Nested merging to be added if we see problems with viewhost performance.
-        if(!mSpans.empty()) {
-            auto previous = mSpans.back();
+        if (!mSpans.empty()) {
+            const auto& previous = mSpans.back();
             if (previous.type == type && previous.end == mPosition) {
                 start = previous.start;
                 mSpans.pop_back();
             }
         }
 
-        mOpenedSpans.insert(type);
-        mBuildStack.push(StyledText::Span(start, type));
+        mOpenedSpans |= 1u << type;
+        mBuildStack.emplace_back(StyledText::Span(start, type));
     }
 
     /**
      * End style span on current text position. In case if tag was not opened it will close current one and move up to
      * "parent". This implementation effectively replicates html behavior.
      * @param tag style tag.
+     * @param length The length of the tag.
      */
-    void end(const std::string& tag) {
-        auto typeIt = sTextSpanTypeMap.find(tolower(tag));
-        if(typeIt == sTextSpanTypeMap.end()) {
-            return;
-        }
-
-        auto type = typeIt->second;
-
-        if(mOpenedSpans.find(type) == mOpenedSpans.end()) {
-            // No opened tag available
-            return;
-        }
-
-        if(StyledText::kSpanTypeLineBreak == type) {
-            // Handle as single tag.
-            single(type);
-            return;
-        }
-
-        auto& span = mBuildStack.top();
-        mBuildStack.pop();
-
-        // If start == end then span is unnecessary so don't record it
-        if(span.start != mPosition) {
-            span.end = mPosition;
-            mSpans.emplace_back(span);
-        }
-
-        // If not equal then likely tag is unclosed so close it (above) and try again. This will split
-        // intersecting/wrongly closed tags to separate spans in order to simplify view-host processing.
-        if(span.type != type) {
-            end(tag);
-            mBuildStack.push(StyledText::Span(mPosition, span.type));
-        } else {
-            mOpenedSpans.erase(type);
-        }
+    void end(const char *tag, size_t length) {
+        StyledText::SpanType type;
+        if (findSpanType(tag, length, type))
+            end(type);
     }
 
     /**
@@ -230,32 +223,46 @@ public:
      * @return Vector of style spans.
      */
     std::vector<StyledText::Span> finalize() {
-        std::vector<StyledText::Span> output;
-        while(!mBuildStack.empty()) {
-            auto span = mBuildStack.top();
-            mBuildStack.pop();
+        while (!mBuildStack.empty()) {
+            auto span = mBuildStack.back();
+            mBuildStack.pop_back();
             span.end = mPosition;
             mSpans.emplace_back(span);
         }
 
         std::sort(mSpans.begin(), mSpans.end(), spanComparator);
-        for(auto s : mSpans) {
-            output.emplace_back(s);
+        return std::move(mSpans);
+    }
+
+private:
+    void end(StyledText::SpanType type) {
+        // Line breaks are never opened
+        if (!(mOpenedSpans & (1u << type)))
+            return;
+
+        auto span = mBuildStack.back();
+        mBuildStack.pop_back();
+
+        // If start == end then span is unnecessary so don't record it
+        if (span.start != mPosition) {
+            span.end = mPosition;
+            mSpans.emplace_back(span);
         }
 
-        return output;
+        // If not equal then likely tag is unclosed so close it (above) and try again. This will split
+        // intersecting/wrongly closed tags to separate spans in order to simplify view-host processing.
+        if (span.type != type) {
+            end(type);
+            mBuildStack.emplace_back(StyledText::Span(mPosition, span.type));
+        } else {
+            mOpenedSpans &= ~(1u << type);
+        }
     }
 
-    /**
-     * @return text.
-     */
-    std::string& getText() {return mText;}
-
-private:
-    std::stack<StyledText::Span> mBuildStack;
-    std::set<StyledText::SpanType> mOpenedSpans;
+    std::vector<StyledText::Span> mBuildStack;
+    unsigned int mOpenedSpans = 0;  // Bit set of the span types in mBuildStack
     std::vector<StyledText::Span> mSpans;
-    std::string mText;
+    std::string& mText;
     size_t mPosition = 0;
 
     struct {
@@ -277,126 +284,314 @@ private:
     } spanComparator;
 };
 
-struct quote : sor<one<'"'>, one<'\''>> {};
-struct attributes :
-        seq<plus<space>, until<
-            seq<
-                quote, star<space>,
-                at<sor<one<'>'>, string<'/','>'>>
-                >>>> {};
-
-struct markdownchar : one<'<','>','&'>{};
-struct stringentity : seq<one<'&'>, plus<alpha>, one<';'>>{};
-struct decnum : plus<digit>{};
-struct decentity : seq<one<'&'>, one<'#'>, decnum, one<';'>>{};
-struct hexnum : plus<xdigit>{};
-struct hexentity : seq<one<'&'>, one<'#'>, one<'x'>, hexnum, one<';'>>{};
-struct specialentity : sor<hexentity,decentity,stringentity>{};
-struct symbol : not_one<'<','>','&',' '>{}; // Exclude markdown and whitespace collapsing.
-struct word : plus<symbol>{};
-struct ws : plus<space>{};
-struct tagname : plus<alnum>{};
-struct stagname : tagname{};
-struct stag : seq<one<'<'>,opt<star<space>>,stagname,opt<attributes>,opt<star<space>>, one<'>'>>{};
-struct etagname : tagname{};
-struct etag : seq<one<'<'>,one<'/'>,opt<star<space>>,etagname,opt<star<space>>,one<'>'>>{};
-// Start tag and single tag is too similar to do exact match so define line break itself.
-struct br : seq<star<space>,one<'<'>,opt<star<space>>,seq<one<'b','B'>,one<'r','R'>>,opt<attributes>,opt<star<space>>,opt<one<'/'>>,one<'>'>,star<space>>{};
-struct utag : seq<one<'<'>,opt<star<space>>,tagname,opt<attributes>,opt<star<space>>,one<'/'>,one<'>'>>{};
-struct element : sor<br, utag, stag, etag, specialentity, markdownchar, word, ws>{};
-// Trim starting spaces here as it's easy.
-struct styledtext : seq<star<space>,star<element>,eof>{};
-
-template<typename Rule>
-struct action : nothing< Rule >
-{
-};
+/**
+ * Single-pass parser for styled text.  The grammar, in order of precedence at each position:
+ *
+ *   styledtext    ::= space* element*
+ *   element       ::= br | utag | stag | etag | specialentity | markdownchar | word | ws
+ *   br            ::= space* '<' space* [bB][rR] attributes? space* '/'? '>' space*
+ *   utag          ::= '<' space* tagname attributes? space* '/' '>'
+ *   stag          ::= '<' space* tagname attributes? space* '>'
+ *   etag          ::= '<' '/' space* tagname space* '>'
+ *   attributes    ::= space+ (any)*? quote space* &('>' | '/>')
+ *   specialentity ::= '&#x' xdigit+ ';' | '&#' digit+ ';' | '&' alpha+ ';'
+ *   markdownchar  ::= '<' | '>' | '&'
+ *   word          ::= [^<>& ]+
+ *   ws            ::= space+
+ *
+ * The input is read in place.  Control characters are treated as spaces and trailing whitespace
+ * is ignored.  Start and end tag names are applied as soon as they are read, even when the rest
+ * of the tag does not match and its characters are kept as text.
+ */
+class StyledTextParser {
+public:
+    StyledTextParser(const std::string& raw, StyledTextState& state)
+        : mData(raw.data()),
+          mEnd(raw.size()),
+          mState(state)
+    {
+        while (mEnd > 0 && (mData[mEnd - 1] == ' ' || controlChar(mData[mEnd - 1])))
+            mEnd--;
+    }
 
-template<> struct action< stagname >
-{
-    template< typename Input >
-    static void apply(const Input& in, StyledTextState& state) {
-        state.start(in.string());
+    void parse() {
+        auto p = spaces(0);
+        while (p < mEnd) {
+            auto c = at(p);
+            size_t next;
+
+            if ((c == ' ' || c == '<') && (next = br(p)) != NO_MATCH) {
+                mState.single(StyledText::kSpanTypeLineBreak);
+                p = next;
+            }
+            else if (c == '<') {
+                if ((next = utag(p)) == NO_MATCH &&
+                    (next = stag(p)) == NO_MATCH &&
+                    (next = etag(p)) == NO_MATCH)
+                    next = markdownChar(p);
+                p = next;
+            }
+            else if (c == '&') {
+                if ((next = entity(p)) == NO_MATCH)
+                    next = markdownChar(p);
+                p = next;
+            }
+            else if (c == '>') {
+                p = markdownChar(p);
+            }
+            else if (c == ' ') {
+                mState.space();
+                p = spaces(p);
+            }
+            else {
+                p = word(p);
+            }
+        }
     }
-};
 
-template<> struct action< etagname >
-{
-    template< typename Input >
-    static void apply(const Input& in, StyledTextState& state) {
-        state.end(in.string());
+private:
+    static const size_t NO_MATCH = std::string::npos;
+
+    /**
+     * @return The character at a position, with control characters read as spaces and zero past the end.
+     */
+    char at(size_t p) const {
+        if (p >= mEnd)
+            return 0;
+
+        auto c = mData[p];
+        return controlChar(c) ? ' ' : c;
     }
-};
 
-template<> struct action< br >
-{
-    template< typename Input >
-    static void apply(const Input& in, StyledTextState& state) {
-        state.single(StyledText::kSpanTypeLineBreak);
+    static bool isAlpha(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); }
+    static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+    static bool isAlnum(char c) { return isAlpha(c) || isDigit(c); }
+    static bool isXdigit(char c) { return isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'); }
+
+    size_t spaces(size_t p) const {
+        while (at(p) == ' ')
+            p++;
+        return p;
     }
-};
 
-template<> struct action< word >
-{
-    template< typename Input >
-    static void apply(const Input& in, StyledTextState& state) {
-        state.append(in.string());
+    size_t tagName(size_t p) const {
+        while (isAlnum(at(p)))
+            p++;
+        return p;
     }
-};
 
-template<> struct action< ws >
-{
-    template< typename Input >
-    static void apply(const Input& in, StyledTextState& state) {
-        state.space();
+    size_t attributes(size_t p) const {
+        if (at(p) != ' ')
+            return NO_MATCH;
+
+        // Skip to the first quote that is followed by the end of the tag
+        for (p = spaces(p) ; p < mEnd ; p++) {
+            auto c = at(p);
+            if (c == '"' || c == '\'') {
+                auto q = spaces(p + 1);
+                if (at(q) == '>' || (at(q) == '/' && at(q + 1) == '>'))
+                    return q;
+            }
+        }
+
+        return NO_MATCH;
     }
-};
 
-template<> struct action< markdownchar >
-{
-    template< typename Input >
-    static void apply(const Input& in, StyledTextState& state) {
+    size_t optionalAttributes(size_t p) const {
+        auto q = attributes(p);
+        return q != NO_MATCH ? q : p;
+    }
+
+    size_t br(size_t p) const {
+        p = spaces(p);
+        if (at(p) != '<')
+            return NO_MATCH;
+
+        p = spaces(p + 1);
+        if ((at(p) != 'b' && at(p) != 'B') || (at(p + 1) != 'r' && at(p + 1) != 'R'))
+            return NO_MATCH;
+
+        p = spaces(optionalAttributes(p + 2));
+        if (at(p) == '/')
+            p++;
+        if (at(p) != '>')
+            return NO_MATCH;
+
+        return spaces(p + 1);
+    }
+
+    size_t utag(size_t p) const {
+        p = spaces(p + 1);
+        auto q = tagName(p);
+        if (q == p)
+            return NO_MATCH;
+
+        p = spaces(optionalAttributes(q));
+        if (at(p) != '/' || at(p + 1) != '>')
+            return NO_MATCH;
+
+        return p + 2;
+    }
+
+    size_t stag(size_t p) {
+        p = spaces(p + 1);
+        auto q = tagName(p);
+        if (q == p)
+            return NO_MATCH;
+
+        mState.start(mData + p, q - p);
+
+        p = spaces(optionalAttributes(q));
+        if (at(p) != '>')
+            return NO_MATCH;
+
+        return p + 1;
+    }
+
+    size_t etag(size_t p) {
+        if (at(p + 1) != '/')
+            return NO_MATCH;
+
+        p = spaces(p + 2);
+        auto q = tagName(p);
+        if (q == p)
+            return NO_MATCH;
+
+        mState.end(mData + p, q - p);
+
+        p = spaces(q);
+        if (at(p) != '>')
+            return NO_MATCH;
+
+        return p + 1;
+    }
+
+    size_t entity(size_t p) {
+        if (at(p + 1) == '#') {
+            auto hex = at(p + 2) == 'x';
+            auto start = hex ? p + 3 : p + 2;
+            auto q = start;
+            unsigned long code = 0;
+            while (hex ? isXdigit(at(q)) : isDigit(at(q))) {
+                auto c = at(q++);
+                auto digit = isDigit(c) ? c - '0' : (c | 0x20) - 'a' + 10;
+                code = std::min(code * (hex ? 16 : 10) + digit, MAX_CODE_POINT + 1);
+            }
+
+            if (q > start && at(q) == ';') {
+                mState.appendCodePoint(code);
+                return q + 1;
+            }
+
+            return NO_MATCH;
+        }
+
+        auto q = p + 1;
+        while (isAlpha(at(q)))
+            q++;
+        if (q == p + 1 || at(q) != ';')
+            return NO_MATCH;
+
+        // Unknown entities are left unparsed - aligned with HTML.
+        auto length = q + 1 - p;
+        for (const auto& m : sTextSpecialEntities) {
+            if (m.length == length && std::equal(m.name, m.name + length, mData + p)) {
+                mState.append(&m.value, 1, 1);
+                return q + 1;
+            }
+        }
+
+        mState.append(mData + p, length, length);
+        return q + 1;
+    }
+
+    size_t markdownChar(size_t p) {
         // TODO: "Best effort" suggests that we allow that, though spec says: Markup characters in text must be replaced
         // with character entity references. Do we want to log it or restrict it in any way?
-        state.append(in.string());
+        mState.append(mData + p, 1, 1);
+        return p + 1;
     }
-};
 
-template<> struct action< stringentity >
-{
-    template< typename Input >
-    static void apply(const Input& in, StyledTextState& state) {
-        auto str =  in.string();
-        auto entity = sTextSpecialEntity.find(str);
-        if(entity != sTextSpecialEntity.end()) {
-            state.append(entity->second);
-        } else {
-            // Leave unparsed - aligned with HTML.
-            state.append(str);
+    size_t word(size_t p) {
+        auto start = p;
+        unsigned char high = 0;
+        size_t count = 0;
+        while (p < mEnd && !sWordBreaks[mData[p]]) {
+            auto c = static_cast<unsigned char>(mData[p++]);
+            high |= c;
+            count += (c & 0xC0) != 0x80;
         }
+
+        if (high < 0x80 || validUtf8(start, p))
+            mState.append(mData + start, p - start, count);
+        else
+            appendInvalidUtf8(start, p);
+
+        return p;
     }
-};
 
-template<> struct action< decentity >
-{
-    template< typename Input >
-    static void apply(const Input& in, StyledTextState& state) {
-        // strip leading &# and trailing ;
-        std::string numstr = in.string().substr(2, in.string().length() - 3);
-        unsigned long wc = std::stoul(numstr);
-        state.append(wchar_converter.to_bytes(wc));
+    /**
+     * @return The length of the UTF-8 sequence at a position, or zero if it is not valid.
+     */
+    size_t sequenceLength(size_t p, size_t end) const {
+        auto byte = [this](size_t i) { return static_cast<unsigned char>(mData[i]); };
+        auto continuation = [&](size_t i) { return i < end && (byte(i) & 0xC0) == 0x80; };
+
+        auto c = byte(p);
+        if (c < 0x80)
+            return 1;
+        if (c >= 0xC2 && c <= 0xDF)
+            return continuation(p + 1) ? 2 : 0;
+        if (c >= 0xE0 && c <= 0xEF) {
+            if (!continuation(p + 1) || !continuation(p + 2))
+                return 0;
+            auto c1 = byte(p + 1);
+            if ((c == 0xE0 && c1 < 0xA0) || (c == 0xED && c1 >= 0xA0))  // Overlong or surrogate
+                return 0;
+            return 3;
+        }
+        if (c >= 0xF0 && c <= 0xF4) {
+            if (!continuation(p + 1) || !continuation(p + 2) || !continuation(p + 3))
+                return 0;
+            auto c1 = byte(p + 1);
+            if ((c == 0xF0 && c1 < 0x90) || (c == 0xF4 && c1 >= 0x90))  // Overlong or out of range
+                return 0;
+            return 4;
+        }
+        return 0;
     }
-};
 
-template<> struct action< hexentity >
-{
-    template< typename Input >
-    static void apply(const Input& in, StyledTextState& state) {
-        // strip leading &#x and trailing ;
-        std::string numstr = in.string().substr(3, in.string().length() - 4);
-        unsigned long wc = std::stoul(numstr, 0, 16);
-        state.append(wchar_converter.to_bytes(wc));
+    bool validUtf8(size_t p, size_t end) const {
+        while (p < end) {
+            auto length = sequenceLength(p, end);
+            if (length == 0)
+                return false;
+            p += length;
+        }
+        return true;
+    }
+
+    /**
+     * Append a word, replacing each invalid byte with U+FFFD.
+     */
+    void appendInvalidUtf8(size_t p, size_t end) {
+        while (p < end) {
+            auto length = sequenceLength(p, end);
+            if (length == 0) {
+                mState.appendCodePoint(MAX_CODE_POINT + 1);
+                p++;
+            }
+            else {
+                mState.append(mData + p, length, 1);
+                p += length;
+            }
+        }
     }
+
+private:
+    const char *mData;
+    size_t mEnd;
+    StyledTextState& mState;
 };
 
 Object
@@ -407,15 +602,12 @@ StyledText::create(const Object& object) {
     return Object(StyledText(object.asString()));
 }
 
-StyledText::StyledText(const std::string& raw) {
-    mRawText = raw;
-    auto filtered = rtrim(stripControl(raw));
-
-    StyledTextState state;
-    pegtl::string_input<> in(filtered, "");
-    pegtl::parse<styledtext, action>(in, state);
-
-    mText = state.getText();
+StyledText::StyledText(const std::string& raw)
+    : mRawText(raw)
+{
+    mText.reserve(raw.size());
+    StyledTextState state(mText);
+    StyledTextParser(mRawText, state).parse();
     mSpans = state.finalize();
 }
 
@@ -76,7 +76,21 @@ Sequencer::executeOnSequencer(const CommandPtr& commandPtr, const std::string& s
 void
 Sequencer::executeFast(const CommandPtr& commandPtr)
 {
-    ActionPtr ptr = commandPtr->execute(mTimeManager, true);
+    holdOneShot(commandPtr->execute(mTimeManager, true));
+}
+
+void
+Sequencer::executeParallel(const CommandPtr& commandPtr)
+{
+    if (mTerminated || !commandPtr)
+        return;
+
+    holdOneShot(commandPtr->execute(mTimeManager, false));
+}
+
+void
+Sequencer::holdOneShot(const ActionPtr& ptr)
+{
     if (ptr && ptr->isPending()) {
         mOneShotSet.emplace(ptr);
         ptr->then([this](const ActionPtr& ptr) {
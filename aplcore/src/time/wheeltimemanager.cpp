@@ -0,0 +1,476 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "apl/time/wheeltimemanager.h"
+
+namespace apl {
+
+static const int64_t NEVER = std::numeric_limits<int64_t>::max();
+static const int OVERFLOW_SHIFT = 36;   // LEVELS * LEVEL_BITS
+
+/**
+ * @return The millisecond tick in which a time falls.
+ */
+static int64_t
+tickOf(apl_time_t time)
+{
+    if (!(time < 9.0e18))   // Also catches NaN
+        return NEVER;
+    return static_cast<int64_t>(std::floor(time));
+}
+
+static int
+countLeadingZeros(uint64_t value)
+{
+    int n = 0;
+    for (uint64_t mask = 1ULL << 63 ; mask && !(value & mask) ; mask >>= 1)
+        n++;
+    return n;
+}
+
+static int
+countTrailingZeros(uint64_t value)
+{
+    int n = 0;
+    while (!(value & 1)) {
+        value >>= 1;
+        n++;
+    }
+    return n;
+}
+
+WheelTimeManager::WheelTimeManager(apl_time_t time)
+    : mTime(time),
+      mNextId(100),
+      mElapsed(tickOf(time)),
+      mAnimatorCount(0)
+{
+}
+
+timeout_id
+WheelTimeManager::setTimeout(Runnable func, apl_duration_t delay)
+{
+    return add(std::move(func), nullptr, delay);
+}
+
+timeout_id
+WheelTimeManager::setAnimator(Animator animator, apl_duration_t duration)
+{
+    return add(nullptr, std::move(animator), duration);
+}
+
+timeout_id
+WheelTimeManager::add(Runnable runnable, Animator animator, apl_duration_t duration)
+{
+    auto index = allocate();
+    auto& entry = mEntries[index];
+    entry.runnable = std::move(runnable);
+    entry.animator = std::move(animator);
+    entry.startTime = mTime;
+    entry.endTime = mTime + duration;
+    entry.id = mNextId++;
+    entry.tick = tickOf(entry.endTime);
+    entry.cancelled = false;
+
+    if (entry.animator) {
+        entry.prevAnimator = mAnimators.tail;
+        entry.nextAnimator = NONE;
+        if (mAnimators.tail != NONE)
+            mEntries[mAnimators.tail].nextAnimator = index;
+        else
+            mAnimators.head = index;
+        mAnimators.tail = index;
+        mAnimatorCount++;
+    }
+
+    mIndex.emplace(entry.id, index);
+    schedule(index);
+    return entry.id;
+}
+
+bool
+WheelTimeManager::clearTimeout(timeout_id id)
+{
+    auto it = mIndex.find(id);
+    if (it == mIndex.end())
+        return false;
+
+    auto index = it->second;
+    mIndex.erase(it);
+
+    auto& entry = mEntries[index];
+    if (entry.animator) {
+        auto prev = entry.prevAnimator;
+        auto next = entry.nextAnimator;
+        (prev != NONE ? mEntries[prev].nextAnimator : mAnimators.head) = next;
+        (next != NONE ? mEntries[next].prevAnimator : mAnimators.tail) = prev;
+        mAnimatorCount--;
+    }
+
+    if (entry.level == kReady) {
+        // Removing from the middle of the heap is not O(1); the entry is skipped when it reaches the top
+        entry.cancelled = true;
+        entry.runnable = nullptr;
+        entry.animator = nullptr;
+    }
+    else {
+        unschedule(index);
+        release(index);
+    }
+
+    return true;
+}
+
+void
+WheelTimeManager::updateTime(apl_time_t updatedTime)
+{
+    // Block going backwards in time, but clear any pending timeouts.
+    if (updatedTime <= mTime) {
+        runPending();
+        return;
+    }
+
+    advance(updatedTime);
+    mTime = updatedTime;
+
+    if (mAnimatorCount == 0)
+        return;
+
+    // Animators may set or clear timeouts, so work from a copy of the list
+    std::vector<timeout_id> animators;
+    animators.reserve(mAnimatorCount);
+    for (auto index = mAnimators.head ; index != NONE ; index = mEntries[index].nextAnimator)
+        animators.emplace_back(mEntries[index].id);
+
+    for (auto id : animators) {
+        auto it = mIndex.find(id);
+        if (it == mIndex.end())
+            continue;
+
+        const auto& entry = mEntries[it->second];
+        auto animator = entry.animator;
+        animator(mTime - entry.startTime);
+    }
+}
+
+apl_time_t
+WheelTimeManager::nextTimeout()
+{
+    if (mAnimatorCount > 0)
+        return mTime + 1;
+
+    pruneReady();
+    if (!mReady.empty())
+        return mEntries[mReady.front()].endTime;
+
+    const List *list = nullptr;
+    int level, slot;
+    int64_t deadline;
+    if (nextSlot(level, slot, deadline))
+        list = &mLevels[level].slots[slot];
+    else if (mOverflow.head != NONE)
+        list = &mOverflow;
+
+    if (!list)
+        return std::numeric_limits<apl_time_t>::max();
+
+    auto result = std::numeric_limits<apl_time_t>::max();
+    for (auto index = list->head ; index != NONE ; index = mEntries[index].next)
+        result = std::min(result, mEntries[index].endTime);
+    return result;
+}
+
+void
+WheelTimeManager::runPending()
+{
+    advance(mTime);
+}
+
+void
+WheelTimeManager::terminate()
+{
+    mEntries.clear();
+    mFreeEntries.clear();
+    mIndex.clear();
+    for (auto& level : mLevels)
+        level = Level();
+    mOverflow = List();
+    mAnimators = List();
+    mAnimatorCount = 0;
+    mReady.clear();
+}
+
+/****************************************************************************/
+
+uint32_t
+WheelTimeManager::allocate()
+{
+    if (!mFreeEntries.empty()) {
+        auto index = mFreeEntries.back();
+        mFreeEntries.pop_back();
+        return index;
+    }
+
+    mEntries.emplace_back();
+    return static_cast<uint32_t>(mEntries.size() - 1);
+}
+
+void
+WheelTimeManager::release(uint32_t index)
+{
+    auto& entry = mEntries[index];
+    entry.runnable = nullptr;
+    entry.animator = nullptr;
+    entry.level = kFree;
+    mFreeEntries.emplace_back(index);
+}
+
+void
+WheelTimeManager::schedule(uint32_t index)
+{
+    auto& entry = mEntries[index];
+    if (entry.tick == NEVER) {
+        entry.level = kNever;
+        return;
+    }
+
+    if (entry.tick <= mElapsed) {
+        entry.level = kReady;
+        pushReady(index);
+        return;
+    }
+
+    // The level is set by the highest bit that differs between the tick and the wheel position
+    auto masked = static_cast<uint64_t>(entry.tick ^ mElapsed) | (SLOTS - 1);
+    auto level = (63 - countLeadingZeros(masked)) / LEVEL_BITS;
+    if (level >= LEVELS) {
+        entry.level = kOverflow;
+        link(mOverflow, index);
+        return;
+    }
+
+    entry.level = static_cast<int8_t>(level);
+    entry.slot = static_cast<uint8_t>((entry.tick >> (level * LEVEL_BITS)) & (SLOTS - 1));
+    link(mLevels[level].slots[entry.slot], index);
+    mLevels[level].occupied |= 1ULL << entry.slot;
+}
+
+void
+WheelTimeManager::link(List& list, uint32_t index)
+{
+    auto& entry = mEntries[index];
+    entry.prev = list.tail;
+    entry.next = NONE;
+    if (list.tail != NONE)
+        mEntries[list.tail].next = index;
+    else
+        list.head = index;
+    list.tail = index;
+}
+
+void
+WheelTimeManager::unlink(List& list, uint32_t index)
+{
+    auto& entry = mEntries[index];
+    (entry.prev != NONE ? mEntries[entry.prev].next : list.head) = entry.next;
+    (entry.next != NONE ? mEntries[entry.next].prev : list.tail) = entry.prev;
+}
+
+void
+WheelTimeManager::unschedule(uint32_t index)
+{
+    auto& entry = mEntries[index];
+    if (entry.level == kOverflow) {
+        unlink(mOverflow, index);
+    }
+    else if (entry.level >= 0 && entry.level < LEVELS) {
+        auto& level = mLevels[entry.level];
+        auto& list = level.slots[entry.slot];
+        unlink(list, index);
+        if (list.head == NONE)
+            level.occupied &= ~(1ULL << entry.slot);
+    }
+}
+
+/**
+ * Find the first occupied slot after the current wheel position.  Slots on lower levels always
+ * expire before slots on higher levels.
+ */
+bool
+WheelTimeManager::nextSlot(int& level, int& slot, int64_t& deadline) const
+{
+    for (int i = 0 ; i < LEVELS ; i++) {
+        auto occupied = mLevels[i].occupied;
+        if (!occupied)
+            continue;
+
+        auto shift = i * LEVEL_BITS;
+        auto current = static_cast<int>((mElapsed >> shift) & (SLOTS - 1));
+        auto rotated = current ? (occupied >> current) | (occupied << (SLOTS - current)) : occupied;
+        auto next = (countTrailingZeros(rotated) + current) % SLOTS;
+
+        auto levelRange = 1LL << (shift + LEVEL_BITS);
+        level = i;
+        slot = next;
+        deadline = (mElapsed & ~(levelRange - 1)) + (static_cast<int64_t>(next) << shift);
+        if (deadline <= mElapsed)
+            deadline += levelRange;
+        return true;
+    }
+
+    return false;
+}
+
+void
+WheelTimeManager::advance(apl_time_t target)
+{
+    auto targetTick = tickOf(target);
+
+    for (;;) {
+        pruneReady();
+        if (!mReady.empty() && mEntries[mReady.front()].endTime <= target) {
+            fire(popReady());
+            continue;
+        }
+
+        int level, slot;
+        int64_t deadline;
+        if (nextSlot(level, slot, deadline)) {
+            if (deadline > targetTick)
+                break;
+
+            expireSlot(level, slot, deadline);
+            continue;
+        }
+
+        // The wheel is empty.  Jump to the block of the earliest overflow entry if it is due.
+        if (mOverflow.head == NONE)
+            break;
+
+        auto earliest = NEVER;
+        for (auto index = mOverflow.head ; index != NONE ; index = mEntries[index].next)
+            earliest = std::min(earliest, mEntries[index].tick);
+        if (earliest > targetTick)
+            break;
+
+        expireSlot(kOverflow, 0, earliest & ~((1LL << OVERFLOW_SHIFT) - 1));
+    }
+
+    if (targetTick > mElapsed && targetTick != NEVER)
+        expireSlot(-1, 0, targetTick);
+}
+
+/**
+ * Move the wheel position forward to the deadline and re-schedule the entries of a slot.  A
+ * level of kOverflow re-schedules the overflow list; a negative level only moves the position.
+ */
+void
+WheelTimeManager::expireSlot(int level, int slot, int64_t deadline)
+{
+    bool newBlock = (deadline >> OVERFLOW_SHIFT) != (mElapsed >> OVERFLOW_SHIFT);
+    mElapsed = deadline;
+
+    List list;
+    if (level >= 0 && level < LEVELS) {
+        std::swap(list, mLevels[level].slots[slot]);
+        mLevels[level].occupied &= ~(1ULL << slot);
+    }
+
+    // Overflow entries may now fit in the wheel
+    if (level == kOverflow || newBlock) {
+        if (list.head == NONE) {
+            std::swap(list, mOverflow);
+        }
+        else if (mOverflow.head != NONE) {
+            mEntries[list.tail].next = mOverflow.head;
+            mEntries[mOverflow.head].prev = list.tail;
+            list.tail = mOverflow.tail;
+            mOverflow = List();
+        }
+    }
+
+    for (auto index = list.head ; index != NONE ; ) {
+        auto next = mEntries[index].next;
+        schedule(index);
+        index = next;
+    }
+}
+
+void
+WheelTimeManager::fire(uint32_t index)
+{
+    auto& entry = mEntries[index];
+    auto runnable = std::move(entry.runnable);
+    auto animator = std::move(entry.animator);
+    auto duration = entry.endTime - entry.startTime;
+    mTime = entry.endTime;
+    mIndex.erase(entry.id);
+
+    if (animator) {
+        auto prev = entry.prevAnimator;
+        auto next = entry.nextAnimator;
+        (prev != NONE ? mEntries[prev].nextAnimator : mAnimators.head) = next;
+        (next != NONE ? mEntries[next].prevAnimator : mAnimators.tail) = prev;
+        mAnimatorCount--;
+    }
+
+    release(index);
+
+    if (runnable)
+        runnable();
+    else if (animator)
+        animator(duration);
+}
+
+/****************************************************************************/
+
+bool
+WheelTimeManager::readyBefore(uint32_t a, uint32_t b) const
+{
+    const auto& x = mEntries[a];
+    const auto& y = mEntries[b];
+    return x.endTime < y.endTime || (x.endTime == y.endTime && x.id < y.id);
+}
+
+void
+WheelTimeManager::pushReady(uint32_t index)
+{
+    mReady.emplace_back(index);
+    std::push_heap(mReady.begin(), mReady.end(),
+                   [this](uint32_t a, uint32_t b) { return readyBefore(b, a); });
+}
+
+uint32_t
+WheelTimeManager::popReady()
+{
+    std::pop_heap(mReady.begin(), mReady.end(),
+                  [this](uint32_t a, uint32_t b) { return readyBefore(b, a); });
+    auto index = mReady.back();
+    mReady.pop_back();
+    return index;
+}
+
+void
+WheelTimeManager::pruneReady()
+{
+    while (!mReady.empty() && mEntries[mReady.front()].cancelled)
+        release(popReady());
+}
+
+} // namespace apl
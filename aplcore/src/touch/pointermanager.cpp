@@ -105,7 +105,7 @@ PointerManager::handlePointerStart(const std::shared_ptr<Pointer>& pointer, cons
         return nullptr;
 
     auto visitor = TouchableAtPosition(pointerEvent.pointerEventPosition);
-    top->raccept(visitor);
+    top->rsearch(visitor);
     auto target = std::dynamic_pointer_cast<TouchableComponent>(visitor.getResult());
 
     pointer->setTarget(target);
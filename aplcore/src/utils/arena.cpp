@@ -0,0 +1,87 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <new>
+
+#include "apl/utils/arena.h"
+
+namespace apl {
+
+const size_t Arena::ALIGNMENT;
+const size_t Arena::MAX_BLOCK_SIZE;
+const size_t Arena::CHUNK_SIZE;
+
+Arena::Arena()
+    : mFreeLists(sizeClass(MAX_BLOCK_SIZE) + 1, nullptr)
+{
+}
+
+Arena::~Arena()
+{
+    for (auto chunk : mChunks)
+        ::operator delete(chunk);
+}
+
+void *
+Arena::allocate(size_t size)
+{
+    if (size > MAX_BLOCK_SIZE)
+        return ::operator new(size);
+
+    mLiveBlocks++;
+
+    auto index = sizeClass(size);
+    auto block = mFreeLists[index];
+    if (block) {
+        mFreeLists[index] = block->next;
+        return block;
+    }
+
+    return carve(index * ALIGNMENT);
+}
+
+void
+Arena::deallocate(void *ptr, size_t size)
+{
+    if (size > MAX_BLOCK_SIZE) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    mLiveBlocks--;
+
+    auto index = sizeClass(size);
+    auto block = static_cast<FreeBlock*>(ptr);
+    block->next = mFreeLists[index];
+    mFreeLists[index] = block;
+}
+
+void *
+Arena::carve(size_t blockSize)
+{
+    if (static_cast<size_t>(mEnd - mCursor) < blockSize) {
+        // The tail of the previous chunk is abandoned; it is smaller than the largest block
+        auto chunk = static_cast<char*>(::operator new(CHUNK_SIZE));
+        mChunks.emplace_back(chunk);
+        mCursor = chunk;
+        mEnd = chunk + CHUNK_SIZE;
+    }
+
+    auto result = mCursor;
+    mCursor += blockSize;
+    return result;
+}
+
+} // namespace apl
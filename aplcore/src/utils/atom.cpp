@@ -0,0 +1,176 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "apl/utils/atom.h"
+
+namespace apl {
+
+/**
+ * The intern table.  Entries are held in a deque and are never moved, so an Atom may hold a
+ * pointer to its entry for as long as the table exists.
+ *
+ * Lookups read an open-addressed array of entry pointers without taking a lock.  Interning a
+ * new string takes a mutex, appends the entry and then publishes its pointer into an empty
+ * slot.  When the array grows the larger copy is published in one step; the older arrays are
+ * kept until exit because a reader may still be walking them.  Each array is half the size of
+ * the next, so together they use no more memory than the current one.
+ *
+ * The table has static storage duration and releases every entry at exit.  Any static object
+ * that holds an Atom interns its string while it is constructed, after the table itself, so
+ * it is destroyed before the table.  Atoms have trivial destructors and never touch the table
+ * when they are released.
+ */
+class AtomTable {
+public:
+    static AtomTable& instance() {
+        static AtomTable sTable;
+        return sTable;
+    }
+
+    AtomTable() {
+        mSlots.emplace_back(new Slots(64));
+        mCurrent.store(mSlots.back().get(), std::memory_order_release);
+    }
+
+    const Atom::Entry *find(const std::string& value, size_t hash) const {
+        const auto *slots = mCurrent.load(std::memory_order_acquire);
+        const auto mask = slots->size - 1;
+        for (auto slot = hash & mask ; ; slot = (slot + 1) & mask) {
+            auto entry = slots->entries[slot].load(std::memory_order_acquire);
+            if (!entry || (entry->second == hash && entry->first == value))
+                return entry;
+        }
+    }
+
+    const Atom::Entry *intern(const std::string& value) {
+        auto hash = std::hash<std::string>()(value);
+        auto entry = find(value, hash);
+        if (entry)
+            return entry;
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        entry = find(value, hash);   // Another thread may have interned it first
+        if (entry)
+            return entry;
+
+        mEntries.emplace_back(value, hash);
+        entry = &mEntries.back();
+        mBytes += value.capacity() + sizeof(Atom::Entry);
+
+        auto *slots = mSlots.back().get();
+        if (mEntries.size() * 2 > slots->size) {
+            // Keep the load factor at or below one half
+            mSlots.emplace_back(new Slots(slots->size * 2));
+            slots = mSlots.back().get();
+            for (const auto& m : mEntries)
+                insert(*slots, &m);
+            mCurrent.store(slots, std::memory_order_release);
+        }
+        else {
+            insert(*slots, entry);
+        }
+
+        return entry;
+    }
+
+    size_t size() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mEntries.size();
+    }
+
+    size_t bytes() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        size_t result = mBytes;
+        for (const auto& m : mSlots)
+            result += m->size * sizeof(std::atomic<const Atom::Entry*>);
+        return result;
+    }
+
+private:
+    struct Slots {
+        explicit Slots(size_t count) : size(count), entries(new std::atomic<const Atom::Entry*>[count]) {
+            for (size_t i = 0 ; i < count ; i++)
+                entries[i].store(nullptr, std::memory_order_relaxed);
+        }
+
+        const size_t size;   // A power of two
+        std::unique_ptr<std::atomic<const Atom::Entry*>[]> entries;
+    };
+
+    static void insert(Slots& slots, const Atom::Entry *entry) {
+        const auto mask = slots.size - 1;
+        auto slot = entry->second & mask;
+        while (slots.entries[slot].load(std::memory_order_relaxed))
+            slot = (slot + 1) & mask;
+        slots.entries[slot].store(entry, std::memory_order_release);
+    }
+
+    std::mutex mMutex;
+    std::deque<Atom::Entry> mEntries;
+    std::vector<std::unique_ptr<Slots>> mSlots;   // Every array published so far, current last
+    std::atomic<const Slots*> mCurrent;
+    size_t mBytes = 0;
+};
+
+static const Atom::Entry *
+emptyEntry()
+{
+    static const Atom::Entry *sEmpty = AtomTable::instance().intern("");
+    return sEmpty;
+}
+
+Atom::Atom()
+    : mEntry(emptyEntry())
+{
+}
+
+const Atom::Entry *
+Atom::intern(const std::string& value)
+{
+    if (value.empty())
+        return emptyEntry();
+
+    return AtomTable::instance().intern(value);
+}
+
+Atom
+Atom::find(const std::string& value)
+{
+    if (value.empty())
+        return Atom();
+
+    auto entry = AtomTable::instance().find(value, std::hash<std::string>()(value));
+    return entry ? Atom(entry) : Atom();
+}
+
+size_t
+Atom::tableSize()
+{
+    return AtomTable::instance().size();
+}
+
+size_t
+Atom::tableBytes()
+{
+    return AtomTable::instance().bytes();
+}
+
+} // namespace apl
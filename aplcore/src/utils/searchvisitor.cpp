@@ -28,6 +28,8 @@ static const bool DEBUG_SEARCH = false;
 
 void
 SearchVisitor::visit(const CoreComponent& component) {
+    mParentTransform = mCurrentTransform;
+
     Transform2D transform;
     if (!component.getCoordinateTransformFromParent(component.getParent(), transform)) {
         mPruneBranch = true;
@@ -65,10 +67,15 @@ SearchVisitor::visit(const CoreComponent& component) {
 }
 
 void
-SearchVisitor::push() {}
+SearchVisitor::push() {
+    mTransformStack.emplace_back(mParentTransform);
+}
 
 void
 SearchVisitor::pop() {
+    mCurrentTransform = mTransformStack.back();
+    mTransformStack.pop_back();
+
     if (!isAborted()) {
         mResultFound = (mPotentialResult != nullptr);
     }
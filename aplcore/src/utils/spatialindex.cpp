@@ -0,0 +1,114 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "apl/utils/spatialindex.h"
+
+namespace apl {
+
+static const int MAX_CELLS_PER_SIDE = 256;
+
+void
+SpatialIndex::build(std::vector<Rect>&& rects)
+{
+    mRects = std::move(rects);
+    mCells.clear();
+    mColumns = mRows = 0;
+
+    float left = 0, top = 0, right = 0, bottom = 0;
+    size_t count = 0;
+    for (const auto& rect : mRects) {
+        if (rect.isEmpty())
+            continue;
+
+        if (count++ == 0) {
+            left = rect.getLeft();
+            top = rect.getTop();
+            right = rect.getRight();
+            bottom = rect.getBottom();
+        }
+        else {
+            left = std::min(left, rect.getLeft());
+            top = std::min(top, rect.getTop());
+            right = std::max(right, rect.getRight());
+            bottom = std::max(bottom, rect.getBottom());
+        }
+    }
+
+    if (count == 0)
+        return;
+
+    // Aim for roughly one rectangle per cell, keeping the cells close to the aspect ratio of the area
+    auto width = std::max(right - left, 1.0f);
+    auto height = std::max(bottom - top, 1.0f);
+    mColumns = std::max(1, std::min(MAX_CELLS_PER_SIDE,
+                                    static_cast<int>(std::round(std::sqrt(count * width / height)))));
+    mRows = std::max(1, std::min(MAX_CELLS_PER_SIDE,
+                                 static_cast<int>(std::ceil(static_cast<float>(count) / mColumns))));
+    mLeft = left;
+    mTop = top;
+    mWidth = right - left;
+    mHeight = bottom - top;
+    mCellWidth = width / mColumns;
+    mCellHeight = height / mRows;
+    mCells.resize(mColumns * mRows);
+
+    auto column = [&](float x) { return std::max(0, std::min(mColumns - 1, static_cast<int>((x - mLeft) / mCellWidth))); };
+    auto row = [&](float y) { return std::max(0, std::min(mRows - 1, static_cast<int>((y - mTop) / mCellHeight))); };
+
+    // Walk backwards so that each cell lists its rectangles in descending order
+    for (auto index = static_cast<int>(mRects.size()) - 1 ; index >= 0 ; index--) {
+        const auto& rect = mRects.at(index);
+        if (rect.isEmpty())
+            continue;
+
+        auto c1 = column(rect.getRight());
+        auto r1 = row(rect.getBottom());
+        for (auto r = row(rect.getTop()) ; r <= r1 ; r++)
+            for (auto c = column(rect.getLeft()) ; c <= c1 ; c++)
+                mCells.at(r * mColumns + c).emplace_back(index);
+    }
+}
+
+void
+SpatialIndex::clear()
+{
+    mRects.clear();
+    mCells.clear();
+    mColumns = mRows = 0;
+}
+
+const std::vector<uint32_t>&
+SpatialIndex::candidates(const Point& point) const
+{
+    static const std::vector<uint32_t> EMPTY;
+
+    if (mCells.empty())
+        return EMPTY;
+
+    auto x = point.getX() - mLeft;
+    auto y = point.getY() - mTop;
+    if (x < 0 || y < 0 || x > mWidth || y > mHeight)
+        return EMPTY;
+
+    // Points on the far edge belong to the last cell
+    auto c = std::min(mColumns - 1, static_cast<int>(x / mCellWidth));
+    auto r = std::min(mRows - 1, static_cast<int>(y / mCellHeight));
+    return mCells.at(r * mColumns + c);
+}
+
+} // namespace apl
@@ -25,6 +25,7 @@ whitelisted_apl_headers=(
     "apl/common.h"
     "apl/component/component.h"
     "apl/component/componentproperties.h"
+    "apl/component/textmeasurecache.h"
     "apl/component/textmeasurement.h"
     "apl/content/aplversion.h"
     "apl/content/content.h"
@@ -36,6 +37,7 @@ whitelisted_apl_headers=(
     "apl/content/jsondata.h"
     "apl/content/metrics.h"
     "apl/content/package.h"
+    "apl/content/packagecache.h"
     "apl/content/rootconfig.h"
     "apl/content/settings.h"
     "apl/datasource/datasourceconnection.h"
@@ -44,6 +46,7 @@ whitelisted_apl_headers=(
     "apl/datasource/offsetindexdatasourceconnection.h"
     "apl/dynamicdata.h"
     "apl/engine/binding.h"
+    "apl/engine/deltastream.h"
     "apl/engine/dependant.h"
     "apl/engine/event.h"
     "apl/engine/info.h"
@@ -83,6 +86,7 @@ whitelisted_apl_headers=(
     "apl/scaling/metricstransform.h"
     "apl/time/timers.h"
     "apl/touch/pointerevent.h"
+    "apl/utils/atom.h"
     "apl/utils/bimap.h"
     "apl/utils/counter.h"
     "apl/utils/log.h"
@@ -0,0 +1,89 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+/*
+ * Compare evaluating data-binding expressions by walking the Node tree against the byte code.
+ * The expressions are the corpus used by unittest_bytecode, drawn from the arithmetic and
+ * grammar unit tests.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "apl/datagrammar/bytecode.h"
+#include "apl/engine/context.h"
+#include "apl/engine/evaluate.h"
+#include "apl/content/metrics.h"
+#include "apl/content/rootconfig.h"
+
+using namespace apl;
+
+static const std::vector<std::string> CORPUS = {
+    "${!a}", "${!!x}", "${-n}", "${+x}", "${!w}",
+    "${x < y}", "${y >= x}", "${p == p}", "${a != x}", "${!(y == x)}",
+    "${x + w == x}", "${o + p == p}", "${n * 3 + 2}", "${(n - 1) / 2}", "${n % 4}", "${x * 2 - y}",
+    "${p / 2}", "${x / y}",
+    "${b && n}", "${b || n}", "${z ?? 'none'}", "${z ?? n ?? 'none'}", "${e || 'empty'}",
+    "${b ? x : y}", "${n > 5 ? 'big' : 'small'}", "${z ? 1 : b ? 2 : 3}",
+    "${s} is ${n}", "Value: ${n * 2}${e}", "${e}${s}",
+    "${list[1]}", "${list[-1]}", "${list.length}", "${map.name}", "${map['age'] + 1}",
+    "${Math.min(n, 3)}", "${Math.max(n, x, 100)}", "${String.toUpperCase(s)}",
+    "${Math.floor(n / 2) + list[0]}", "${n > 3 && (s == 'fuzzy' || b)}",
+};
+
+int
+main(int argc, char *argv[])
+{
+    int iterations = argc > 1 ? std::stoi(argv[1]) : 20000;
+
+    auto context = Context::create(Metrics().size(2048,2048).dpi(320), RootConfig());
+    context->putUserWriteable("a", Dimension());
+    context->putUserWriteable("w", Dimension(0));
+    context->putUserWriteable("x", Dimension(10));
+    context->putUserWriteable("y", Dimension(20));
+    context->putUserWriteable("o", Dimension(DimensionType::Relative, 0));
+    context->putUserWriteable("p", Dimension(DimensionType::Relative, 10));
+    context->putUserWriteable("n", 7);
+    context->putUserWriteable("s", "fuzzy");
+    context->putUserWriteable("e", "");
+    context->putUserWriteable("b", true);
+    context->putUserWriteable("z", Object::NULL_OBJECT());
+    context->putUserWriteable("list", ObjectArray{1, 2, 3});
+    context->putUserWriteable("map", std::make_shared<ObjectMap>(ObjectMap{{"name", "Pat"}, {"age", 32}}));
+
+    std::vector<Object> nodes;
+    std::vector<datagrammar::ByteCodePtr> compiled;
+    for (const auto& m : CORPUS) {
+        nodes.emplace_back(parseDataBinding(*context, m));
+        compiled.emplace_back(datagrammar::ByteCode::compile(nodes.back()));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0 ; i < iterations ; i++)
+        for (const auto& m : nodes)
+            m.eval();
+    auto treeTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0 ; i < iterations ; i++)
+        for (const auto& m : compiled)
+            m->eval();
+    auto byteCodeTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << CORPUS.size() << " expressions x " << iterations << " iterations: tree walker "
+              << treeTime << " ms, byte code " << byteCodeTime << " ms, speedup "
+              << (byteCodeTime > 0 ? treeTime / byteCodeTime : 0) << "x" << std::endl;
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+/*
+ * Time laying out a long Sequence.  The first measurement inflates a sequence with a child cache
+ * long enough to lay out every child in the first pass.  The second inflates the same sequence with
+ * the smallest child cache and then scrolls straight to the last child.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "apl/apl.h"
+
+using namespace apl;
+
+static const char *LARGE_SEQUENCE = R"({
+  "type": "APL",
+  "version": "1.4",
+  "mainTemplate": {
+    "parameters": [ "payload" ],
+    "items": {
+      "type": "Sequence",
+      "id": "foo",
+      "scrollDirection": "${payload.direction}",
+      "width": 200,
+      "height": 200,
+      "data": "${payload.items}",
+      "items": {
+        "type": "Frame",
+        "width": 100,
+        "height": 100,
+        "items": {
+          "type": "Text",
+          "text": "${data}"
+        }
+      }
+    }
+  }
+})";
+
+static std::string
+sequenceData(const std::string& direction, int count)
+{
+    std::string data = R"({"direction": ")" + direction + R"(", "items": [)";
+    for (int i = 0 ; i < count ; i++)
+        data += (i ? "," : "") + std::to_string(i);
+    return data + "]}";
+}
+
+static RootContextPtr
+inflate(const std::string& data, int cache)
+{
+    auto content = Content::create(LARGE_SEQUENCE);
+    content->addData("payload", data);
+    if (!content->isReady())
+        return nullptr;
+
+    auto config = RootConfig().sequenceChildCache(cache);
+    return RootContext::create(Metrics().size(1024,800).dpi(160), content, config);
+}
+
+static double
+elapsed(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void
+benchmark(const std::string& direction, int count)
+{
+    auto data = sequenceData(direction, count);
+
+    auto start = std::chrono::steady_clock::now();
+    auto root = inflate(data, count / 2);
+    auto cached = elapsed(start);
+    if (!root) {
+        std::cerr << "Unable to inflate the document" << std::endl;
+        return;
+    }
+
+    start = std::chrono::steady_clock::now();
+    root = inflate(data, 1);
+    auto component = root->topComponent();
+    auto cmd = JsonData(R"([{"type": "ScrollToIndex", "componentId": "foo", "index": )" +
+                        std::to_string(count - 1) + R"(, "align": "last"}])");
+    root->executeCommands(cmd.get(), false);
+    while (root->hasEvent()) {
+        auto event = root->popEvent();
+        if (event.getType() == kEventTypeScrollTo) {
+            auto position = event.getValue(kEventPropertyPosition).asNumber();
+            event.getComponent()->update(kUpdateScrollPosition, position);
+        }
+        event.getActionRef().resolve();
+    }
+    root->clearPending();
+    auto jump = elapsed(start);
+
+    std::cout << direction << " sequence of " << count << " children: cached layout " << cached
+              << " ms, jump to end " << jump << " ms, scroll position "
+              << component->scrollPosition().toString() << std::endl;
+}
+
+int
+main(int argc, char *argv[])
+{
+    int count = argc > 1 ? std::stoi(argv[1]) : 1000;
+    benchmark("vertical", count);
+    benchmark("horizontal", count);
+}
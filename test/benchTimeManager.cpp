@@ -0,0 +1,68 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+/*
+ * Compare the heap-based CoreTimeManager against the WheelTimeManager
+ */
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "apl/time/coretimemanager.h"
+#include "apl/time/wheeltimemanager.h"
+
+using namespace apl;
+
+template<class T>
+static void
+benchmark(const char *name, int count)
+{
+    std::mt19937 random(42);
+    std::vector<apl_duration_t> delays;
+    for (int i = 0 ; i < count ; i++)
+        delays.emplace_back(random() % 60000);
+
+    T tm(0);
+    int fired = 0;
+    std::vector<timeout_id> ids;
+    ids.reserve(count);
+
+    // Set all of the timers and cancel every other one
+    auto start = std::chrono::steady_clock::now();
+    for (auto delay : delays)
+        ids.emplace_back(tm.setTimeout([&fired]() { fired++; }, delay));
+    for (size_t i = 0 ; i < ids.size() ; i += 2)
+        tm.clearTimeout(ids[i]);
+    auto middle = std::chrono::steady_clock::now();
+
+    // Run through a minute in 100 ms steps
+    for (apl_time_t t = 100 ; t <= 60000 ; t += 100)
+        tm.updateTime(t);
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << name << ": " << count << " timers, set and cancel half "
+              << std::chrono::duration<double, std::milli>(middle - start).count() << " ms, run 600 updates "
+              << std::chrono::duration<double, std::milli>(end - middle).count() << " ms, fired "
+              << fired << std::endl;
+}
+
+int
+main(int argc, char *argv[])
+{
+    int count = argc > 1 ? std::stoi(argv[1]) : 10000;
+    benchmark<CoreTimeManager>("heap ", count);
+    benchmark<WheelTimeManager>("wheel", count);
+}
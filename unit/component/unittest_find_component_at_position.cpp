@@ -476,3 +476,96 @@ TEST_F(FindComponentAtPosition, AbsolutePositionedPager)
     foundComponent = visitor.getResult();
     ASSERT_EQ(tw->getUniqueId(), foundComponent->getUniqueId());
 }
+
+static const char *LARGE_GRID = R"({
+  "type": "APL",
+  "version": "1.4",
+  "mainTemplate": {
+    "parameters": [ "payload" ],
+    "items": {
+      "type": "GridSequence",
+      "width": 400,
+      "height": 400,
+      "childWidth": 40,
+      "childHeight": 40,
+      "data": "${payload}",
+      "items": {
+        "type": "Frame",
+        "id": "item${index}",
+        "width": "100%",
+        "height": "100%",
+        "transform": [ { "rotate": "${index % 7 == 0 ? 30 : 0}" } ],
+        "items": {
+          "type": "TouchWrapper",
+          "width": 20,
+          "height": 20
+        }
+      }
+    }
+  }
+})";
+
+static std::string
+gridData(int count)
+{
+    std::string data = "[";
+    for (int i = 0 ; i < count ; i++)
+        data += (i ? "," : "") + std::to_string(i);
+    return data + "]";
+}
+
+/**
+ * Search without the hit index by walking every visible child.
+ */
+static ComponentPtr
+findByWalking(const CoreComponentPtr& component, const Point& point)
+{
+    auto visitor = TopAtPosition(point);
+    component->raccept(visitor);
+    return visitor.getResult();
+}
+
+static ::testing::AssertionResult
+matchesWalk(const CoreComponentPtr& component)
+{
+    for (float x = -5 ; x < 410 ; x += 7.5) {
+        for (float y = -5 ; y < 410 ; y += 7.5) {
+            auto expected = findByWalking(component, Point(x, y));
+            auto actual = component->findComponentAtPosition(Point(x, y));
+            if (expected != actual)
+                return ::testing::AssertionFailure() << "Mismatch at " << x << "," << y
+                                                     << " expected=" << (expected ? expected->toDebugSimpleString() : "null")
+                                                     << " actual=" << (actual ? actual->toDebugSimpleString() : "null");
+        }
+    }
+    return ::testing::AssertionSuccess();
+}
+
+TEST_F(FindComponentAtPosition, LargeGrid)
+{
+    loadDocument(LARGE_GRID, gridData(300).c_str());
+    ASSERT_TRUE(component);
+    ASSERT_TRUE(matchesWalk(component));
+
+    auto item = component->findComponentById("item12");
+    ASSERT_EQ(item->getChildAt(0), component->findComponentAtPosition(Point(90, 50)));
+
+    // Moving a child updates the index.  Item 52 is moved on top of item 27.
+    rapidjson::Document doc;
+    doc.Parse(R"([{ "type": "SetValue", "componentId": "item52", "property": "transform",
+                    "value": [ { "translateX": 200 }, { "translateY": -120 } ] }])");
+    root->executeCommands(doc, false);
+    root->clearPending();
+    ASSERT_TRUE(matchesWalk(component));
+    ASSERT_EQ(component->findComponentById("item52"), component->findComponentAtPosition(Point(310, 110)));
+
+    // Scrolling shifts the search point into the content of the grid
+    component->update(kUpdateScrollPosition, 400);
+    root->clearPending();
+    ASSERT_TRUE(matchesWalk(component));
+
+    // Removing a child re-numbers the index
+    component->getChildAt(255)->remove();
+    root->clearPending();
+    ASSERT_TRUE(matchesWalk(component));
+}
@@ -1768,3 +1768,257 @@ TEST_F(ScrollTest, Pager)
     ASSERT_EQ(Dimension(1), event.getValue(kEventPropertyPosition).asDimension(*context));
     ASSERT_EQ(kEventDirectionForward, event.getValue(kEventPropertyDirection).getInteger());
 }
+
+static const char *LAZY_SEQUENCE =
+    "{"
+    "  \"type\": \"APL\","
+    "  \"version\": \"1.1\","
+    "  \"mainTemplate\": {"
+    "    \"items\": {"
+    "      \"type\": \"Sequence\","
+    "      \"id\": \"foo\","
+    "      \"width\": 100,"
+    "      \"height\": 100,"
+    "      \"numbered\": true,"
+    "      \"items\": {"
+    "        \"type\": \"Text\","
+    "        \"height\": 100,"
+    "        \"text\": \"${index}-${ordinal}-${length}\""
+    "      },"
+    "      \"data\": [0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19],"
+    "      \"lastItem\": {"
+    "        \"type\": \"Text\","
+    "        \"height\": 100,"
+    "        \"text\": \"end\""
+    "      }"
+    "    }"
+    "  }"
+    "}";
+
+TEST_F(ScrollTest, LazySequenceInflationDisabledByDefault)
+{
+    loadDocument(LAZY_SEQUENCE);
+
+    ASSERT_EQ(21, component->getChildCount());
+    ASSERT_EQ(0, std::static_pointer_cast<CoreComponent>(component)->getDeferredChildCount());
+}
+
+TEST_F(ScrollTest, LazySequenceInflation)
+{
+    config.lazySequenceInflation(true);
+    loadDocument(LAZY_SEQUENCE);
+    auto sequence = std::static_pointer_cast<CoreComponent>(component);
+
+    // One page plus one page of cache is inflated, followed by the last item
+    ASSERT_EQ(4, sequence->getChildCount());
+    ASSERT_EQ(17, sequence->getDeferredChildCount());
+    ASSERT_EQ("0-1-20", sequence->getChildAt(0)->getCalculated(kPropertyText).asString());
+    ASSERT_EQ("2-3-20", sequence->getChildAt(2)->getCalculated(kPropertyText).asString());
+    ASSERT_EQ("end", sequence->getChildAt(3)->getCalculated(kPropertyText).asString());
+
+    // Scrolling inflates the next child and reports it as inserted before the last item
+    sequence->update(kUpdateScrollPosition, 100);
+    ASSERT_EQ(5, sequence->getChildCount());
+    ASSERT_EQ("3-4-20", sequence->getChildAt(3)->getCalculated(kPropertyText).asString());
+    ASSERT_EQ("end", sequence->getChildAt(4)->getCalculated(kPropertyText).asString());
+    ASSERT_EQ(1, sequence->getDirty().count(kPropertyNotifyChildrenChanged));
+    auto changes = sequence->getCalculated(kPropertyNotifyChildrenChanged).getArray();
+    ASSERT_EQ(1, changes.size());
+    ASSERT_EQ(3, changes.at(0).get("index").asInt());
+    ASSERT_EQ("insert", changes.at(0).get("action").asString());
+    root->clearDirty();
+
+    // ScrollToIndex inflates up to the target child
+    scrollToIndex(component, 15, kCommandScrollAlignFirst);
+    ASSERT_LE(17, sequence->getChildCount());
+    ASSERT_EQ("15-16-20", sequence->getChildAt(15)->getCalculated(kPropertyText).asString());
+    ASSERT_EQ(Point(0, 1500), sequence->scrollPosition());
+
+    // A negative index counts from the end of the complete list
+    scrollToIndex(component, -1, kCommandScrollAlignLast);
+    ASSERT_EQ(21, sequence->getChildCount());
+    ASSERT_EQ(0, sequence->getDeferredChildCount());
+    ASSERT_EQ("19-20-20", sequence->getChildAt(19)->getCalculated(kPropertyText).asString());
+    ASSERT_EQ("end", sequence->getChildAt(20)->getCalculated(kPropertyText).asString());
+}
+
+TEST_F(ScrollTest, LazySequenceRemove)
+{
+    config.lazySequenceInflation(true);
+    loadDocument(LAZY_SEQUENCE);
+    auto sequence = std::static_pointer_cast<CoreComponent>(component);
+    ASSERT_EQ(4, sequence->getChildCount());
+
+    // Removing an inflated child leaves the deferred children alone
+    ASSERT_TRUE(sequence->getChildAt(1)->remove());
+    ASSERT_EQ(3, sequence->getChildCount());
+    ASSERT_EQ(17, sequence->getDeferredChildCount());
+
+    // Removing the last item inflates the children that belong before it
+    ASSERT_TRUE(sequence->getChildAt(2)->remove());
+    ASSERT_EQ(0, sequence->getDeferredChildCount());
+    ASSERT_EQ(19, sequence->getChildCount());
+    ASSERT_EQ("19-20-20", sequence->getChildAt(18)->getCalculated(kPropertyText).asString());
+}
+
+static const char *LAZY_SEQUENCE_MOUNT = R"({
+  "type": "APL",
+  "version": "1.4",
+  "mainTemplate": {
+    "items": {
+      "type": "Sequence",
+      "id": "foo",
+      "width": 100,
+      "height": 100,
+      "data": [0, 1, 2, 3, 4, 5, 6, 7, 8, 9],
+      "items": {
+        "type": "Text",
+        "id": "item${data}",
+        "height": 100,
+        "text": "${data}",
+        "onMount": {
+          "type": "SetValue",
+          "property": "text",
+          "value": "mounted ${data}"
+        }
+      }
+    }
+  }
+})";
+
+TEST_F(ScrollTest, LazySequenceFindById)
+{
+    config.lazySequenceInflation(true);
+    loadDocument(LAZY_SEQUENCE_MOUNT);
+    auto sequence = std::static_pointer_cast<CoreComponent>(component);
+    ASSERT_EQ(3, sequence->getChildCount());
+    ASSERT_EQ(7, sequence->getDeferredChildCount());
+
+    // Finding a deferred child inflates the children up to it
+    auto item = root->findComponentById("item5");
+    ASSERT_TRUE(item);
+    ASSERT_EQ(item, sequence->getChildAt(5));
+    ASSERT_EQ(6, sequence->getChildCount());
+    ASSERT_EQ(4, sequence->getDeferredChildCount());
+
+    // Commands can target deferred children
+    executeCommand("SetValue", {{"componentId", "item7"}, {"property", "text"}, {"value", "set"}}, true);
+    ASSERT_EQ("set", root->findComponentById("item7")->getCalculated(kPropertyText).asString());
+
+    // Unique ids never match a deferred child, so they do not inflate anything
+    auto deferred = sequence->getDeferredChildCount();
+    ASSERT_FALSE(root->findComponentById(":999999"));
+    ASSERT_EQ(deferred, sequence->getDeferredChildCount());
+
+    // A missing id inflates everything
+    ASSERT_FALSE(root->findComponentById("missing"));
+    ASSERT_EQ(0, sequence->getDeferredChildCount());
+    ASSERT_EQ(10, sequence->getChildCount());
+}
+
+TEST_F(ScrollTest, LazySequenceMount)
+{
+    config.lazySequenceInflation(true);
+    loadDocument(LAZY_SEQUENCE_MOUNT);
+    auto sequence = std::static_pointer_cast<CoreComponent>(component);
+    ASSERT_EQ(3, sequence->getChildCount());
+    for (int i = 0 ; i < 3 ; i++)
+        ASSERT_EQ("mounted " + std::to_string(i), sequence->getChildAt(i)->getCalculated(kPropertyText).asString());
+
+    // Children inflated after the document mounted run "onMount" as they are inserted
+    sequence->update(kUpdateScrollPosition, 100);
+    root->clearPending();
+    ASSERT_EQ(4, sequence->getChildCount());
+    ASSERT_EQ("mounted 3", sequence->getChildAt(3)->getCalculated(kPropertyText).asString());
+
+    scrollToIndex(component, 9, kCommandScrollAlignLast);
+    ASSERT_EQ(10, sequence->getChildCount());
+    for (int i = 0 ; i < 10 ; i++)
+        ASSERT_EQ("mounted " + std::to_string(i), sequence->getChildAt(i)->getCalculated(kPropertyText).asString());
+}
+
+TEST_F(ScrollTest, LazySequenceScrollCommand)
+{
+    config.lazySequenceInflation(true);
+    loadDocument(LAZY_SEQUENCE);
+    auto sequence = std::static_pointer_cast<CoreComponent>(component);
+    ASSERT_EQ(17, sequence->getDeferredChildCount());
+
+    // Scrolling by distance inflates the children needed to reach the new position
+    executeCommand("Scroll", {{"componentId", "foo"}, {"distance", 10}}, false);
+    ASSERT_TRUE(root->hasEvent());
+    auto event = root->popEvent();
+    ASSERT_EQ(kEventTypeScrollTo, event.getType());
+    ASSERT_EQ(Dimension(1000), event.getValue(kEventPropertyPosition).asDimension(*context));
+    ASSERT_LT(0, sequence->getDeferredChildCount());
+    ASSERT_LE(11, sequence->getChildCount());
+}
+
+static const char *LARGE_SEQUENCE = R"({
+  "type": "APL",
+  "version": "1.4",
+  "mainTemplate": {
+    "parameters": [ "payload" ],
+    "items": {
+      "type": "Sequence",
+      "id": "foo",
+      "scrollDirection": "${payload.direction}",
+      "width": 200,
+      "height": 200,
+      "data": "${payload.items}",
+      "items": {
+        "type": "Frame",
+        "width": 100,
+        "height": 100,
+        "items": {
+          "type": "Text",
+          "text": "${data}"
+        }
+      }
+    }
+  }
+})";
+
+static std::string
+largeSequenceData(const std::string& direction, int count)
+{
+    std::string data = R"({"direction": ")" + direction + R"(", "items": [)";
+    for (int i = 0 ; i < count ; i++)
+        data += (i ? "," : "") + std::to_string(i);
+    return data + "]}";
+}
+
+static void
+checkLargeSequence(ScrollTest& test, const std::string& direction)
+{
+    const int COUNT = 1000;
+    auto horizontal = direction == "horizontal";
+
+    // A child cache as long as the sequence lays out every child in the first layout pass
+    test.config.sequenceChildCache(COUNT / 2);
+    test.loadDocument(LARGE_SEQUENCE, largeSequenceData(direction, COUNT).c_str());
+
+    ASSERT_EQ(COUNT, test.component->getChildCount());
+    ASSERT_TRUE(CheckChildrenLaidOut(test.component, Range(0, COUNT - 1), true));
+    auto last = test.component->getChildAt(COUNT - 1)->getCalculated(kPropertyBounds).getRect();
+    ASSERT_EQ(Rect(horizontal ? (COUNT - 1) * 100 : 0, horizontal ? 0 : (COUNT - 1) * 100, 100, 100), last);
+
+    // Jumping straight to the end lays out every child in between
+    test.config.sequenceChildCache(1);
+    test.loadDocument(LARGE_SEQUENCE, largeSequenceData(direction, COUNT).c_str());
+    test.scrollToIndex(test.component, COUNT - 1, kCommandScrollAlignLast);
+
+    ASSERT_EQ(horizontal ? Point((COUNT - 2) * 100, 0) : Point(0, (COUNT - 2) * 100),
+              test.component->scrollPosition());
+    ASSERT_TRUE(CheckChildrenLaidOut(test.component, Range(0, COUNT - 1), true));
+}
+
+TEST_F(ScrollTest, LargeSequenceVertical)
+{
+    checkLargeSequence(*this, "vertical");
+}
+
+TEST_F(ScrollTest, LargeSequenceHorizontal)
+{
+    checkLargeSequence(*this, "horizontal");
+}
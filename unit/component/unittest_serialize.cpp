@@ -19,6 +19,7 @@
 #include "rapidjson/document.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/prettywriter.h"
+#include "rapidjson/writer.h"
 
 #include "../testeventloop.h"
 
@@ -821,3 +822,222 @@ TEST_F(SerializeTest, AVG)
     ASSERT_EQ(textJson["props"]["text"].GetString(), text->getValue(kGraphicPropertyText).getString());
     ASSERT_EQ(textJson["props"]["textAnchor"].GetDouble(), text->getValue(kGraphicPropertyTextAnchor).getInteger());
 }
+
+static std::string
+stringify(const rapidjson::Value& value)
+{
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    value.Accept(writer);
+    return buffer.GetString();
+}
+
+static const char *SNAPSHOT = R"({
+  "type": "APL",
+  "version": "1.4",
+  "mainTemplate": {
+    "items": {
+      "type": "Container",
+      "data": "${TestArray}",
+      "items": {
+        "type": "Frame",
+        "id": "frame${data}",
+        "items": {
+          "type": "Text",
+          "id": "text${data}",
+          "text": "${data}"
+        }
+      }
+    }
+  }
+})";
+
+TEST_F(SerializeTest, Snapshot)
+{
+    auto myArray = LiveArray::create(ObjectArray{"A", "B", "C"});
+    config.liveData("TestArray", myArray);
+    loadDocument(SNAPSHOT);
+    ASSERT_TRUE(component);
+
+    rapidjson::Document doc;
+    ASSERT_EQ(stringify(component->serialize(doc.GetAllocator())), component->serializeSnapshot());
+
+    auto frameC = component->getCoreChildAt(2);
+    auto textC = frameC->getCoreChildAt(0);
+    textC->setProperty(kPropertyText, "Changed");
+    root->clearPending();
+    ASSERT_EQ(stringify(component->serialize(doc.GetAllocator())), component->serializeSnapshot());
+    ASSERT_NE(std::string::npos, frameC->serializeSnapshot().find("Changed"));
+
+    // A second change to a property that is still dirty
+    textC->setProperty(kPropertyText, "Changed again");
+    root->clearPending();
+    ASSERT_EQ(stringify(component->serialize(doc.GetAllocator())), component->serializeSnapshot());
+
+    // Child list changes
+    myArray->insert(1, "Z");
+    myArray->remove(3);
+    root->clearPending();
+    ASSERT_EQ(3, component->getChildCount());
+    ASSERT_EQ(stringify(component->serialize(doc.GetAllocator())), component->serializeSnapshot());
+
+    // Clearing the dirty flags does not change the snapshot
+    root->clearDirty();
+    ASSERT_EQ(stringify(component->serialize(doc.GetAllocator())), component->serializeSnapshot());
+}
+
+static const char *SNAPSHOT_GRAPHIC = R"({
+  "type": "APL",
+  "version": "1.4",
+  "mainTemplate": {
+    "items": {
+      "type": "VectorGraphic",
+      "id": "vg",
+      "source": "box",
+      "boxColor": "red"
+    }
+  },
+  "graphics": {
+    "box": {
+      "type": "AVG",
+      "version": "1.1",
+      "height": 100,
+      "width": 100,
+      "parameters": [ "boxColor" ],
+      "items": {
+        "type": "path",
+        "pathData": "M0,0 h100 v100 h-100 z",
+        "fill": "${boxColor}"
+      }
+    }
+  }
+})";
+
+TEST_F(SerializeTest, SnapshotGraphic)
+{
+    loadDocument(SNAPSHOT_GRAPHIC);
+    ASSERT_TRUE(component);
+
+    rapidjson::Document doc;
+    ASSERT_EQ(stringify(component->serialize(doc.GetAllocator())), component->serializeSnapshot());
+
+    // The second change arrives while the graphic element is still dirty
+    for (auto color : {"blue", "green"}) {
+        executeCommand("SetValue", {{"componentId", "vg"}, {"property", "boxColor"}, {"value", color}}, true);
+        root->clearPending();
+        ASSERT_EQ(stringify(component->serialize(doc.GetAllocator())), component->serializeSnapshot());
+    }
+}
+
+static const char *SNAPSHOT_VIDEO = R"({
+  "type": "APL",
+  "version": "1.4",
+  "mainTemplate": {
+    "items": {
+      "type": "Container",
+      "items": {
+        "type": "Video",
+        "id": "video",
+        "source": [ "URL1", "URL2" ]
+      }
+    }
+  }
+})";
+
+TEST_F(SerializeTest, SnapshotMediaState)
+{
+    loadDocument(SNAPSHOT_VIDEO);
+    ASSERT_TRUE(component);
+
+    rapidjson::Document doc;
+    ASSERT_EQ(stringify(component->serialize(doc.GetAllocator())), component->serializeSnapshot());
+
+    // Media state is not marked dirty, but it is part of the snapshot
+    auto video = root->findComponentById("video");
+    video->updateMediaState(MediaState(1, 2, 1000, 38000, false, false));
+    root->clearPending();
+    ASSERT_EQ(stringify(component->serialize(doc.GetAllocator())), component->serializeSnapshot());
+    ASSERT_NE(std::string::npos, component->serializeSnapshot().find("\"_trackCurrentTime\":1000"));
+}
+
+static const char *SNAPSHOT_UPDATES = R"({
+  "type": "APL",
+  "version": "1.4",
+  "mainTemplate": {
+    "items": {
+      "type": "Container",
+      "items": [
+        {
+          "type": "Sequence",
+          "id": "sequence",
+          "height": 100,
+          "data": [ 1, 2, 3, 4, 5 ],
+          "items": { "type": "Frame", "height": 100 }
+        },
+        {
+          "type": "Pager",
+          "id": "pager",
+          "height": 100,
+          "data": [ 1, 2, 3 ],
+          "items": { "type": "Frame" }
+        },
+        {
+          "type": "EditText",
+          "id": "edit",
+          "text": "Start"
+        }
+      ]
+    }
+  }
+})";
+
+/**
+ * Scrolling, paging and typing change serialized properties without marking them dirty.
+ */
+TEST_F(SerializeTest, SnapshotUpdates)
+{
+    loadDocument(SNAPSHOT_UPDATES);
+    ASSERT_TRUE(component);
+
+    rapidjson::Document doc;
+    ASSERT_EQ(stringify(component->serialize(doc.GetAllocator())), component->serializeSnapshot());
+
+    root->findComponentById("sequence")->update(kUpdateScrollPosition, 200);
+    ASSERT_EQ(stringify(component->serialize(doc.GetAllocator())), component->serializeSnapshot());
+    ASSERT_NE(std::string::npos, component->serializeSnapshot().find("\"_scrollPosition\":200"));
+
+    root->findComponentById("pager")->update(kUpdatePagerPosition, 2);
+    ASSERT_EQ(stringify(component->serialize(doc.GetAllocator())), component->serializeSnapshot());
+    ASSERT_NE(std::string::npos, component->serializeSnapshot().find("\"_currentPage\":2"));
+
+    root->findComponentById("edit")->update(kUpdateTextChange, "Typed");
+    ASSERT_EQ(stringify(component->serialize(doc.GetAllocator())), component->serializeSnapshot());
+    ASSERT_NE(std::string::npos, component->serializeSnapshot().find("\"text\":\"Typed\""));
+}
+
+/**
+ * A snapshot of a large document matches a full serialization after each single change.
+ */
+TEST_F(SerializeTest, SnapshotLargeDocument)
+{
+    const int COUNT = 1500;   // 3000 components
+    ObjectArray items;
+    for (int i = 0 ; i < COUNT ; i++)
+        items.emplace_back(i);
+    auto myArray = LiveArray::create(std::move(items));
+    config.liveData("TestArray", myArray);
+    loadDocument(SNAPSHOT);
+    ASSERT_EQ(COUNT, component->getChildCount());
+
+    // Prime the cache
+    component->serializeSnapshot();
+
+    for (int pass = 0 ; pass < 20 ; pass++) {
+        component->getCoreChildAt(pass * 37 % COUNT)->getCoreChildAt(0)->setProperty(kPropertyText, "Pass " + std::to_string(pass));
+        root->clearPending();
+        root->clearDirty();
+
+        rapidjson::Document doc;
+        ASSERT_EQ(stringify(component->serialize(doc.GetAllocator())), component->serializeSnapshot());
+    }
+}
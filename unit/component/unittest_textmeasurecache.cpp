@@ -0,0 +1,395 @@
+/**
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+#include "../testeventloop.h"
+
+#include "apl/component/textmeasurecache.h"
+
+using namespace apl;
+
+/**
+ * Each character is 10 units wide and the text wraps to the available width.
+ */
+static LayoutSize
+textSize(Component *component, float width, MeasureMode widthMode)
+{
+    auto length = component->getCalculated(kPropertyText).asString().size();
+    auto fontSize = component->getCalculated(kPropertyFontSize).asNumber();
+    float textWidth = 10 * length;
+    if (widthMode != Undefined && textWidth > width) {
+        auto lines = std::ceil(textWidth / width);
+        return LayoutSize({width, static_cast<float>(lines * fontSize)});
+    }
+    return LayoutSize({textWidth, static_cast<float>(fontSize)});
+}
+
+class CountingTextMeasurement : public TextMeasurement {
+public:
+    LayoutSize measure(Component *component, float width, MeasureMode widthMode,
+                       float height, MeasureMode heightMode) override {
+        measures++;
+        return textSize(component, width, widthMode);
+    }
+
+    float baseline(Component *component, float width, float height) override {
+        baselines++;
+        return height * 0.8f;
+    }
+
+    int measures = 0;
+    int baselines = 0;
+};
+
+class TextMeasureCacheTest : public DocumentWrapper {
+public:
+    TextMeasureCacheTest() : measurement(std::make_shared<CountingTextMeasurement>()) {
+        config.measure(measurement);
+    }
+
+    std::shared_ptr<CountingTextMeasurement> measurement;
+};
+
+static const char *REPEATED_TEXT = R"({
+  "type": "APL",
+  "version": "1.4",
+  "mainTemplate": {
+    "items": {
+      "type": "Container",
+      "width": 500,
+      "direction": "row",
+      "alignItems": "baseline",
+      "wrap": "wrap",
+      "data": [1, 2, 3, 4, 5, 6, 7, 8],
+      "items": {
+        "type": "Text",
+        "id": "text${data}",
+        "text": "Repeated",
+        "fontSize": 20
+      }
+    }
+  }
+})";
+
+TEST_F(TextMeasureCacheTest, DisabledByDefault)
+{
+    loadDocument(REPEATED_TEXT);
+
+    ASSERT_EQ(0, root->textMeasureCache().capacity());
+    ASSERT_EQ(0, root->textMeasureCache().hits());
+    ASSERT_LE(8, measurement->measures);
+    ASSERT_LE(8, measurement->baselines);
+}
+
+TEST_F(TextMeasureCacheTest, SharedBetweenComponents)
+{
+    config.textMeasurementCacheSize(100);
+    loadDocument(REPEATED_TEXT);
+
+    // Every Text has the same properties and constraints, so the host only measures once
+    ASSERT_EQ(1, measurement->measures);
+    ASSERT_EQ(1, measurement->baselines);
+    const auto& cache = root->textMeasureCache();
+    ASSERT_EQ(2, cache.misses());
+    ASSERT_LE(14, cache.hits());
+    ASSERT_EQ(2, cache.size());
+
+    // Six Text components fit on each line
+    for (int i = 0 ; i < 8 ; i++)
+        ASSERT_EQ(Rect(80 * (i % 6), 20 * (i / 6), 80, 20),
+                  root->findComponentById("text" + std::to_string(i + 1))->getCalculated(kPropertyBounds).getRect());
+}
+
+TEST_F(TextMeasureCacheTest, PropertyChange)
+{
+    config.textMeasurementCacheSize(100);
+    loadDocument(REPEATED_TEXT);
+    auto measures = measurement->measures;
+
+    // A changed text property is measured again
+    auto text = root->findComponentById("text3");
+    executeCommand("SetValue", {{"componentId", "text3"}, {"property", "text"}, {"value", "Long"}}, true);
+    root->clearPending();
+    ASSERT_EQ(measures + 1, measurement->measures);
+    ASSERT_EQ(Rect(160, 0, 40, 20), text->getCalculated(kPropertyBounds).getRect());
+
+    // Switching back uses the result stored for the other components
+    executeCommand("SetValue", {{"componentId", "text3"}, {"property", "text"}, {"value", "Repeated"}}, true);
+    root->clearPending();
+    ASSERT_EQ(measures + 1, measurement->measures);
+    ASSERT_EQ(Rect(160, 0, 80, 20), text->getCalculated(kPropertyBounds).getRect());
+
+    // Properties that do not affect layout keep the cached result
+    executeCommand("SetValue", {{"componentId", "text3"}, {"property", "color"}, {"value", "red"}}, true);
+    root->clearPending();
+    ASSERT_EQ(measures + 1, measurement->measures);
+}
+
+static const char *DISTINCT_TEXT = R"({
+  "type": "APL",
+  "version": "1.4",
+  "mainTemplate": {
+    "items": {
+      "type": "Container",
+      "width": 500,
+      "data": [1, 22, 333, 4444, 55555],
+      "items": {
+        "type": "Text",
+        "text": "${data}",
+        "fontSize": 20
+      }
+    }
+  }
+})";
+
+TEST_F(TextMeasureCacheTest, LeastRecentlyUsed)
+{
+    config.textMeasurementCacheSize(2);
+    loadDocument(DISTINCT_TEXT);
+
+    ASSERT_EQ(2, root->textMeasureCache().size());
+    ASSERT_EQ(5, component->getChildCount());
+    for (int i = 0 ; i < 5 ; i++)
+        ASSERT_EQ(Rect(0, 20 * i, 500, 20), component->getChildAt(i)->getCalculated(kPropertyBounds).getRect());
+}
+
+/**
+ * Measures batches with the same metrics as CountingTextMeasurement.
+ */
+class CountingBatchTextMeasurement : public BatchTextMeasurement {
+public:
+    LayoutSize measure(Component *component, float width, MeasureMode widthMode,
+                       float height, MeasureMode heightMode) override {
+        measures++;
+        return textSize(component, width, widthMode);
+    }
+
+    float baseline(Component *component, float width, float height) override {
+        baselines++;
+        return height * 0.8f;
+    }
+
+    void measureBatch(const std::vector<TextMeasureRequest>& requests,
+                      std::vector<TextMeasureResult>& results) override {
+        batches.push_back(requests.size());
+        if (dropResults)
+            return;
+
+        for (const auto& m : requests) {
+            auto size = textSize(m.component, m.width, m.widthMode);
+            if (m.widthMode == Exactly)
+                size.width = m.width;
+            if (m.heightMode == Exactly)
+                size.height = m.height;
+            results.emplace_back(TextMeasureResult{size, size.height * 0.8f});
+        }
+    }
+
+    int measures = 0;
+    int baselines = 0;
+    std::vector<size_t> batches;
+    bool dropResults = false;
+};
+
+class BatchTextMeasurementTest : public DocumentWrapper {
+public:
+    BatchTextMeasurementTest() : measurement(std::make_shared<CountingBatchTextMeasurement>()) {
+        config.measure(measurement);
+    }
+
+    std::shared_ptr<CountingBatchTextMeasurement> measurement;
+};
+
+TEST_F(BatchTextMeasurementTest, SingleBatch)
+{
+    loadDocument(DISTINCT_TEXT);
+
+    // Every Text is measured in the first batch
+    ASSERT_EQ(5, measurement->batches.at(0));
+    ASSERT_EQ(0, measurement->measures);
+    ASSERT_EQ(0, measurement->baselines);
+    auto batches = measurement->batches.size();
+    ASSERT_EQ(batches, root->textMeasureCache().batches());
+    for (int i = 0 ; i < 5 ; i++)
+        ASSERT_EQ(Rect(0, 20 * i, 500, 20), component->getChildAt(i)->getCalculated(kPropertyBounds).getRect());
+
+    // Only the changed Text is measured in the next layout
+    auto text = component->getChildAt(2);
+    executeCommand("SetValue", {{"componentId", text->getUniqueId()}, {"property", "text"}, {"value", "Longer"}}, true);
+    root->clearPending();
+    ASSERT_EQ(batches + 1, measurement->batches.size());
+    ASSERT_EQ(1, measurement->batches.back());
+    ASSERT_EQ(0, measurement->measures);
+    ASSERT_EQ(Rect(0, 40, 500, 20), text->getCalculated(kPropertyBounds).getRect());
+}
+
+TEST_F(BatchTextMeasurementTest, Baseline)
+{
+    loadDocument(REPEATED_TEXT);
+
+    // Baselines are served from the measurements
+    ASSERT_EQ(0, measurement->measures);
+    ASSERT_EQ(0, measurement->baselines);
+    ASSERT_FALSE(measurement->batches.empty());
+    for (int i = 0 ; i < 8 ; i++)
+        ASSERT_EQ(Rect(80 * (i % 6), 20 * (i / 6), 80, 20),
+                  root->findComponentById("text" + std::to_string(i + 1))->getCalculated(kPropertyBounds).getRect());
+}
+
+static const char *DEPENDENT_TEXT = R"({
+  "type": "APL",
+  "version": "1.4",
+  "mainTemplate": {
+    "items": {
+      "type": "Container",
+      "width": 300,
+      "direction": "row",
+      "alignItems": "start",
+      "items": [
+        {
+          "type": "Text",
+          "id": "first",
+          "text": "First text",
+          "fontSize": 20
+        },
+        {
+          "type": "Text",
+          "id": "second",
+          "text": "Second",
+          "fontSize": 20,
+          "grow": 1
+        }
+      ]
+    }
+  }
+})";
+
+TEST_F(BatchTextMeasurementTest, DependentConstraints)
+{
+    loadDocument(DEPENDENT_TEXT);
+
+    // The second Text is measured again at the width left by the first, which needs a second batch
+    ASSERT_EQ(0, measurement->measures);
+    ASSERT_LE(2, measurement->batches.size());
+    ASSERT_EQ(Rect(0, 0, 100, 20), root->findComponentById("first")->getCalculated(kPropertyBounds).getRect());
+    ASSERT_EQ(Rect(100, 0, 200, 20), root->findComponentById("second")->getCalculated(kPropertyBounds).getRect());
+}
+
+static const char *TEXT_SEQUENCE = R"({
+  "type": "APL",
+  "version": "1.4",
+  "mainTemplate": {
+    "parameters": ["payload"],
+    "items": {
+      "type": "Sequence",
+      "width": 200,
+      "height": 100,
+      "data": "${payload}",
+      "items": {
+        "type": "Text",
+        "text": "Item ${data}",
+        "fontSize": 20
+      }
+    }
+  }
+})";
+
+TEST_F(BatchTextMeasurementTest, Sequence)
+{
+    std::string data = "[0";
+    for (int i = 1 ; i < 100 ; i++)
+        data += "," + std::to_string(i);
+    loadDocument(TEXT_SEQUENCE, (data + "]").c_str());
+    ASSERT_EQ(100, component->getChildCount());
+    ASSERT_EQ(0, measurement->measures);
+
+    auto laidOut = [&]() {
+        size_t count = 0;
+        for (size_t i = 0 ; i < component->getChildCount() ; i++) {
+            auto bounds = component->getChildAt(i)->getCalculated(kPropertyBounds).getRect();
+            if (bounds.isEmpty())
+                continue;
+            EXPECT_EQ(Rect(0, 20 * i, 200, 20), bounds);
+            count++;
+        }
+        return count;
+    };
+
+    auto batches = measurement->batches.size();
+    auto count = laidOut();
+    ASSERT_LT(0, batches);
+    ASSERT_LT(0, count);
+
+    // Children laid out while scrolling are batched as well
+    component->update(kUpdateScrollPosition, 1000);
+    root->clearPending();
+    ASSERT_EQ(0, measurement->measures);
+    ASSERT_LT(batches, measurement->batches.size());
+    ASSERT_LT(count, laidOut());
+}
+
+TEST_F(BatchTextMeasurementTest, MissingResults)
+{
+    measurement->dropResults = true;
+    loadDocument(DISTINCT_TEXT);
+
+    // The components are measured one at a time instead
+    ASSERT_EQ(5, measurement->batches.at(0));
+    ASSERT_LE(5, measurement->measures);
+    for (int i = 0 ; i < 5 ; i++)
+        ASSERT_EQ(Rect(0, 20 * i, 500, 20), component->getChildAt(i)->getCalculated(kPropertyBounds).getRect());
+}
+
+static const char *SAME_TEXT_TWO_WIDTHS = R"({
+  "type": "APL",
+  "version": "1.4",
+  "mainTemplate": {
+    "items": {
+      "type": "Container",
+      "width": 500,
+      "items": [
+        {
+          "type": "Container",
+          "width": 300,
+          "alignItems": "start",
+          "items": { "type": "Text", "text": "Hello", "fontSize": 20 }
+        },
+        {
+          "type": "Container",
+          "id": "second",
+          "width": 400,
+          "alignItems": "start",
+          "display": "none",
+          "items": { "type": "Text", "text": "Hello", "fontSize": 20 }
+        }
+      ]
+    }
+  }
+})";
+
+TEST_F(BatchTextMeasurementTest, StoredBaselineKey)
+{
+    config.textMeasurementCacheSize(100);
+    loadDocument(SAME_TEXT_TWO_WIDTHS);
+    const auto& cache = root->textMeasureCache();
+    auto size = cache.size();
+
+    // The second Text is measured with a different width but has the same size, so the baseline
+    // derived from its measurement is already stored.  It replaces the stored entry.
+    executeCommand("SetValue", {{"componentId", "second"}, {"property", "display"}, {"value", "normal"}}, true);
+    root->clearPending();
+    ASSERT_EQ(size + 1, cache.size());
+    ASSERT_EQ(Rect(0, 0, 50, 20), component->getChildAt(1)->getChildAt(0)->getCalculated(kPropertyBounds).getRect());
+}
@@ -15,6 +15,8 @@
 
 #include "../testeventloop.h"
 
+#include "apl/engine/tickscheduler.h"
+
 using namespace apl;
 
 class TickTest : public DocumentWrapper {};
@@ -488,3 +490,131 @@ TEST_F(TickTest, CantGo0) {
     root->updateTime(2);
     ASSERT_TRUE(CheckSendEvent(root, 2.0));
 }
+
+static const char *SEQUENCE_TICKERS = R"({
+  "type": "APL",
+  "version": "1.4",
+  "mainTemplate": {
+    "parameters": [ "payload" ],
+    "item": {
+      "type": "Sequence",
+      "height": 100,
+      "data": "${payload}",
+      "item": {
+        "type": "Text",
+        "height": 50,
+        "text": "${data}",
+        "handleTick": {
+          "minimumDelay": 100,
+          "when": "${data % 2 == 0}",
+          "commands": {
+            "type": "SendEvent",
+            "sequencer": "SEQUENCER_${data}",
+            "arguments": [ "${data}" ]
+          }
+        }
+      }
+    }
+  }
+})";
+
+static std::string
+sequenceData(int count)
+{
+    std::string data = "[";
+    for (int i = 0 ; i < count ; i++)
+        data += (i ? "," : "") + std::to_string(i);
+    return data + "]";
+}
+
+static std::vector<int>
+tickedItems(const RootContextPtr& root)
+{
+    std::vector<int> result;
+    while (root->hasEvent()) {
+        auto event = root->popEvent();
+        if (event.getType() == kEventTypeSendEvent)
+            result.emplace_back(event.getValue(kEventPropertyArguments).at(0).asInt());
+    }
+    return result;
+}
+
+TEST_F(TickTest, CoalescedBuckets) {
+    loadDocument(SEQUENCE_TICKERS, sequenceData(50).c_str());
+
+    // Only the odd items are skipped by "when"; all handlers share one timeout
+    auto& scheduler = context->tickScheduler();
+    ASSERT_EQ(50, scheduler.size());
+    ASSERT_EQ(1, scheduler.buckets());
+
+    root->updateTime(100);
+    auto ticked = tickedItems(root);
+    ASSERT_FALSE(ticked.empty());
+    for (auto item : ticked)
+        ASSERT_EQ(0, item % 2);
+
+    // Items far below the viewport are not laid out, so their handlers are suspended
+    ASSERT_LT(ticked.back(), 40);
+    ASSERT_EQ(1, scheduler.buckets());
+
+    // Laying out an item resumes its handler
+    component->getChildAt(48)->ensureLayout(true);
+    root->updateTime(200);
+    ticked = tickedItems(root);
+    ASSERT_NE(ticked.end(), std::find(ticked.begin(), ticked.end(), 48));
+    ASSERT_EQ(1, scheduler.buckets());
+}
+
+TEST_F(TickTest, CoalescedRelease) {
+    loadDocument(SEQUENCE_TICKERS, sequenceData(50).c_str());
+    ASSERT_EQ(50, context->tickScheduler().size());
+
+    // Removing a component drops its handler on the next tick
+    component->getChildAt(0)->remove();
+    root->clearPending();
+    root->updateTime(100);
+    tickedItems(root);
+    ASSERT_EQ(49, context->tickScheduler().size());
+}
+
+static const char *LIVE_TICKERS = R"({
+  "type": "APL",
+  "version": "1.4",
+  "mainTemplate": {
+    "item": {
+      "type": "Container",
+      "data": "${TestArray}",
+      "item": {
+        "type": "Text",
+        "text": "${data}",
+        "handleTick": {
+          "minimumDelay": 100,
+          "commands": {
+            "type": "SendEvent",
+            "sequencer": "SEQUENCER_${data}",
+            "arguments": [ "${data}" ]
+          }
+        }
+      }
+    }
+  }
+})";
+
+TEST_F(TickTest, JoinExistingBucket) {
+    auto myArray = LiveArray::create(ObjectArray{1});
+    config.liveData("TestArray", myArray);
+    loadDocument(LIVE_TICKERS);
+
+    // A handler added part way through a period shares the bucket but waits a full period
+    root->updateTime(50);
+    myArray->push_back(2);
+    root->clearPending();
+    ASSERT_EQ(2, context->tickScheduler().size());
+    ASSERT_EQ(1, context->tickScheduler().buckets());
+
+    root->updateTime(100);
+    ASSERT_EQ(std::vector<int>{1}, tickedItems(root));
+
+    root->updateTime(200);
+    ASSERT_EQ(std::vector<int>({1, 2}), tickedItems(root));
+}
@@ -0,0 +1,201 @@
+/**
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include "apl/component/component.h"
+#include "apl/content/content.h"
+#include "apl/content/importrequest.h"
+#include "apl/content/metrics.h"
+#include "apl/content/package.h"
+#include "apl/content/packagecache.h"
+#include "apl/engine/rootcontext.h"
+#include "apl/primitives/color.h"
+
+using namespace apl;
+
+class PackageCacheTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        PackageCache::instance().clear();
+        PackageCache::instance().setCapacity(10);
+    }
+
+    void TearDown() override {
+        PackageCache::instance().setCapacity(0);
+        PackageCache::instance().clear();
+    }
+
+    static ContentPtr load(const char *document) {
+        auto content = Content::create(document);
+        while (content && content->isWaiting() && !content->isError()) {
+            auto requested = content->getRequestedPackages();
+            if (requested.empty())
+                break;
+            for (const auto& m : requested)
+                content->addPackage(m, packageFor(m.reference()));
+        }
+        return content;
+    }
+
+    static const char *packageFor(const ImportRef& reference);
+
+    static int sLoads;
+};
+
+int PackageCacheTest::sLoads = 0;
+
+static const char *MAIN_DOC = R"apl({
+  "type": "APL",
+  "version": "1.4",
+  "import": [
+    {
+      "name": "styles",
+      "version": "1.0"
+    }
+  ],
+  "mainTemplate": {
+    "items": {
+      "type": "Frame",
+      "style": "accentFrame"
+    }
+  }
+})apl";
+
+static const char *STYLES_PACKAGE = R"apl({
+  "type": "APL",
+  "version": "1.4",
+  "import": [
+    {
+      "name": "colors",
+      "version": "1.0"
+    }
+  ],
+  "styles": {
+    "accentFrame": {
+      "values": [
+        {
+          "backgroundColor": "@accent"
+        },
+        {
+          "when": "${state.pressed}",
+          "backgroundColor": "green"
+        }
+      ]
+    }
+  }
+})apl";
+
+static const char *COLORS_PACKAGE = R"apl({
+  "type": "APL",
+  "version": "1.4",
+  "resources": [
+    {
+      "colors": {
+        "accent": "blue"
+      }
+    },
+    {
+      "when": "${viewport.theme == 'light'}",
+      "colors": {
+        "accent": "red"
+      }
+    }
+  ]
+})apl";
+
+const char *
+PackageCacheTest::packageFor(const ImportRef& reference)
+{
+    sLoads++;
+    return reference.name() == "styles" ? STYLES_PACKAGE : COLORS_PACKAGE;
+}
+
+TEST_F(PackageCacheTest, DisabledByDefault)
+{
+    PackageCache::instance().setCapacity(0);
+
+    sLoads = 0;
+    ASSERT_TRUE(load(MAIN_DOC)->isReady());
+    ASSERT_TRUE(load(MAIN_DOC)->isReady());
+    ASSERT_EQ(4, sLoads);
+    ASSERT_EQ(0, PackageCache::instance().size());
+}
+
+TEST_F(PackageCacheTest, SharedBetweenDocuments)
+{
+    sLoads = 0;
+    auto first = load(MAIN_DOC);
+    ASSERT_TRUE(first->isReady());
+    ASSERT_EQ(2, sLoads);
+    ASSERT_EQ(2, PackageCache::instance().size());
+
+    // The second document is ready without requesting any packages
+    auto second = Content::create(MAIN_DOC);
+    ASSERT_TRUE(second->isReady());
+    ASSERT_TRUE(second->getRequestedPackages().empty());
+    ASSERT_EQ(2, sLoads);
+    ASSERT_EQ(2, PackageCache::instance().hits());
+
+    // Both documents share the same package and its compiled styles
+    auto package = first->getPackage("styles");
+    ASSERT_TRUE(package);
+    ASSERT_EQ(package, second->getPackage("styles"));
+    ASSERT_EQ(1, package->styleBlocks().size());
+
+    // Resources are still evaluated against each document's viewport
+    auto dark = RootContext::create(Metrics().size(1024, 800).theme("dark"), first);
+    auto light = RootContext::create(Metrics().size(1024, 800).theme("light"), second);
+    ASSERT_TRUE(dark);
+    ASSERT_TRUE(light);
+    ASSERT_EQ(Color(Color::BLUE), dark->topComponent()->getCalculated(kPropertyBackgroundColor).getColor());
+    ASSERT_EQ(Color(Color::RED), light->topComponent()->getCalculated(kPropertyBackgroundColor).getColor());
+
+    light->topComponent()->update(kUpdatePressState, 1);
+    ASSERT_EQ(Color(Color::GREEN), light->topComponent()->getCalculated(kPropertyBackgroundColor).getColor());
+    ASSERT_EQ(Color(Color::BLUE), dark->topComponent()->getCalculated(kPropertyBackgroundColor).getColor());
+}
+
+TEST_F(PackageCacheTest, PartialHit)
+{
+    sLoads = 0;
+    ASSERT_TRUE(load(MAIN_DOC)->isReady());
+
+    // Shrinking the cache keeps the most recently loaded package
+    PackageCache::instance().setCapacity(1);
+    ASSERT_EQ(1, PackageCache::instance().size());
+
+    auto content = Content::create(MAIN_DOC);
+    ASSERT_FALSE(content->isReady());
+    auto requested = content->getRequestedPackages();
+    ASSERT_EQ(1, requested.size());
+    ASSERT_EQ("styles", requested.begin()->reference().name());
+
+    // The nested import is still cached
+    content->addPackage(*requested.begin(), STYLES_PACKAGE);
+    ASSERT_TRUE(content->isReady());
+    ASSERT_TRUE(content->getRequestedPackages().empty());
+}
+
+TEST_F(PackageCacheTest, InvalidPackageNotCached)
+{
+    auto content = Content::create(MAIN_DOC);
+    auto requested = content->getRequestedPackages();
+    ASSERT_EQ(1, requested.size());
+
+    content->addPackage(*requested.begin(), R"({"type": "APL", "version": "1.4", "import": 23})");
+    ASSERT_TRUE(content->isError());
+    ASSERT_EQ(0, PackageCache::instance().size());
+}
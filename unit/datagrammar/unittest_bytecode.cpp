@@ -0,0 +1,190 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "../testeventloop.h"
+
+#include "apl/datagrammar/bytecode.h"
+#include "apl/datagrammar/node.h"
+#include "apl/engine/contextdependant.h"
+#include "apl/engine/evaluate.h"
+
+using namespace apl;
+
+class ByteCodeTest : public MemoryWrapper {
+public:
+    ByteCodeTest() {
+        auto m = Metrics().size(2048,2048).dpi(320);
+        context = Context::create(m, session);
+        context->putUserWriteable("a", Dimension());
+        context->putUserWriteable("w", Dimension(0));
+        context->putUserWriteable("x", Dimension(10));
+        context->putUserWriteable("y", Dimension(20));
+        context->putUserWriteable("o", Dimension(DimensionType::Relative, 0));
+        context->putUserWriteable("p", Dimension(DimensionType::Relative, 10));
+        context->putUserWriteable("n", 7);
+        context->putUserWriteable("s", "fuzzy");
+        context->putUserWriteable("e", "");
+        context->putUserWriteable("b", true);
+        context->putUserWriteable("z", Object::NULL_OBJECT());
+        context->putUserWriteable("list", ObjectArray{1, 2, 3});
+        context->putUserWriteable("map", std::make_shared<ObjectMap>(ObjectMap{{"name", "Pat"}, {"age", 32}}));
+    }
+
+    ContextPtr context;
+};
+
+// Expressions drawn from the arithmetic and grammar test corpora.  All refer to mutable symbols.
+static const std::vector<std::string> CORPUS = {
+    "${!a}", "${!!x}", "${-n}", "${+x}", "${!w}",
+    "${x < y}", "${y >= x}", "${p == p}", "${a != x}", "${!(y == x)}",
+    "${x + w == x}", "${o + p == p}", "${n * 3 + 2}", "${(n - 1) / 2}", "${n % 4}", "${x * 2 - y}",
+    "${p / 2}", "${x / y}",
+    "${b && n}", "${b || n}", "${z ?? 'none'}", "${z ?? n ?? 'none'}", "${e || 'empty'}",
+    "${b ? x : y}", "${n > 5 ? 'big' : 'small'}", "${z ? 1 : b ? 2 : 3}",
+    "${s} is ${n}", "Value: ${n * 2}${e}", "${e}${s}",
+    "${list[1]}", "${list[-1]}", "${list.length}", "${map.name}", "${map['age'] + 1}",
+    "${Math.min(n, 3)}", "${Math.max(n, x, 100)}", "${String.toUpperCase(s)}",
+    "${Math.floor(n / 2) + list[0]}", "${n > 3 && (s == 'fuzzy' || b)}",
+};
+
+TEST_F(ByteCodeTest, MatchesTreeWalker)
+{
+    for (const auto& m : CORPUS) {
+        auto node = parseDataBinding(*context, m);
+        ASSERT_TRUE(node.isEvaluable()) << m;
+
+        auto byteCode = datagrammar::ByteCode::compile(node);
+        ASSERT_TRUE(byteCode) << m;
+        ASSERT_TRUE(IsEqual(node.eval(), byteCode->eval())) << m;
+    }
+
+    // Change the symbol values and check again
+    context->userUpdateAndRecalculate("n", 2, false);
+    context->userUpdateAndRecalculate("b", false, false);
+    context->userUpdateAndRecalculate("z", 12, false);
+    context->userUpdateAndRecalculate("e", "not empty", false);
+
+    for (const auto& m : CORPUS) {
+        auto node = parseDataBinding(*context, m);
+        auto byteCode = datagrammar::ByteCode::compile(node);
+        ASSERT_TRUE(IsEqual(node.eval(), byteCode->eval())) << m;
+    }
+}
+
+TEST_F(ByteCodeTest, NotEvaluable)
+{
+    ASSERT_FALSE(datagrammar::ByteCode::compile(Object(23)));
+    ASSERT_FALSE(datagrammar::ByteCode::compile(evaluate(*context, "${1+2}")));
+}
+
+TEST_F(ByteCodeTest, Ternary)
+{
+    auto byteCode = datagrammar::ByteCode::compile(parseDataBinding(*context, "${b ? n : n * 2}"));
+    ASSERT_TRUE(byteCode);
+    ASSERT_TRUE(IsEqual(7, byteCode->eval()));
+
+    context->userUpdateAndRecalculate("b", false, false);
+    ASSERT_TRUE(IsEqual(14, byteCode->eval()));
+
+    // The branches are jumps, not nested evaluations
+    const auto& instructions = byteCode->instructions();
+    ASSERT_EQ(datagrammar::kByteCodeEvaluate, instructions.at(0).opcode);
+    ASSERT_EQ(datagrammar::kByteCodePopJumpIfFalse, instructions.at(1).opcode);
+}
+
+static Object
+twice(const std::vector<Object>& args)
+{
+    return args.at(0).eval().asNumber() * 2;
+}
+
+TEST_F(ByteCodeTest, ConstantFolding)
+{
+    // An array access on constant values folds to a single value
+    auto access = std::make_shared<datagrammar::Node>(datagrammar::ApplyArrayAccess,
+                                                      std::vector<Object>{Object(ObjectArray{1, 2, 3}), Object(1)},
+                                                      "[]");
+    auto node = datagrammar::UnaryMinus(std::vector<Object>{Object(access)});
+    ASSERT_TRUE(node.isEvaluable());
+
+    auto byteCode = datagrammar::ByteCode::compile(node);
+    ASSERT_TRUE(byteCode);
+    ASSERT_TRUE(IsEqual(-2, byteCode->eval()));
+    ASSERT_EQ(1, byteCode->instructions().size());
+    ASSERT_EQ(datagrammar::kByteCodeLoadConstant, byteCode->instructions().at(0).opcode);
+    ASSERT_EQ(1, byteCode->data().size());
+
+    // A ternary with a constant condition only compiles the selected branch
+    node = datagrammar::Ternary(std::vector<Object>{Object(access), parseDataBinding(*context, "${n}"), Object(0)});
+    byteCode = datagrammar::ByteCode::compile(node);
+    ASSERT_TRUE(IsEqual(7, byteCode->eval()));
+    ASSERT_EQ(1, byteCode->instructions().size());
+    ASSERT_EQ(datagrammar::kByteCodeEvaluate, byteCode->instructions().at(0).opcode);
+}
+
+TEST_F(ByteCodeTest, UnknownOperator)
+{
+    // Operators the compiler does not recognize are evaluated through the tree walker
+    auto inner = std::make_shared<datagrammar::Node>(twice, std::vector<Object>{Object(3)}, "twice");
+    auto node = datagrammar::UnaryMinus(std::vector<Object>{Object(inner)});
+
+    auto byteCode = datagrammar::ByteCode::compile(node);
+    ASSERT_TRUE(IsEqual(-6, byteCode->eval()));
+    ASSERT_EQ(2, byteCode->instructions().size());
+    ASSERT_EQ(datagrammar::kByteCodeEvaluate, byteCode->instructions().at(0).opcode);
+    ASSERT_EQ(datagrammar::kByteCodeUnary, byteCode->instructions().at(1).opcode);
+}
+
+static int sCountedCalls = 0;
+
+static Object
+counted(const std::vector<Object>& args)
+{
+    sCountedCalls++;
+    return args.at(0);
+}
+
+TEST_F(ByteCodeTest, NotCallable)
+{
+    // The arguments of a call to something that is not a function are never evaluated
+    auto argument = std::make_shared<datagrammar::Node>(counted, std::vector<Object>{Object(3)}, "counted");
+    auto node = datagrammar::FunctionCall(std::vector<Object>{parseDataBinding(*context, "${z}"),
+                                                              Object(ObjectArray{Object(argument)})});
+    ASSERT_TRUE(node.isEvaluable());
+
+    auto byteCode = datagrammar::ByteCode::compile(node);
+    ASSERT_TRUE(byteCode);
+
+    sCountedCalls = 0;
+    ASSERT_TRUE(IsEqual(Object::NULL_OBJECT(), node.eval()));
+    ASSERT_EQ(0, sCountedCalls);
+    ASSERT_TRUE(IsEqual(Object::NULL_OBJECT(), byteCode->eval()));
+    ASSERT_EQ(0, sCountedCalls);
+
+    // A callable target evaluates its arguments once
+    context->userUpdateAndRecalculate("z", context->opt("Math").get("abs"), false);
+    ASSERT_TRUE(IsEqual(3, byteCode->eval()));
+    ASSERT_EQ(1, sCountedCalls);
+}
+
+TEST_F(ByteCodeTest, Dependant)
+{
+    context->putUserWriteable("target", 0);
+    auto node = parseDataBinding(*context, "${n * 10 + list[0]}");
+    ContextDependant::create(context, "target", node, context, sBindingFunctions.at(kBindingTypeNumber));
+
+    context->userUpdateAndRecalculate("n", 3, false);
+    ASSERT_TRUE(IsEqual(31, context->opt("target")));
+}
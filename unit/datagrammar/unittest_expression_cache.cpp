@@ -0,0 +1,133 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "../testeventloop.h"
+
+#include "apl/datagrammar/expressioncache.h"
+
+using namespace apl;
+
+class ExpressionCacheTest : public MemoryWrapper {
+public:
+    ExpressionCacheTest() {
+        Metrics m;
+        context = Context::create(m, session);
+    }
+
+    void SetUp() override {
+        MemoryWrapper::SetUp();
+        cache().clear();
+    }
+
+    void TearDown() override {
+        cache().setCapacity(datagrammar::ExpressionCache::DEFAULT_CAPACITY);
+        cache().clear();
+        MemoryWrapper::TearDown();
+    }
+
+    static datagrammar::ExpressionCache& cache() { return datagrammar::ExpressionCache::instance(); }
+
+    ContextPtr context;
+};
+
+TEST_F(ExpressionCacheTest, HitsAndMisses)
+{
+    ASSERT_EQ(0, cache().size());
+
+    ASSERT_TRUE(IsEqual(4, evaluate(*context, "${1+3}")));
+    ASSERT_EQ(1, cache().size());
+    ASSERT_EQ(0, cache().hits());
+    ASSERT_EQ(1, cache().misses());
+
+    ASSERT_TRUE(IsEqual(4, evaluate(*context, "${1+3}")));
+    ASSERT_EQ(1, cache().size());
+    ASSERT_EQ(1, cache().hits());
+    ASSERT_EQ(1, cache().misses());
+
+    // Strings without data-binding are not stored
+    ASSERT_TRUE(IsEqual("plain text", evaluate(*context, "plain text")));
+    ASSERT_EQ(1, cache().size());
+    ASSERT_EQ(1, cache().hits());
+    ASSERT_EQ(1, cache().misses());
+}
+
+TEST_F(ExpressionCacheTest, LateBinding)
+{
+    auto first = Context::create(context);
+    first->putConstant("a", 10);
+    auto second = Context::create(context);
+    second->putUserWriteable("a", 20);
+
+    ASSERT_TRUE(IsEqual(11, evaluate(*first, "${a+1}")));
+    ASSERT_TRUE(IsEqual(21, evaluate(*second, "${a+1}")));
+    ASSERT_TRUE(IsEqual(Object::NULL_OBJECT(), evaluate(*context, "${a}")));
+    ASSERT_EQ(1, cache().hits());
+
+    // The mutable binding still produces a node that tracks the context
+    auto node = parseDataBinding(*second, "${a+1}");
+    ASSERT_TRUE(node.isEvaluable());
+    second->userUpdateAndRecalculate("a", 30, false);
+    ASSERT_TRUE(IsEqual(31, node.eval()));
+
+    // Dimensions are bound against the viewport of the evaluating context
+    auto dimension = evaluate(*context, "${10vw}");
+    ASSERT_TRUE(dimension.isAbsoluteDimension());
+    ASSERT_NEAR(context->vwToDp(10), dimension.asNumber(), 0.0001);
+}
+
+TEST_F(ExpressionCacheTest, ConstantFolding)
+{
+    auto compiled = cache().get("${2*(3+4)} items");
+    ASSERT_TRUE(compiled->expression);
+    ASSERT_EQ(datagrammar::ExpressionTemplate::kConstant, compiled->expression->type());
+    ASSERT_TRUE(IsEqual("14 items", compiled->expression->value()));
+
+    compiled = cache().get("${a*(3+4)}");
+    ASSERT_TRUE(compiled->expression);
+    ASSERT_EQ(datagrammar::ExpressionTemplate::kOperator, compiled->expression->type());
+}
+
+TEST_F(ExpressionCacheTest, ParseError)
+{
+    ASSERT_TRUE(IsEqual("${1+}", evaluate(*context, "${1+}")));
+    ASSERT_TRUE(ConsoleMessage());
+
+    // Parse errors are cached and still reported on every evaluation
+    ASSERT_TRUE(IsEqual("${1+}", evaluate(*context, "${1+}")));
+    ASSERT_TRUE(ConsoleMessage());
+    ASSERT_EQ(1, cache().hits());
+}
+
+TEST_F(ExpressionCacheTest, Capacity)
+{
+    cache().setCapacity(2);
+
+    evaluate(*context, "${1}");
+    evaluate(*context, "${2}");
+    evaluate(*context, "${1}");   // Moves "${1}" to the front
+    evaluate(*context, "${3}");   // Evicts "${2}"
+    ASSERT_EQ(2, cache().size());
+
+    evaluate(*context, "${1}");
+    ASSERT_EQ(2, cache().hits());
+    evaluate(*context, "${2}");
+    ASSERT_EQ(2, cache().hits());
+    ASSERT_EQ(4, cache().misses());
+
+    cache().setCapacity(0);
+    ASSERT_EQ(0, cache().size());
+    ASSERT_TRUE(IsEqual(2, evaluate(*context, "${2}")));
+    ASSERT_EQ(0, cache().size());
+}
@@ -122,7 +122,7 @@ dumpContext(const ContextPtr& context, int indent)
     for (auto it = context->begin(); it != context->end(); it++) {
         int upstream = context->countUpstream(it->first);
         int downstream = context->countDownstream(it->first);
-        auto result = it->first + " := " + it->second.toDebugString();
+        auto result = it->first.str() + " := " + it->second.toDebugString();
         if (upstream)
             result += "[" + std::to_string(upstream) + " upstream]";
         if (downstream)
@@ -114,6 +114,111 @@ TEST_F(ContextTest, Child)
     EXPECT_FALSE(c2->has("personality"));
 }
 
+TEST_F(ContextTest, ManySymbols)
+{
+    // Large contexts switch from a linear scan to an index; check both sides of the switch
+    auto c2 = Context::create(c);
+    for (int i = 0 ; i < 200 ; i++) {
+        c2->putConstant("key" + std::to_string(i), i);
+        for (int j = 0 ; j <= i ; j++)
+            ASSERT_EQ(j, c2->opt("key" + std::to_string(j)).asInt()) << i << ":" << j;
+        ASSERT_FALSE(c2->has("key" + std::to_string(i + 1)));
+    }
+
+    // Constants are not overwritten
+    c2->putConstant("key10", "other");
+    EXPECT_EQ(10, c2->opt("key10").asInt());
+
+    // Resources are overwritten in place
+    c2->putResource("@key10", "first", Path("first"));
+    c2->putResource("@key10", "second", Path("second"));
+    EXPECT_EQ("second", c2->opt("@key10").asString());
+    EXPECT_EQ("second", c2->provenance("@key10"));
+
+    int count = 0;
+    for (const auto& m : *c2)
+        if (m.first == "@key10")
+            count++;
+    EXPECT_EQ(1, count);
+}
+
+TEST_F(ContextTest, RefSurvivesInsert)
+{
+    auto c2 = Context::create(c);
+    c2->putConstant("first", "value");
+
+    auto ref = c2->find("first");
+    ASSERT_FALSE(ref.empty());
+    const auto *object = &ref.object();
+
+    // Adding symbols grows the storage and builds the index; the reference is not moved
+    for (int i = 0 ; i < 200 ; i++)
+        c2->putConstant("key" + std::to_string(i), i);
+
+    ASSERT_EQ(object, &c2->find("first").object());
+    EXPECT_EQ("value", ref.object().value().asString());
+    EXPECT_EQ(c2, ref.context());
+}
+
+TEST_F(ContextTest, ReferenceSurvivesGrowth)
+{
+    auto c2 = Context::create(c);
+    c2->putConstant("first", 1);
+    auto ref = c2->find("first");
+    ASSERT_FALSE(ref.empty());
+
+    // Adding symbols moves entries past the inline capacity and builds an index
+    for (int i = 0 ; i < 100 ; i++)
+        c2->putConstant("key" + std::to_string(i), i);
+    ASSERT_EQ(1, ref.object().value().asInt());
+    ASSERT_EQ(c2, ref.context());
+}
+
+TEST(ContextMapTest, Footprint)
+{
+    // A few symbols are stored inside the map itself
+    ContextMap map;
+    for (size_t i = 0 ; i < ContextMap::INLINE_CAPACITY ; i++)
+        ASSERT_TRUE(map.emplace("key" + std::to_string(i), ContextObject(Object((int)i))));
+    ASSERT_EQ(ContextMap::INLINE_CAPACITY, map.size());
+    ASSERT_EQ(0, map.heapBytes());
+
+    // Smaller than the first 512 byte block that a std::deque of entries allocates
+    ASSERT_LT(sizeof(ContextMap), 512);
+
+    map.emplace("extra", ContextObject(Object(10)));
+    ASSERT_LT(0, map.heapBytes());
+    ASSERT_EQ(10, map.find("extra")->value().asInt());
+    ASSERT_EQ(2, map.find("key2")->value().asInt());
+}
+
+TEST_F(ContextTest, Writeable)
+{
+    auto c2 = Context::create(c);
+    auto c3 = Context::create(c2);
+
+    c2->putUserWriteable("user", 1);
+    c2->putSystemWriteable("system", 2);
+    c2->putConstant("constant", 3);
+
+    EXPECT_TRUE(c3->isMutable("user"));
+    EXPECT_TRUE(c3->isMutable("system"));
+    EXPECT_FALSE(c3->isMutable("constant"));
+    EXPECT_TRUE(c3->hasImmutable("constant"));
+    EXPECT_EQ(c2, c3->findContextContaining("user"));
+
+    // User updates search up the context chain; system updates only look in the current context
+    EXPECT_TRUE(c3->userUpdateAndRecalculate("user", 10, false));
+    EXPECT_EQ(10, c3->opt("user").asInt());
+    EXPECT_FALSE(c3->systemUpdateAndRecalculate("system", 20, false));
+    EXPECT_TRUE(c2->systemUpdateAndRecalculate("system", 20, false));
+    EXPECT_EQ(20, c3->opt("system").asInt());
+
+    // Constants can't be changed
+    EXPECT_TRUE(c3->userUpdateAndRecalculate("constant", 30, false));
+    EXPECT_EQ(3, c3->opt("constant").asInt());
+}
+
 TEST_F(ContextTest, Shape)
 {
     for (auto m : std::map<ScreenShape , std::string>{
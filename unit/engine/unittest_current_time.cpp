@@ -14,6 +14,7 @@
  */
 
 #include "../testeventloop.h"
+#include "apl/engine/componentdependant.h"
 
 using namespace apl;
 
@@ -560,3 +561,128 @@ TEST_F(CurrentTimeTest, Format)
         ASSERT_TRUE(IsEqual(TIME_FORMAT_ANSWERS.at(i), text->getCalculated(kPropertyText).asString())) << i;
     }
 }
+
+static const char *TIME_GRANULARITY = R"apl({
+  "type": "APL",
+  "version": "1.4",
+  "mainTemplate": {
+    "items": {
+      "type": "Text",
+      "bind": [
+        { "name": "frame", "value": "${localTime}" },
+        { "name": "second", "value": "${localTime}", "granularity": "second" },
+        { "name": "minute", "value": "${localTime}", "granularity": "minute" }
+      ],
+      "text": "${frame} ${second} ${minute}"
+    }
+  }
+})apl";
+
+TEST_F(CurrentTimeTest, Granularity)
+{
+    // Thu Sep 05 2019 12:15:00  (UTCTime)
+    const apl_time_t START_TIME = 1567685700000;
+    config.utcTime(START_TIME);
+
+    loadDocument(TIME_GRANULARITY);
+    ASSERT_TRUE(component);
+    ASSERT_TRUE(IsEqual("1567685700000 1567685700000 1567685700000",
+                        component->getCalculated(kPropertyText).asString()));
+
+    // Within the same second only the per-frame binding is recalculated
+    root->updateTime(16);
+    ASSERT_TRUE(IsEqual("1567685700016 1567685700000 1567685700000",
+                        component->getCalculated(kPropertyText).asString()));
+
+    root->updateTime(1016);
+    ASSERT_TRUE(IsEqual("1567685701016 1567685701016 1567685700000",
+                        component->getCalculated(kPropertyText).asString()));
+
+    root->updateTime(59999);
+    ASSERT_TRUE(IsEqual("1567685759999 1567685759999 1567685700000",
+                        component->getCalculated(kPropertyText).asString()));
+
+    root->updateTime(60000);
+    ASSERT_TRUE(IsEqual("1567685760000 1567685760000 1567685760000",
+                        component->getCalculated(kPropertyText).asString()));
+
+    // Moving the local time backwards also crosses a boundary
+    root->updateTime(60001, START_TIME);
+    ASSERT_TRUE(IsEqual("1567685700000 1567685700000 1567685700000",
+                        component->getCalculated(kPropertyText).asString()));
+}
+
+static const char *TIME_CLOCK = R"apl({
+  "type": "APL",
+  "version": "1.4",
+  "mainTemplate": {
+    "items": {
+      "type": "Text",
+      "bind": {
+        "name": "clock",
+        "value": "${Time.format('HH:mm', localTime)}",
+        "granularity": "minute"
+      },
+      "text": "${clock}"
+    }
+  }
+})apl";
+
+TEST_F(CurrentTimeTest, GranularityClock)
+{
+    // Thu Sep 05 2019 12:15:39  (UTCTime)
+    config.utcTime(1567685739476);
+
+    loadDocument(TIME_CLOCK);
+    ASSERT_TRUE(component);
+    ASSERT_TRUE(IsEqual("12:15", component->getCalculated(kPropertyText).asString()));
+
+    // A minute of frames at 60 Hz.  The text only changes once.
+    root->clearDirty();
+    int changes = 0;
+    for (int frame = 1 ; frame <= 3600 ; frame++) {
+        root->updateTime(frame * 1000.0 / 60);
+        if (!root->getDirty().empty()) {
+            changes++;
+            root->clearDirty();
+        }
+    }
+
+    ASSERT_EQ(1, changes);
+    ASSERT_TRUE(IsEqual("12:16", component->getCalculated(kPropertyText).asString()));
+}
+
+static const char *TIME_TEXT = R"apl({
+  "type": "APL",
+  "version": "1.4",
+  "mainTemplate": {
+    "items": {
+      "type": "Text",
+      "text": "Start"
+    }
+  }
+})apl";
+
+/**
+ * Component property dependants honor the granularity of a time symbol the same way as bindings
+ */
+TEST_F(CurrentTimeTest, GranularityComponentDependant)
+{
+    // Thu Sep 05 2019 12:15:00  (UTCTime)
+    config.utcTime(1567685700000);
+
+    loadDocument(TIME_TEXT);
+    ASSERT_TRUE(component);
+
+    auto context = component->getContext();
+    ComponentDependant::create(std::static_pointer_cast<CoreComponent>(component), kPropertyText,
+                               parseDataBinding(*context, "${localTime}"), context,
+                               sBindingFunctions.at(kBindingTypeString), kTimeGranularitySecond);
+    ASSERT_EQ(0, root->context().countDownstream(LOCAL_TIME));
+
+    root->updateTime(16);
+    ASSERT_TRUE(IsEqual("Start", component->getCalculated(kPropertyText).asString()));
+
+    root->updateTime(1016);
+    ASSERT_TRUE(IsEqual("1567685701016", component->getCalculated(kPropertyText).asString()));
+}
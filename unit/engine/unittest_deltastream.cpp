@@ -0,0 +1,193 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+#include "../testeventloop.h"
+
+#include "apl/engine/deltastream.h"
+
+using namespace apl;
+
+class DeltaStreamTest : public DocumentWrapper {};
+
+static const char *FRAMES = R"apl({
+  "type": "APL",
+  "version": "1.4",
+  "mainTemplate": {
+    "parameters": [ "payload" ],
+    "items": {
+      "type": "Container",
+      "data": "${payload}",
+      "items": {
+        "type": "Frame",
+        "id": "frame${index}",
+        "items": {
+          "type": "Text",
+          "id": "text${index}",
+          "text": "Item ${data}"
+        }
+      }
+    }
+  }
+})apl";
+
+static std::string
+makeData(int count)
+{
+    std::string data = "[";
+    for (int i = 0 ; i < count ; i++)
+        data += (i ? "," : "") + std::to_string(i);
+    return data + "]";
+}
+
+TEST_F(DeltaStreamTest, RoundTrip)
+{
+    loadDocument(FRAMES, makeData(3).c_str());
+    root->clearDirty();
+
+    auto frame = component->getCoreChildAt(1);
+    auto text = frame->getCoreChildAt(0);
+    frame->setProperty(kPropertyBackgroundColor, "red");
+    frame->setProperty(kPropertyBorderColor, "blue");
+    frame->setProperty(kPropertyOpacity, 0.5);
+    text->setProperty(kPropertyText, "Changed");   // Styled text is sent as JSON
+    root->clearPending();
+
+    auto dirty = root->getDirty();
+    ASSERT_EQ(2, dirty.size());
+
+    std::vector<uint8_t> buffer(1024);
+    DeltaEncoder encoder(buffer.data(), buffer.size());
+    ASSERT_TRUE(encoder.add(dirty));
+    ASSERT_FALSE(encoder.overflow());
+
+    DeltaDecoder decoder(buffer.data(), encoder.size());
+    ASSERT_EQ(DeltaEncoder::VERSION, decoder.version());
+
+    DeltaRecord record;
+    int records = 0;
+    while (decoder.next(record)) {
+        records++;
+        auto c = root->findComponentById(record.uid);
+        ASSERT_TRUE(c);
+        ASSERT_EQ(c->getDirty().size(), record.properties.size());
+
+        for (const auto& m : record.properties) {
+            ASSERT_EQ(1, c->getDirty().count(m.first));
+            const auto& expected = c->getCalculated(m.first);
+            if (expected.isStyledText()) {
+                // Compare the serialized form of values that are sent as JSON
+                rapidjson::Document doc;
+                ASSERT_TRUE(expected.serializeDirty(doc.GetAllocator()) == m.second.serialize(doc.GetAllocator()));
+            }
+            else {
+                ASSERT_EQ(expected, m.second) << sComponentPropertyBimap.at(m.first);
+            }
+        }
+    }
+
+    ASSERT_FALSE(decoder.error());
+    ASSERT_EQ(2, records);
+
+    // The dirty properties are left for the view host to clear
+    ASSERT_EQ(2, root->getDirty().size());
+    root->clearDirty();
+}
+
+TEST_F(DeltaStreamTest, Overflow)
+{
+    loadDocument(FRAMES, makeData(3).c_str());
+    root->clearDirty();
+
+    auto text = component->getCoreChildAt(0)->getCoreChildAt(0);
+    text->setProperty(kPropertyText, "A longer string that will not fit into a tiny buffer");
+
+    std::vector<uint8_t> buffer(16, 0xEE);
+    DeltaEncoder encoder(buffer.data(), 8);
+    ASSERT_FALSE(encoder.add(root->getDirty()));
+    ASSERT_TRUE(encoder.overflow());
+    ASSERT_LT(8, encoder.size());
+
+    // Nothing was written past the capacity
+    for (size_t i = 8 ; i < buffer.size() ; i++)
+        ASSERT_EQ(0xEE, buffer[i]);
+
+    // Retry with a buffer of the reported size
+    buffer.resize(encoder.size());
+    DeltaEncoder retry(buffer.data(), buffer.size());
+    ASSERT_TRUE(retry.add(root->getDirty()));
+    ASSERT_EQ(buffer.size(), retry.size());
+
+    DeltaDecoder decoder(buffer.data(), retry.size());
+    DeltaRecord record;
+    ASSERT_TRUE(decoder.next(record));
+    ASSERT_EQ(text->getUniqueId(), record.uid);
+    auto it = std::find_if(record.properties.begin(), record.properties.end(),
+                           [](const std::pair<PropertyKey, Object>& p) { return p.first == kPropertyText; });
+    ASSERT_NE(record.properties.end(), it);
+    ASSERT_TRUE(IsEqual("A longer string that will not fit into a tiny buffer", it->second.get("text").asString()));
+    ASSERT_FALSE(decoder.next(record));
+    ASSERT_FALSE(decoder.error());
+
+    // A truncated stream is reported as an error
+    DeltaDecoder truncated(buffer.data(), buffer.size() - 3);
+    ASSERT_FALSE(truncated.next(record));
+    ASSERT_TRUE(truncated.error());
+}
+
+TEST_F(DeltaStreamTest, BadHeader)
+{
+    std::vector<uint8_t> buffer = {'A', 'P', 'L', 'D', 99, 0, 0, 0};
+    DeltaDecoder decoder(buffer.data(), buffer.size());
+    ASSERT_TRUE(decoder.error());
+    ASSERT_EQ(0, decoder.version());
+
+    DeltaRecord record;
+    ASSERT_FALSE(decoder.next(record));
+    ASSERT_TRUE(LogMessage());
+}
+
+/**
+ * The binary stream of a frame of dirty properties is smaller than the JSON from serializeDirty.
+ */
+TEST_F(DeltaStreamTest, SmallerThanJson)
+{
+    const int COUNT = 500;
+    loadDocument(FRAMES, makeData(COUNT).c_str());
+
+    root->clearDirty();
+    for (int i = 0 ; i < COUNT ; i++) {
+        auto frame = component->getCoreChildAt(i);
+        frame->setProperty(kPropertyOpacity, 0.5);
+        frame->setProperty(kPropertyBorderColor, "blue");
+        frame->getCoreChildAt(0)->setProperty(kPropertyText, "Changed");
+    }
+    root->clearPending();
+
+    rapidjson::Document doc(rapidjson::kArrayType);
+    for (auto& c : root->getDirty())
+        doc.PushBack(c->serializeDirty(doc.GetAllocator()), doc.GetAllocator());
+    rapidjson::StringBuffer json;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(json);
+    doc.Accept(writer);
+
+    std::vector<uint8_t> buffer(64 * 1024);
+    DeltaEncoder encoder(buffer.data(), buffer.size());
+    ASSERT_TRUE(encoder.add(root->getDirty()));
+    ASSERT_EQ(COUNT * 2, root->getDirty().size());
+    ASSERT_LT(encoder.size(), json.GetSize());
+}
@@ -15,6 +15,10 @@
 
 #include "../testeventloop.h"
 #include "apl/engine/contextdependant.h"
+#include "apl/engine/evaluate.h"
+#include "apl/engine/recalculatebatch.h"
+#include "apl/livedata/livearray.h"
+#include "apl/primitives/symbolreferencemap.h"
 #include <apl/component/touchwrappercomponent.h>
 
 using namespace apl;
@@ -810,3 +814,220 @@ TEST_F(DependantTest, ResourceLookup)
     ASSERT_TRUE(IsEqual("Monday", text->getCalculated(kPropertyText).asString()));
 
 }
+
+/**
+ * A dependant that counts how many times it has been recalculated.
+ */
+class CountingDependant : public Dependant {
+public:
+    static std::shared_ptr<CountingDependant> create(const ContextPtr& context, const std::string& expression) {
+        auto equation = parseDataBinding(*context, expression);
+        SymbolReferenceMap symbols;
+        equation.symbols(symbols);
+
+        auto dependant = std::make_shared<CountingDependant>(equation, context);
+        dependant->assignRank(symbols);
+        for (const auto& symbol : symbols.get())
+            symbol.second->addDownstream(symbol.first, dependant);
+        return dependant;
+    }
+
+    CountingDependant(const Object& equation, const ContextPtr& context)
+        : Dependant(equation, context, sBindingFunctions.at(kBindingTypeAny))
+    {}
+
+    void recalculate(bool useDirtyFlag) const override {
+        auto context = mBindingContext.lock();
+        if (context) {
+            value = calculate(*context);
+            count++;
+        }
+    }
+
+    mutable Object value;
+    mutable int count = 0;
+};
+
+static const char *DIAMOND = R"apl(
+    {
+      "type": "APL",
+      "version": "1.4",
+      "mainTemplate": {
+        "items": {
+          "type": "Frame",
+          "bind": [
+            { "name": "a", "value": 1 },
+            { "name": "b", "value": "${a + 1}" },
+            { "name": "c", "value": "${a * 2}" },
+            { "name": "d", "value": 100 }
+          ]
+        }
+      }
+    }
+)apl";
+
+/**
+ * A dependant reached along two paths of the binding graph is recalculated once
+ */
+TEST_F(DependantTest, Diamond)
+{
+    loadDocument(DIAMOND);
+    ASSERT_TRUE(component);
+
+    auto context = component->getContext();
+    auto counter = CountingDependant::create(context, "${b + c}");
+    ASSERT_EQ(1, counter->rank());
+
+    ASSERT_TRUE(context->userUpdateAndRecalculate("a", 5, false));
+    ASSERT_EQ(1, counter->count);
+    ASSERT_TRUE(IsEqual(16, counter->value));
+
+    ASSERT_TRUE(context->userUpdateAndRecalculate("a", 10, false));
+    ASSERT_EQ(2, counter->count);
+    ASSERT_TRUE(IsEqual(31, counter->value));
+
+    counter->removeFromSource();
+}
+
+/**
+ * Changes made inside a batch are recalculated once when the batch ends
+ */
+TEST_F(DependantTest, Batch)
+{
+    loadDocument(DIAMOND);
+    ASSERT_TRUE(component);
+
+    auto context = component->getContext();
+    auto counter = CountingDependant::create(context, "${b + c + d}");
+
+    {
+        RecalculateBatch batch;
+        ASSERT_TRUE(context->userUpdateAndRecalculate("a", 2, false));
+        ASSERT_TRUE(context->userUpdateAndRecalculate("d", 200, false));
+
+        {
+            RecalculateBatch nested;
+            ASSERT_TRUE(context->userUpdateAndRecalculate("d", 300, false));
+        }
+
+        // Nothing is recalculated until the outer batch ends
+        ASSERT_EQ(0, counter->count);
+        ASSERT_TRUE(IsEqual(2, context->opt("b")));
+    }
+
+    ASSERT_EQ(1, counter->count);
+    ASSERT_TRUE(IsEqual(3 + 4 + 300, counter->value));
+    ASSERT_TRUE(IsEqual(3, context->opt("b")));
+
+    counter->removeFromSource();
+}
+
+/**
+ * A symbol that gains an upstream dependant after it is read raises the rank of its readers
+ */
+TEST_F(DependantTest, RaiseRank)
+{
+    context = Context::create(metrics, makeDefaultSession());
+    auto source = Context::create(context);
+    source->putUserWriteable("a", 1);
+    source->putUserWriteable("k", 0);
+
+    auto counter = CountingDependant::create(source, "${a + k}");
+    ASSERT_EQ(0, counter->rank());
+
+    ContextDependant::create(source, "k", parseDataBinding(*source, "${a * 10}"), source,
+                             sBindingFunctions.at(kBindingTypeAny));
+    ASSERT_EQ(1, counter->rank());
+
+    // The reader recalculates once, after "k" has been updated
+    ASSERT_TRUE(source->userUpdateAndRecalculate("a", 2, false));
+    ASSERT_EQ(1, counter->count);
+    ASSERT_TRUE(IsEqual(22, counter->value));
+
+    counter->removeFromSource();
+}
+
+/**
+ * Dependants can be removed from the middle of a downstream registry, destroyed without
+ * being removed, or outlive the source they are registered with.
+ */
+TEST_F(DependantTest, DownstreamRegistry)
+{
+    context = Context::create(metrics, makeDefaultSession());
+    auto source = Context::create(context);
+    source->putUserWriteable("a", 1);
+    source->putUserWriteable("b", 2);
+
+    std::vector<std::shared_ptr<CountingDependant>> counters;
+    for (int i = 0 ; i < 5 ; i++)
+        counters.emplace_back(CountingDependant::create(source, "${a + b}"));
+
+    ASSERT_EQ(5, source->countDownstream("a"));
+    ASSERT_EQ(5, source->countDownstream("b"));
+    ASSERT_EQ(10, source->countDownstream());
+
+    // Adding the same dependant again is ignored
+    source->addDownstream("a", counters[0]);
+    ASSERT_EQ(5, source->countDownstream("a"));
+
+    counters[1]->removeFromSource();
+    counters[4] = nullptr;
+    ASSERT_EQ(3, source->countDownstream("a"));
+    ASSERT_EQ(6, source->countDownstream());
+
+    ASSERT_TRUE(source->userUpdateAndRecalculate("a", 10, false));
+    ASSERT_EQ(1, counters[0]->count);
+    ASSERT_EQ(0, counters[1]->count);
+    ASSERT_EQ(1, counters[2]->count);
+    ASSERT_EQ(1, counters[3]->count);
+    ASSERT_TRUE(IsEqual(12, counters[3]->value));
+
+    // Release the source first.  The remaining dependants are disconnected from it.
+    source = nullptr;
+    counters[0]->removeFromSource();
+    counters.clear();
+}
+
+static const char *MANY_DEPENDANTS = R"apl(
+    {
+      "type": "APL",
+      "version": "1.4",
+      "mainTemplate": {
+        "items": {
+          "type": "Container",
+          "bind": [ { "name": "a", "value": "A" } ],
+          "data": "${TestArray}",
+          "items": {
+            "type": "Text",
+            "text": "${a} ${data}"
+          }
+        }
+      }
+    }
+)apl";
+
+/**
+ * Releasing a large number of components removes each of their dependants from the shared
+ * upstream context without searching the other dependants.
+ */
+TEST_F(DependantTest, ReleaseManyComponents)
+{
+    const int COUNT = 10000;
+
+    auto myArray = LiveArray::create();
+    for (int i = 0 ; i < COUNT ; i++)
+        myArray->push_back(i);
+    config.liveData("TestArray", myArray);
+
+    loadDocument(MANY_DEPENDANTS);
+    ASSERT_EQ(COUNT, component->getChildCount());
+    ASSERT_EQ(COUNT, component->getContext()->countDownstream("a"));
+
+    myArray->clear();
+    root->clearPending();
+
+    ASSERT_EQ(0, component->getChildCount());
+    ASSERT_EQ(0, component->getContext()->countDownstream("a"));
+
+    ASSERT_TRUE(component->getContext()->userUpdateAndRecalculate("a", "B", false));
+}
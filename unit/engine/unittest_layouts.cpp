@@ -15,6 +15,7 @@
 
 #include "gtest/gtest.h"
 
+#include "apl/engine/componenttemplate.h"
 #include "apl/engine/evaluate.h"
 
 #include "../testeventloop.h"
@@ -526,3 +527,59 @@ TEST_F(LayoutTest, TypedLayoutParameter)
     ASSERT_EQ("100dp", text->getCalculated(kPropertyText).asString());
     ASSERT_EQ(Rect(0, 0, 200, 200), text->getCalculated(kPropertyBounds).getRect());
 }
+
+static const char *SHARED_TEMPLATE =
+    "{"
+    "  \"type\": \"APL\","
+    "  \"version\": \"1.0\","
+    "  \"layouts\": {"
+    "    \"Row\": {"
+    "      \"parameters\": ["
+    "        \"label\""
+    "      ],"
+    "      \"item\": {"
+    "        \"type\": \"${label == 'image' ? 'Image' : 'Text'}\","
+    "        \"when\": \"${label != 'skip'}\","
+    "        \"bind\": {"
+    "          \"name\": \"upper\","
+    "          \"value\": \"${String.toUpperCase(label)}\""
+    "        },"
+    "        \"text\": \"${upper}-${index}\""
+    "      }"
+    "    }"
+    "  },"
+    "  \"mainTemplate\": {"
+    "    \"items\": {"
+    "      \"type\": \"Sequence\","
+    "      \"data\": [\"a\", \"image\", \"skip\", \"b\"],"
+    "      \"items\": {"
+    "        \"type\": \"Row\","
+    "        \"label\": \"${data}\""
+    "      }"
+    "    }"
+    "  }"
+    "}";
+
+/**
+ * Each named layout is compiled once and shared by every instance.  The data-bound parts of
+ * the layout (type, when, bind) are still evaluated for each instance.
+ */
+TEST_F(LayoutTest, SharedTemplate)
+{
+    loadDocument(SHARED_TEMPLATE);
+    ASSERT_EQ(kComponentTypeSequence, component->getType());
+    ASSERT_EQ(3, component->getChildCount());
+
+    ASSERT_EQ(kComponentTypeText, component->getCoreChildAt(0)->getType());
+    ASSERT_EQ("A-0", component->getCoreChildAt(0)->getCalculated(kPropertyText).asString());
+    ASSERT_EQ(kComponentTypeImage, component->getCoreChildAt(1)->getType());
+    ASSERT_EQ(kComponentTypeText, component->getCoreChildAt(2)->getType());
+    ASSERT_EQ("B-2", component->getCoreChildAt(2)->getCalculated(kPropertyText).asString());
+
+    auto layout = context->getLayoutTemplate("Row");
+    ASSERT_TRUE(layout);
+    ASSERT_EQ(layout, context->getLayoutTemplate("Row"));
+    ASSERT_EQ(1, layout->parameters().size());
+    ASSERT_TRUE(layout->items().isStatic());
+    ASSERT_FALSE(context->getLayoutTemplate("Missing"));
+}
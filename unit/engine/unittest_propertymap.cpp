@@ -0,0 +1,193 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "../testeventloop.h"
+
+#include "apl/engine/propertymap.h"
+
+using namespace apl;
+
+TEST(PropertyKeySetTest, Basic)
+{
+    PropertySet set;
+    ASSERT_TRUE(set.empty());
+    ASSERT_EQ(0, set.size());
+    ASSERT_EQ(set.begin(), set.end());
+
+    ASSERT_TRUE(set.emplace(kPropertyWrap));
+    ASSERT_TRUE(set.emplace(kPropertyScrollDirection));
+    ASSERT_TRUE(set.emplace(kPropertyHeight));
+    ASSERT_FALSE(set.emplace(kPropertyHeight));
+
+    ASSERT_FALSE(set.empty());
+    ASSERT_EQ(3, set.size());
+    ASSERT_EQ(1, set.count(kPropertyHeight));
+    ASSERT_EQ(0, set.count(kPropertyWidth));
+
+    std::vector<PropertyKey> keys(set.begin(), set.end());
+    std::vector<PropertyKey> expected = {kPropertyScrollDirection, kPropertyHeight, kPropertyWrap};
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(expected, keys);
+
+    ASSERT_EQ(1, set.erase(kPropertyHeight));
+    ASSERT_EQ(0, set.erase(kPropertyHeight));
+    ASSERT_EQ(2, set.size());
+
+    set.clear();
+    ASSERT_TRUE(set.empty());
+}
+
+TEST(PropertyKeySetTest, WordBoundaries)
+{
+    PropertyKeySet<int> set;
+    for (int key : {0, 63, 64, 127, 128, 255})
+        ASSERT_TRUE(set.emplace(key));
+
+    ASSERT_EQ(std::vector<int>({0, 63, 64, 127, 128, 255}), std::vector<int>(set.begin(), set.end()));
+    ASSERT_EQ(0, set.rank(0));
+    ASSERT_EQ(1, set.rank(63));
+    ASSERT_EQ(2, set.rank(64));
+    ASSERT_EQ(3, set.rank(100));
+    ASSERT_EQ(5, set.rank(255));
+}
+
+TEST(PropertyMapTest, Basic)
+{
+    CalculatedPropertyMap map;
+    ASSERT_EQ(0, map.size());
+    ASSERT_TRUE(map.get(kPropertyWidth).isNull());
+
+    map.set(kPropertyWrap, Object("wrap"));
+    map.set(kPropertyScrollDirection, Object(1));
+    map.set(kPropertyWidth, Object(100));
+    map.set(kPropertyWidth, Object(200));
+
+    ASSERT_EQ(3, map.size());
+    ASSERT_EQ(Object(200), map.get(kPropertyWidth));
+    ASSERT_EQ(Object(200), map.get("width"));
+    ASSERT_EQ(Object("wrap"), map[kPropertyWrap]);
+    ASSERT_TRUE(map.get(kPropertyHeight).isNull());
+    ASSERT_TRUE(map.get("notAProperty").isNull());
+
+    // Iteration is in key order
+    std::vector<PropertyKey> keys;
+    for (const auto& m : map)
+        keys.emplace_back(m.first);
+    ASSERT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+    ASSERT_EQ(3, keys.size());
+
+    // Setting a value from the map itself
+    map.set(kPropertyHeight, map.get(kPropertyWrap));
+    ASSERT_EQ(Object("wrap"), map.get(kPropertyHeight));
+    ASSERT_EQ(Object(200), map.get(kPropertyWidth));
+}
+
+TEST(PropertyMapTest, StableReferences)
+{
+    CalculatedPropertyMap map;
+    const auto& view = map;
+    map.set(kPropertyWidth, Object(100));
+    const auto& width = view.get(kPropertyWidth);
+
+    // Adding many smaller and larger keys does not move the existing entries
+    for (int key = 0 ; key < kPropertyWidth + 40 ; key++)
+        if (key != kPropertyWidth)
+            map.set(static_cast<PropertyKey>(key), Object(key));
+    ASSERT_EQ(&width, &view.get(kPropertyWidth));
+    ASSERT_EQ(Object(100), width);
+
+    map.set(kPropertyWidth, Object(300));
+    ASSERT_EQ(Object(300), width);
+
+    // The iterator returns references into the map
+    int count = 0;
+    for (auto& kv : map) {
+        ASSERT_EQ(&kv.second, &view.get(kv.first));
+        count++;
+    }
+    ASSERT_EQ(map.size(), count);
+
+    // A copy holds the same values in its own entries
+    CalculatedPropertyMap copy;
+    copy = map;
+    const auto& copyView = copy;
+    ASSERT_EQ(map.size(), copy.size());
+    ASSERT_EQ(Object(300), copyView.get(kPropertyWidth));
+    ASSERT_NE(&width, &copyView.get(kPropertyWidth));
+}
+
+class PropertyMapDocumentTest : public DocumentWrapper {};
+
+static const char *FRAMES = R"apl({
+  "type": "APL",
+  "version": "1.4",
+  "mainTemplate": {
+    "parameters": [ "payload" ],
+    "items": {
+      "type": "Container",
+      "data": "${payload}",
+      "items": {
+        "type": "Frame",
+        "borderWidth": "${data}",
+        "items": {
+          "type": "Text",
+          "text": "${data}"
+        }
+      }
+    }
+  }
+})apl";
+
+/**
+ * Read calculated properties and serialize dirty properties across many components.
+ */
+TEST_F(PropertyMapDocumentTest, CalculatedAccess)
+{
+    const int COUNT = 200;
+    std::string data = "[";
+    for (int i = 0 ; i < COUNT ; i++)
+        data += (i ? "," : "") + std::to_string(i);
+    data += "]";
+
+    loadDocument(FRAMES, data.c_str());
+    ASSERT_EQ(COUNT, component->getChildCount());
+
+    const std::vector<PropertyKey> keys = {kPropertyBounds, kPropertyOpacity, kPropertyBorderWidth,
+                                           kPropertyBackgroundColor, kPropertyDisplay, kPropertyText};
+
+    int sum = 0;
+    for (size_t i = 0 ; i < component->getChildCount() ; i++) {
+        auto frame = component->getChildAt(i);
+        for (auto key : keys)
+            sum += frame->getCalculated(key).isNull() ? 0 : 1;
+    }
+    ASSERT_EQ(COUNT * 5, sum);   // Frames do not have text
+
+    root->clearDirty();
+    for (size_t i = 0 ; i < component->getChildCount() ; i++) {
+        auto frame = component->getCoreChildAt(i);
+        frame->setProperty(kPropertyBackgroundColor, "red");
+        frame->setProperty(kPropertyBorderColor, "blue");
+    }
+
+    rapidjson::Document doc;
+    for (size_t i = 0 ; i < component->getChildCount() ; i++) {
+        auto frame = component->getChildAt(i);
+        ASSERT_EQ(2, frame->getDirty().size());
+        auto value = frame->serializeDirty(doc.GetAllocator());
+        ASSERT_TRUE(value.HasMember("backgroundColor"));
+        ASSERT_TRUE(value.HasMember("borderColor"));
+    }
+}
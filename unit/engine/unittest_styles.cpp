@@ -484,3 +484,83 @@ TEST_F(StylesTest, ComponentStyling)
     ASSERT_EQ(kVectorGraphicAlignBottom, vectorGraphic->getCalculated(kPropertyAlign).asInt());
     ASSERT_EQ(kVectorGraphicScaleBestFill, vectorGraphic->getCalculated(kPropertyScale).asInt());
 }
+
+static const char *STATE_DELTA = R"apl({
+  "type": "APL",
+  "version": "1.4",
+  "resources": [
+    {
+      "colors": {
+        "accent": "blue"
+      }
+    }
+  ],
+  "styles": {
+    "frameStyle": {
+      "values": [
+        {
+          "backgroundColor": "red",
+          "borderWidth": 2,
+          "borderColor": "@accent",
+          "opacity": 1
+        },
+        {
+          "when": "${state.pressed}",
+          "backgroundColor": "@accent",
+          "borderWidth": 2
+        },
+        {
+          "when": "${state.disabled}",
+          "opacity": 0.5
+        },
+        {
+          "when": false,
+          "borderWidth": 10
+        }
+      ]
+    }
+  },
+  "mainTemplate": {
+    "items": {
+      "type": "Frame",
+      "style": "frameStyle"
+    }
+  }
+})apl";
+
+TEST_F(StylesTest, StateDelta)
+{
+    loadDocument(STATE_DELTA);
+    ASSERT_TRUE(component);
+
+    ASSERT_TRUE(IsEqual(Color(session, "red"), component->getCalculated(kPropertyBackgroundColor)));
+    ASSERT_TRUE(IsEqual(Color(session, "blue"), component->getCalculated(kPropertyBorderColor)));
+    ASSERT_TRUE(IsEqual(2, component->getCalculated(kPropertyBorderWidth).asDimension(*context).getValue()));
+
+    // Only the background color differs between the normal and pressed styles
+    State normal;
+    State pressed;
+    pressed.set(kStatePressed, true);
+    auto normalStyle = context->getStyle("frameStyle", normal);
+    auto pressedStyle = context->getStyle("frameStyle", pressed);
+    ASSERT_EQ(std::vector<Atom>{Atom("backgroundColor")}, pressedStyle->changedFrom(normalStyle));
+    ASSERT_EQ(std::vector<Atom>{Atom("backgroundColor")}, normalStyle->changedFrom(pressedStyle));
+    ASSERT_EQ(&pressedStyle->changedFrom(normalStyle), &pressedStyle->changedFrom(normalStyle));
+    ASSERT_EQ("_main/styles/frameStyle/values/1/backgroundColor", pressedStyle->provenance("backgroundColor"));
+
+    component->setState(kStatePressed, true);
+    ASSERT_TRUE(CheckDirty(component, kPropertyBackgroundColor));
+    ASSERT_TRUE(IsEqual(Color(session, "blue"), component->getCalculated(kPropertyBackgroundColor)));
+
+    component->setState(kStatePressed, false);
+    ASSERT_TRUE(CheckDirty(component, kPropertyBackgroundColor));
+    ASSERT_TRUE(IsEqual(Color(session, "red"), component->getCalculated(kPropertyBackgroundColor)));
+
+    // A state that changes nothing else leaves the component clean
+    component->setState(kStateFocused, true);
+    ASSERT_TRUE(CheckDirty(component));
+
+    component->setProperty(kPropertyDisabled, true);
+    ASSERT_TRUE(CheckDirty(component, kPropertyDisabled, kPropertyOpacity));
+    ASSERT_TRUE(IsEqual(0.5, component->getCalculated(kPropertyOpacity)));
+}
@@ -386,3 +386,76 @@ TEST_F(LiveArrayChangeTest, CombinedIteratorChanges)
     }));
     root->clearPending();
 }
+
+/**
+ * Apply a large number of mixed changes between flushes and compare the index translation
+ * against a simple model of the array.
+ */
+TEST_F(LiveArrayChangeTest, ManyChanges)
+{
+    const int LENGTH = 10000;
+    const int CHANGES = 1000;
+    const int FLUSHES = 3;
+
+    auto myArray = LiveArray::create();
+    for (int i = 0 ; i < LENGTH ; i++)
+        myArray->push_back(i);
+    config.liveData("TestArray", myArray);
+
+    loadDocument(ARRAY_TEST);
+
+    unsigned int seed = 1234;
+    auto random = [&seed](int range) {
+        seed = seed * 1103515245 + 12345;
+        return static_cast<int>((seed >> 16) % range);
+    };
+
+    for (int flush = 0 ; flush < FLUSHES ; flush++) {
+        // The old index of each item and whether it has been updated
+        std::vector<std::pair<int, bool>> model;
+        for (int i = 0 ; i < myArray->size() ; i++)
+            model.emplace_back(i, false);
+
+        for (int i = 0 ; i < CHANGES ; i++) {
+            auto size = static_cast<int>(myArray->size());
+            switch (random(3)) {
+                case 0: {
+                    auto position = random(size + 1);
+                    myArray->insert(position, -1);
+                    model.emplace(model.begin() + position, -1, false);
+                    break;
+                }
+                case 1: {
+                    auto position = random(size);
+                    auto count = std::min(1 + random(3), size - position);
+                    myArray->remove(position, count);
+                    model.erase(model.begin() + position, model.begin() + position + count);
+                    break;
+                }
+                default: {
+                    auto position = random(size);
+                    myArray->update(position, -2);
+                    if (model[position].first != -1)
+                        model[position].second = true;
+                    break;
+                }
+            }
+        }
+
+        auto tracker = (*context->dataManager().dirty().begin())->asArray();
+        ASSERT_TRUE(tracker);
+        ASSERT_EQ(model.size(), tracker->size());
+
+        std::vector<std::pair<int, bool>> actual;
+        for (size_t i = 0 ; i < model.size() ; i++)
+            actual.emplace_back(tracker->newToOld(i));
+
+        for (size_t i = 0 ; i < model.size() ; i++) {
+            ASSERT_EQ(model[i].first, actual[i].first) << "flush=" << flush << " index=" << i;
+            if (model[i].first != -1)
+                ASSERT_EQ(model[i].second, actual[i].second) << "flush=" << flush << " index=" << i;
+        }
+
+        root->clearPending();
+    }
+}
@@ -1555,4 +1555,97 @@ TEST_F(LiveArrayRebuildTest, SpacedContainer) {
     ASSERT_TRUE(CheckSpacing(component, 10));
 }
 
+/**
+ * The "length" symbol is stored once for all of the children
+ */
+TEST_F(LiveArrayRebuildTest, SharedLength)
+{
+    auto myArray = LiveArray::create(ObjectArray{"A", "B", "C"});
+    config.liveData("TestArray", myArray);
+
+    loadDocument(BASIC_DOC);
+    ASSERT_TRUE(CheckChildOrder({"A 0 0 3", "B 1 1 3", "C 2 2 3"}));
+
+    auto lengthContext = component->getChildAt(0)->getContext()->findContextContaining("length");
+    ASSERT_TRUE(lengthContext);
+    ASSERT_EQ(lengthContext, component->getChildAt(2)->getContext()->findContextContaining("length"));
+    ASSERT_NE(lengthContext, component->getChildAt(0)->getContext()->findContextContaining("dataIndex"));
+
+    myArray->push_back("D");
+    root->clearPending();
+    ASSERT_TRUE(CheckChildOrder({"A 0 0 4", "B 1 1 4", "C 2 2 4", "D 3 3 4"}));
+    ASSERT_EQ(lengthContext, component->getChildAt(3)->getContext()->findContextContaining("length"));
+
+    myArray->remove(0);
+    root->clearPending();
+    ASSERT_TRUE(CheckChildOrder({"B 0 0 3", "C 1 1 3", "D 2 2 3"}));
+}
+
+static const char *NUMBERED_DOC = R"({
+  "type": "APL",
+  "version": "1.4",
+  "mainTemplate": {
+    "item": {
+      "type": "Container",
+      "data": "${TestArray}",
+      "numbered": true,
+      "item": {
+        "type": "Text",
+        "text": "${data} ${index} ${ordinal}",
+        "numbering": "${data == 'R' ? 'reset' : 'normal'}"
+      }
+    }
+  }
+})";
+
+/**
+ * Children in front of the first change are skipped; numbering continues from the last one
+ */
+TEST_F(LiveArrayRebuildTest, SkipUnchangedPrefix)
+{
+    auto myArray = LiveArray::create(ObjectArray{"A", "R", "B", "C"});
+    config.liveData("TestArray", myArray);
+
+    loadDocument(NUMBERED_DOC);
+    ASSERT_TRUE(CheckChildOrder({"A 0 1", "R 1 2", "B 2 1", "C 3 2"}));
+
+    myArray->insert(3, "X");
+    root->clearPending();
+    ASSERT_TRUE(CheckChildOrder({"A 0 1", "R 1 2", "B 2 1", "X 3 2", "C 4 3"}));
+
+    myArray->push_back("D");
+    root->clearPending();
+    ASSERT_TRUE(CheckChildOrder({"A 0 1", "R 1 2", "B 2 1", "X 3 2", "C 4 3", "D 5 4"}));
+
+    myArray->remove(1);
+    root->clearPending();
+    ASSERT_TRUE(CheckChildOrder({"A 0 1", "B 1 2", "X 2 3", "C 3 4", "D 4 5"}));
+}
+
+/**
+ * Appending to a long list only touches the new child
+ */
+TEST_F(LiveArrayRebuildTest, AppendToLongList)
+{
+    const int COUNT = 2000;
+
+    auto myArray = LiveArray::create();
+    for (int i = 0 ; i < COUNT ; i++)
+        myArray->push_back(std::to_string(i));
+    config.liveData("TestArray", myArray);
+
+    loadDocument(NUMBERED_DOC);
+    ASSERT_EQ(COUNT, component->getChildCount());
+    root->clearDirty();
+
+    myArray->push_back("last");
+    root->clearPending();
+
+    ASSERT_EQ(COUNT + 1, component->getChildCount());
+    ASSERT_TRUE(IsEqual("last 2000 2001", component->getChildAt(COUNT)->getCalculated(kPropertyText).asString()));
+
+    for (int i = 0 ; i < COUNT ; i++)
+        ASSERT_FALSE(root->getDirty().count(component->getChildAt(i))) << i;
+}
+
 } // namespace apl
@@ -586,4 +586,58 @@ TEST(ObjectTest, MutableObjects)
 
     array = Object(ObjectArray{2,3,4}, true).getMutableArray();
     ASSERT_EQ(3, array.size());
-}
\ No newline at end of file
+}
+
+TEST(ObjectTest, ChangeType)
+{
+    // Assignment between objects that use different storage
+    std::vector<Object> values = {
+        Object::NULL_OBJECT(), Object(23.5), Object("a string that is too long for inline storage"),
+        Object("short"), Object(Rect(1, 2, 3, 4)), Object(Radii(5)), Object(Transform2D::scale(2)),
+        Object(Color(Color::RED)), Object(Dimension(DimensionType::Relative, 50)), Object::EMPTY_ARRAY(),
+        Object(ObjectArray{1, 2, 3})
+    };
+
+    for (const auto& from : values) {
+        for (const auto& to : values) {
+            Object a = from;
+            a = to;
+            ASSERT_EQ(to, a);
+
+            Object b = from;
+            Object c = to;
+            b = std::move(c);
+            ASSERT_EQ(to, b);
+        }
+    }
+
+    // Assigning an object that is owned by the target
+    Object array(ObjectArray{Object("first element"), 2, 3});
+    array = array.at(0);
+    ASSERT_EQ(Object("first element"), array);
+
+    Object nested(ObjectArray{Object(Rect(1, 2, 3, 4))}, true);
+    nested = std::move(nested.getMutableArray().at(0));
+    ASSERT_EQ(Object(Rect(1, 2, 3, 4)), nested);
+    ASSERT_TRUE(nested.truthy());
+    ASSERT_FALSE(nested.empty());
+    ASSERT_EQ(Rect(1, 2, 3, 4), nested.getRect());
+    ASSERT_EQ(Rect(1, 2, 3, 4), nested.as<Rect>());
+}
+
+/**
+ * Before numbers, strings, and small primitives shared storage an Object held a type, a double,
+ * a std::string, and a shared_ptr.
+ */
+TEST(ObjectTest, Footprint)
+{
+    struct SeparateFieldsObject {
+        Object::ObjectType type;
+        double value;
+        std::string string;
+        std::shared_ptr<void> data;
+    };
+
+    ASSERT_LE(sizeof(Object), sizeof(std::string) + sizeof(double));
+    ASSERT_LT(sizeof(Object), sizeof(SeparateFieldsObject));
+}
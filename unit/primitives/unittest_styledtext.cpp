@@ -225,6 +225,24 @@ TEST_F(StyledTextTest, IncompleteEntities) {
     createAndVerifyStyledText(u8"&#128519", u8"&#128519", 0);
 }
 
+TEST_F(StyledTextTest, InvalidEntities)
+{
+    // Surrogates and values outside of the Unicode range are replaced
+    createAndVerifyStyledText(u8"a&#55296;b&#x110000;c&#99999999999;<i>d</i>", u8"a\uFFFDb\uFFFDc\uFFFDd", 1);
+    verifySpan(0, StyledText::kSpanTypeItalic, 6, 7);
+}
+
+TEST_F(StyledTextTest, InvalidUtf8)
+{
+    // Each invalid byte is replaced and counts as one character
+    createAndVerifyStyledText("bad\xFF\xC3 <i>text</i>", u8"bad\uFFFD\uFFFD text", 1);
+    verifySpan(0, StyledText::kSpanTypeItalic, 6, 10);
+
+    // Overlong encodings are not valid
+    createAndVerifyStyledText("\xC0\xAF<b>\xE2\x86\x92</b>", u8"\uFFFD\uFFFD\u2192", 1);
+    verifySpan(0, StyledText::kSpanTypeStrong, 2, 3);
+}
+
 TEST_F(StyledTextTest, LongSpecialEntity)
 {
     createAndVerifyStyledText(u8"go &#8594; <i>right</i>", u8"go \u2192 right", 1);
@@ -302,3 +320,24 @@ TEST_F(StyledTextTest, TagAttribute)
     createAndVerifyStyledText(u8"hello<br 3459dfiuwcr9ergh da lia e  =ar -e 89q3 403i4 ''\"<<>><<''' << k'asd \" >world", u8"helloworld", 1);
     createAndVerifyStyledText(u8"hello<br 3459dfiuwcr9ergh da lia e  =ar -e 89q3 403i4 ''\"<<<<''' <>< k'asd \" />world", u8"helloworld", 1);
 }
+
+TEST_F(StyledTextTest, LongArticle)
+{
+    // A long article with a mix of styles, entities, line breaks and multi-byte characters
+    const std::string paragraph = u8"<b>Markets</b> rallied on Tuesday &amp; bond yields <i>fell</i> by 3&#37; "
+                                  u8"after the announcement.<br>Analysts in \u6771\u4EAC called the move "
+                                  u8"<u>largely <em>expected</em></u>, while\n\tothers &lt;disagreed&gt; &#x2014; "
+                                  u8"<strike>sharply</strike> <tt>so</tt>. ";
+    std::string article;
+    for (int i = 0 ; i < 2000 ; i++)
+        article += paragraph;
+
+    const int PASSES = 10;
+    size_t spans = 0;
+    for (int pass = 0 ; pass < PASSES ; pass++) {
+        StyledText styled(article);
+        ASSERT_EQ(std::string::npos, styled.getText().find("<i>"));
+        spans += styled.getSpans().size();
+    }
+    ASSERT_EQ(PASSES * 2000 * 7, spans);
+}
@@ -0,0 +1,262 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <random>
+
+#include "../testeventloop.h"
+
+#include "apl/time/coretimemanager.h"
+#include "apl/time/wheeltimemanager.h"
+
+using namespace apl;
+
+using Fired = std::vector<std::pair<int, apl_time_t>>;
+
+TEST(WheelTimeManagerTest, Order)
+{
+    WheelTimeManager tm(0);
+    Fired fired;
+    auto record = [&](int n) { return [&, n]() { fired.emplace_back(n, tm.currentTime()); }; };
+
+    tm.setTimeout(record(1), 500);
+    tm.setTimeout(record(2), 10.5);
+    tm.setTimeout(record(3), 10.25);
+    tm.setTimeout(record(4), 70000);
+    tm.setTimeout(record(5), 500);    // Same end time as the first; fires after it
+    tm.setTimeout(record(6), 0);
+    ASSERT_EQ(6, tm.size());
+    ASSERT_EQ(0, tm.nextTimeout());
+
+    tm.runPending();
+    ASSERT_EQ((Fired{{6, 0}}), fired);
+    ASSERT_EQ(10.25, tm.nextTimeout());
+
+    tm.updateTime(10.3);
+    ASSERT_EQ((Fired{{6, 0}, {3, 10.25}}), fired);
+    ASSERT_EQ(10.3, tm.currentTime());
+    ASSERT_EQ(10.5, tm.nextTimeout());
+
+    tm.updateTime(1000);
+    ASSERT_EQ((Fired{{6, 0}, {3, 10.25}, {2, 10.5}, {1, 500}, {5, 500}}), fired);
+    ASSERT_EQ(70000, tm.nextTimeout());
+    ASSERT_EQ(1, tm.size());
+
+    tm.updateTime(100000);
+    ASSERT_EQ(6, fired.size());
+    ASSERT_EQ(std::make_pair(4, 70000.0), fired.back());
+    ASSERT_EQ(0, tm.size());
+    ASSERT_EQ(std::numeric_limits<apl_time_t>::max(), tm.nextTimeout());
+}
+
+TEST(WheelTimeManagerTest, Clear)
+{
+    WheelTimeManager tm(0);
+    std::vector<int> fired;
+
+    auto a = tm.setTimeout([&]() { fired.emplace_back(1); }, 100);
+    auto b = tm.setTimeout([&]() { fired.emplace_back(2); }, 100000);
+    auto c = tm.setTimeout([&]() { fired.emplace_back(3); }, 0);
+    tm.setTimeout([&]() { fired.emplace_back(4); }, 200);
+
+    ASSERT_TRUE(tm.clearTimeout(a));
+    ASSERT_TRUE(tm.clearTimeout(b));
+    ASSERT_TRUE(tm.clearTimeout(c));   // Waiting in the ready heap
+    ASSERT_FALSE(tm.clearTimeout(a));
+    ASSERT_FALSE(tm.clearTimeout(12345));
+    ASSERT_EQ(1, tm.size());
+    ASSERT_EQ(200, tm.nextTimeout());
+
+    tm.updateTime(1000000);
+    ASSERT_EQ(std::vector<int>({4}), fired);
+    ASSERT_EQ(0, tm.size());
+}
+
+TEST(WheelTimeManagerTest, Nested)
+{
+    WheelTimeManager tm(0);
+    Fired fired;
+
+    // Timeouts set while running a timeout fire in the same update if they are due
+    tm.setTimeout([&]() {
+        fired.emplace_back(1, tm.currentTime());
+        tm.setTimeout([&]() { fired.emplace_back(2, tm.currentTime()); }, 0);
+        tm.setTimeout([&]() { fired.emplace_back(3, tm.currentTime()); }, 30);
+        tm.setTimeout([&]() { fired.emplace_back(4, tm.currentTime()); }, 5000);
+    }, 100);
+    tm.setTimeout([&]() { fired.emplace_back(5, tm.currentTime()); }, 120);
+
+    tm.updateTime(200);
+    ASSERT_EQ((Fired{{1, 100}, {2, 100}, {5, 120}, {3, 130}}), fired);
+    ASSERT_EQ(1, tm.size());
+
+    // A timeout may clear another timeout that is due at the same time
+    timeout_id second = 0;
+    tm.setTimeout([&]() { tm.clearTimeout(second); }, 10);
+    second = tm.setTimeout([&]() { fired.emplace_back(6, tm.currentTime()); }, 10);
+    tm.updateTime(300);
+    ASSERT_EQ(4, fired.size());
+}
+
+TEST(WheelTimeManagerTest, Animators)
+{
+    WheelTimeManager tm(0);
+    std::vector<apl_duration_t> a, b;
+
+    tm.setAnimator([&](apl_duration_t t) { a.emplace_back(t); }, 100);
+    auto infinite = tm.setAnimator([&](apl_duration_t t) { b.emplace_back(t); }, Timers::INFINITE);
+    ASSERT_EQ(1, tm.nextTimeout());
+
+    tm.updateTime(40);
+    tm.updateTime(150);
+    ASSERT_EQ(std::vector<apl_duration_t>({40, 100}), a);
+    ASSERT_EQ(std::vector<apl_duration_t>({40, 150}), b);
+    ASSERT_EQ(151, tm.nextTimeout());
+
+    tm.updateTime(1e12);
+    ASSERT_EQ(3, b.size());
+    ASSERT_EQ(1, tm.size());
+    ASSERT_TRUE(tm.clearTimeout(infinite));
+    ASSERT_EQ(0, tm.size());
+    ASSERT_EQ(std::numeric_limits<apl_time_t>::max(), tm.nextTimeout());
+}
+
+TEST(WheelTimeManagerTest, LongRange)
+{
+    WheelTimeManager tm(0);
+    Fired fired;
+    auto record = [&](int n) { return [&, n]() { fired.emplace_back(n, tm.currentTime()); }; };
+
+    const double DAY = 24 * 3600 * 1000.0;
+    tm.setTimeout(record(1), 3000 * DAY);    // Beyond the wheel
+    tm.setTimeout(record(2), 100 * DAY);
+    tm.setTimeout(record(3), 3600 * 1000.0);
+    tm.setTimeout(record(4), 2000 * DAY);    // Beyond the wheel
+    ASSERT_EQ(3600 * 1000.0, tm.nextTimeout());
+
+    tm.updateTime(36500 * DAY);
+    ASSERT_EQ((Fired{{3, 3600 * 1000.0}, {2, 100 * DAY},
+                                                       {4, 2000 * DAY}, {1, 3000 * DAY}}), fired);
+
+    // Timeouts set after a long jump
+    fired.clear();
+    tm.setTimeout(record(5), 20);
+    tm.setTimeout(record(6), 10);
+    tm.updateTime(36500 * DAY + 15);
+    ASSERT_EQ((Fired{{6, 36500 * DAY + 10}}), fired);
+}
+
+TEST(WheelTimeManagerTest, Terminate)
+{
+    WheelTimeManager tm(0);
+    int count = 0;
+    tm.setTimeout([&]() { count++; }, 0);
+    tm.setTimeout([&]() { count++; }, 100);
+    tm.setAnimator([&](apl_duration_t) { count++; }, 100);
+
+    tm.terminate();
+    ASSERT_EQ(0, tm.size());
+    tm.updateTime(1000);
+    ASSERT_EQ(0, count);
+    ASSERT_EQ(std::numeric_limits<apl_time_t>::max(), tm.nextTimeout());
+}
+
+/**
+ * Run the same random workload against a TimeManager and record the order in which the
+ * timeouts fire.
+ */
+template<class T>
+static std::vector<std::pair<timeout_id, apl_time_t>>
+randomWorkload(unsigned int seed)
+{
+    T tm(0);
+    std::mt19937 random(seed);
+    std::vector<std::pair<timeout_id, apl_time_t>> fired;
+    std::vector<timeout_id> ids;
+
+    int unique = 0;
+    for (int step = 0 ; step < 2000 ; step++) {
+        auto action = random() % 10;
+        if (action < 5) {
+            // End times are kept distinct because the heap does not order ties
+            apl_duration_t delay = random() % (action == 0 ? 10000000 : 5000) + (++unique) * 1e-6;
+            ids.emplace_back(tm.setTimeout([&fired, &tm, &ids, &random]() {
+                fired.emplace_back(0, tm.currentTime());
+                if (random() % 4 == 0)
+                    ids.emplace_back(tm.setTimeout([]() {}, random() % 100));
+            }, delay));
+        }
+        else if (action < 8 && !ids.empty()) {
+            tm.clearTimeout(ids[random() % ids.size()]);
+        }
+        else {
+            tm.updateTime(tm.currentTime() + random() % 3000);
+        }
+    }
+
+    tm.updateTime(tm.currentTime() + 20000000);
+    return fired;
+}
+
+TEST(WheelTimeManagerTest, MatchesHeap)
+{
+    for (unsigned int seed = 1 ; seed <= 5 ; seed++) {
+        auto heap = randomWorkload<CoreTimeManager>(seed);
+        auto wheel = randomWorkload<WheelTimeManager>(seed);
+        ASSERT_LT(100, heap.size());
+        ASSERT_EQ(heap, wheel) << "seed " << seed;
+    }
+}
+
+static const char *DELAYED = R"apl({
+  "type": "APL",
+  "version": "1.4",
+  "mainTemplate": {
+    "items": {
+      "type": "Text",
+      "id": "label",
+      "text": "Start"
+    }
+  }
+})apl";
+
+static const char *DELAYED_COMMANDS = R"apl([
+  { "type": "SetValue", "componentId": "label", "property": "text", "value": "A", "delay": 500 },
+  { "type": "SetValue", "componentId": "label", "property": "text", "value": "B", "delay": 1000 }
+])apl";
+
+class WheelTimeManagerDocumentTest : public DocumentWrapper {};
+
+TEST_F(WheelTimeManagerDocumentTest, DelayedCommands)
+{
+    auto tm = std::make_shared<WheelTimeManager>(0);
+    config.timeManager(tm);
+    loadDocument(DELAYED);
+    ASSERT_TRUE(component);
+
+    rapidjson::Document commands;
+    commands.Parse(DELAYED_COMMANDS);
+    root->executeCommands(commands, false);
+    ASSERT_EQ(1, tm->size());
+
+    root->updateTime(499);
+    ASSERT_TRUE(IsEqual("Start", component->getCalculated(kPropertyText).asString()));
+    root->updateTime(500);
+    ASSERT_TRUE(IsEqual("A", component->getCalculated(kPropertyText).asString()));
+    root->updateTime(1499);
+    ASSERT_TRUE(IsEqual("A", component->getCalculated(kPropertyText).asString()));
+    root->updateTime(1500);
+    ASSERT_TRUE(IsEqual("B", component->getCalculated(kPropertyText).asString()));
+    ASSERT_EQ(0, tm->size());
+}
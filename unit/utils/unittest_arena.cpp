@@ -0,0 +1,160 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cstdint>
+
+#include "../testeventloop.h"
+
+#include "apl/utils/arena.h"
+
+using namespace apl;
+
+TEST(ArenaTest, Basic)
+{
+    Arena arena;
+    ASSERT_EQ(0, arena.liveBlocks());
+    ASSERT_EQ(0, arena.reservedBytes());
+
+    auto a = arena.allocate(24);
+    auto b = arena.allocate(24);
+    ASSERT_NE(a, b);
+    ASSERT_EQ(0, reinterpret_cast<uintptr_t>(a) % Arena::ALIGNMENT);
+    ASSERT_EQ(0, reinterpret_cast<uintptr_t>(b) % Arena::ALIGNMENT);
+    ASSERT_EQ(2, arena.liveBlocks());
+    ASSERT_EQ(Arena::CHUNK_SIZE, arena.reservedBytes());
+
+    // A released block is reused by the next request in the same size class
+    arena.deallocate(a, 24);
+    ASSERT_EQ(1, arena.liveBlocks());
+    ASSERT_EQ(a, arena.allocate(20));
+    ASSERT_NE(a, arena.allocate(100));
+
+    // Large blocks come from the heap
+    auto reserved = arena.reservedBytes();
+    auto large = arena.allocate(Arena::MAX_BLOCK_SIZE + 1);
+    ASSERT_EQ(3, arena.liveBlocks());
+    ASSERT_EQ(reserved, arena.reservedBytes());
+    arena.deallocate(large, Arena::MAX_BLOCK_SIZE + 1);
+    ASSERT_EQ(3, arena.liveBlocks());
+}
+
+TEST(ArenaTest, ManyChunks)
+{
+    Arena arena;
+    std::vector<void*> blocks;
+    for (int i = 0 ; i < 1000 ; i++)
+        blocks.emplace_back(arena.allocate(Arena::MAX_BLOCK_SIZE));
+
+    ASSERT_EQ(1000, arena.liveBlocks());
+    ASSERT_LE(1000 * Arena::MAX_BLOCK_SIZE, arena.reservedBytes());
+
+    auto reserved = arena.reservedBytes();
+    for (auto block : blocks)
+        arena.deallocate(block, Arena::MAX_BLOCK_SIZE);
+    ASSERT_EQ(0, arena.liveBlocks());
+
+    for (int i = 0 ; i < 1000 ; i++)
+        arena.allocate(Arena::MAX_BLOCK_SIZE);
+    ASSERT_EQ(reserved, arena.reservedBytes());
+}
+
+TEST(ArenaTest, SharedLifetime)
+{
+    struct Counted {
+        explicit Counted(int& counter) : counter(counter) { counter++; }
+        ~Counted() { counter--; }
+        int& counter;
+    };
+
+    int counter = 0;
+    auto arena = std::make_shared<Arena>();
+    std::weak_ptr<Arena> weak = arena;
+
+    auto a = allocateShared<Counted>(arena, counter);
+    auto b = allocateShared<Counted>(arena, counter);
+    ASSERT_EQ(2, counter);
+    ASSERT_EQ(2, arena->liveBlocks());
+
+    // The objects keep the arena alive
+    arena = nullptr;
+    ASSERT_FALSE(weak.expired());
+
+    a = nullptr;
+    ASSERT_EQ(1, counter);
+    ASSERT_EQ(1, weak.lock()->liveBlocks());
+
+    // A weak reference keeps the control block and hence the arena
+    std::weak_ptr<Counted> weakB = b;
+    b = nullptr;
+    ASSERT_EQ(0, counter);
+    ASSERT_FALSE(weak.expired());
+
+    weakB.reset();
+    ASSERT_TRUE(weak.expired());
+
+    // Without an arena this is make_shared
+    auto c = allocateShared<Counted>(nullptr, counter);
+    ASSERT_EQ(1, counter);
+}
+
+class ArenaDocumentTest : public DocumentWrapper {};
+
+static const char *LIST = R"apl({
+  "type": "APL",
+  "version": "1.4",
+  "mainTemplate": {
+    "parameters": [ "payload" ],
+    "items": {
+      "type": "Container",
+      "data": "${payload}",
+      "items": {
+        "type": "Frame",
+        "bind": { "name": "label", "value": "Item ${data}" },
+        "items": {
+          "type": "Text",
+          "text": "${label} of ${length}"
+        }
+      }
+    }
+  }
+})apl";
+
+TEST_F(ArenaDocumentTest, Disabled)
+{
+    loadDocument(LIST, "[1,2,3]");
+    ASSERT_FALSE(context->arena());
+}
+
+TEST_F(ArenaDocumentTest, Enabled)
+{
+    config.arenaAllocation(true);
+    loadDocument(LIST, "[1,2,3]");
+
+    std::weak_ptr<Arena> arena = context->arena();
+    ASSERT_FALSE(arena.expired());
+    ASSERT_LT(0, arena.lock()->liveBlocks());
+
+    ASSERT_EQ(3, component->getChildCount());
+    auto text = component->getChildAt(2)->getChildAt(0);
+    ASSERT_TRUE(IsEqual("Item 3 of 3", text->getCalculated(kPropertyText).asString()));
+    ASSERT_EQ(arena.lock(), text->getContext()->arena());
+
+    // Releasing the document releases the arena
+    text = nullptr;
+    component = nullptr;
+    context = nullptr;
+    root = nullptr;
+    ASSERT_TRUE(arena.expired());
+}
@@ -0,0 +1,176 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <map>
+#include <unordered_set>
+
+#include "../testeventloop.h"
+
+#include "apl/engine/properties.h"
+#include "apl/utils/atom.h"
+
+using namespace apl;
+
+TEST(AtomTest, Basic)
+{
+    Atom a = "fooBar";
+    Atom b = std::string("foo") + "Bar";
+    Atom c = "fooBaz";
+
+    ASSERT_EQ(a, b);
+    ASSERT_EQ(a.c_str(), b.c_str());   // Same interned storage
+    ASSERT_NE(a, c);
+    ASSERT_EQ(a.hash(), std::hash<std::string>()("fooBar"));
+    ASSERT_EQ(a.hash(), std::hash<Atom>()(b));
+
+    ASSERT_TRUE(a == "fooBar");
+    ASSERT_TRUE(std::string("fooBar") == a);
+    ASSERT_TRUE(a != "fooBaz");
+    ASSERT_EQ(6, a.size());
+
+    Atom empty;
+    ASSERT_TRUE(empty.empty());
+    ASSERT_EQ(empty, Atom(""));
+}
+
+TEST(AtomTest, Ordering)
+{
+    std::map<Atom, int> atoms = {{"zebra", 1}, {"apple", 2}, {"mango", 3}, {"apple", 4}};
+    ASSERT_EQ(3, atoms.size());
+
+    std::vector<std::string> keys;
+    for (const auto& m : atoms)
+        keys.emplace_back(m.first);
+
+    ASSERT_EQ(std::vector<std::string>({"apple", "mango", "zebra"}), keys);
+
+    ASSERT_FALSE(Atom("apple") < Atom("apple"));
+    ASSERT_TRUE(Atom("apple") < Atom("mango"));
+    ASSERT_FALSE(Atom("mango") < Atom("apple"));
+}
+
+TEST(AtomTest, Interning)
+{
+    auto before = Atom::tableSize();
+    Atom a = "AtomTest.Interning.unique";
+    ASSERT_EQ(before + 1, Atom::tableSize());
+
+    std::vector<Atom> copies(100, a);
+    Atom b = "AtomTest.Interning.unique";
+    ASSERT_EQ(before + 1, Atom::tableSize());
+    ASSERT_EQ(a, b);
+}
+
+TEST(AtomTest, FindDoesNotIntern)
+{
+    auto before = Atom::tableSize();
+    ASSERT_TRUE(Atom::find("AtomTest.FindDoesNotIntern.unique").empty());
+    ASSERT_EQ(before, Atom::tableSize());
+
+    Atom a = "AtomTest.FindDoesNotIntern.unique";
+    ASSERT_EQ(a, Atom::find("AtomTest.FindDoesNotIntern.unique"));
+    ASSERT_EQ(before + 1, Atom::tableSize());
+
+    // Looking up a property by a name that was never interned misses without interning it
+    auto map = std::make_shared<ObjectMap>(ObjectMap{{"AtomTest.FindDoesNotIntern.unique", 1}});
+    Properties properties(map);
+    ASSERT_NE(properties.end(), properties.find("AtomTest.FindDoesNotIntern.unique"));
+    ASSERT_EQ(properties.end(), properties.find("AtomTest.FindDoesNotIntern.missing"));
+    ASSERT_EQ(before + 1, Atom::tableSize());
+}
+
+TEST(AtomTest, TableGrowth)
+{
+    // Interning enough names to grow the lookup array keeps every earlier atom
+    std::vector<Atom> atoms;
+    for (int i = 0 ; i < 1000 ; i++)
+        atoms.emplace_back("AtomTest.TableGrowth." + std::to_string(i));
+
+    for (int i = 0 ; i < 1000 ; i++) {
+        auto name = "AtomTest.TableGrowth." + std::to_string(i);
+        ASSERT_EQ(atoms[i], Atom::find(name));
+        ASSERT_EQ(atoms[i].c_str(), Atom(name).c_str());
+    }
+}
+
+class AtomDocumentTest : public DocumentWrapper {};
+
+static const char *MANY_ITEMS = R"apl({
+  "type": "APL",
+  "version": "1.4",
+  "mainTemplate": {
+    "parameters": [ "payload" ],
+    "items": {
+      "type": "Container",
+      "data": "${payload}",
+      "items": {
+        "type": "Container",
+        "bind": [
+          { "name": "primaryTextContent", "value": "${data}" },
+          { "name": "secondaryTextContent", "value": "${index}" }
+        ],
+        "items": {
+          "type": "Text",
+          "text": "${primaryTextContent} ${secondaryTextContent}"
+        }
+      }
+    }
+  }
+})apl";
+
+static void
+countKeys(const Component& component, size_t& count, size_t& stringBytes, std::unordered_set<std::string>& names)
+{
+    for (const auto& m : *component.getContext()) {
+        const auto& name = m.first.str();
+        count++;
+        // A std::string key stores short names inline and allocates longer ones
+        stringBytes += sizeof(std::string) + (name.size() >= sizeof(std::string) / 2 ? name.capacity() + 1 : 0);
+        names.emplace(name);
+    }
+
+    for (size_t i = 0 ; i < component.getChildCount() ; i++)
+        countKeys(*component.getChildAt(i), count, stringBytes, names);
+}
+
+/**
+ * Interned context symbol names use less memory than strings.  Every context of an inflated
+ * list repeats the same handful of names.
+ */
+TEST_F(AtomDocumentTest, ContextKeyFootprint)
+{
+    std::string data = "[";
+    for (int i = 0 ; i < 500 ; i++)
+        data += (i ? "," : "") + std::to_string(i);
+    data += "]";
+
+    loadDocument(MANY_ITEMS, data.c_str());
+    ASSERT_EQ(500, component->getChildCount());
+
+    size_t count = 0;
+    size_t stringBytes = 0;
+    std::unordered_set<std::string> names;
+    countKeys(*component, count, stringBytes, names);
+
+    size_t atomBytes = count * sizeof(Atom);
+    for (const auto& m : names)
+        atomBytes += sizeof(Atom::Entry) + m.capacity() + 1;
+
+    ASSERT_LT(atomBytes, stringBytes);
+
+    // Symbols are still found by name
+    auto text = component->getChildAt(3)->getChildAt(0);
+    ASSERT_TRUE(IsEqual("3 3", text->getCalculated(kPropertyText).asString()));
+}
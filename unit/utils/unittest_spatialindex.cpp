@@ -0,0 +1,77 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include "apl/utils/spatialindex.h"
+
+using namespace apl;
+
+static std::vector<uint32_t>
+hits(const SpatialIndex& index, const Point& point)
+{
+    std::vector<uint32_t> result;
+    for (auto i : index.candidates(point))
+        if (index.contains(i, point))
+            result.emplace_back(i);
+    return result;
+}
+
+TEST(SpatialIndexTest, Empty)
+{
+    SpatialIndex index;
+    ASSERT_TRUE(hits(index, Point(0, 0)).empty());
+
+    index.build({Rect(), Rect(10, 10, 0, 0)});
+    ASSERT_EQ(2, index.size());
+    ASSERT_TRUE(hits(index, Point(10, 12)).empty());
+}
+
+TEST(SpatialIndexTest, Overlap)
+{
+    SpatialIndex index;
+    index.build({Rect(0, 0, 100, 100), Rect(50, 50, 100, 100), Rect(), Rect(60, 60, 10, 10)});
+
+    ASSERT_EQ(std::vector<uint32_t>({0}), hits(index, Point(10, 10)));
+    ASSERT_EQ(std::vector<uint32_t>({3, 1, 0}), hits(index, Point(65, 65)));
+    ASSERT_EQ(std::vector<uint32_t>({1, 0}), hits(index, Point(100, 100)));
+    ASSERT_EQ(std::vector<uint32_t>({1}), hits(index, Point(150, 150)));   // Far edge
+    ASSERT_TRUE(hits(index, Point(151, 150)).empty());
+    ASSERT_TRUE(hits(index, Point(-1, 10)).empty());
+
+    index.clear();
+    ASSERT_TRUE(hits(index, Point(10, 10)).empty());
+}
+
+TEST(SpatialIndexTest, Grid)
+{
+    std::vector<Rect> rects;
+    for (int i = 0 ; i < 1000 ; i++)
+        rects.emplace_back((i % 10) * 40, (i / 10) * 40, 40, 40);
+
+    SpatialIndex index;
+    index.build(std::move(rects));
+
+    for (int i = 0 ; i < 1000 ; i++) {
+        auto result = hits(index, Point((i % 10) * 40 + 20, (i / 10) * 40 + 20));
+        ASSERT_EQ(std::vector<uint32_t>({static_cast<uint32_t>(i)}), result);
+    }
+
+    // The shared corner of four cells
+    ASSERT_EQ(std::vector<uint32_t>({11, 10, 1, 0}), hits(index, Point(40, 40)));
+
+    // Each query only looks at a few rectangles
+    ASSERT_GE(8, index.candidates(Point(200, 2000)).size());
+}